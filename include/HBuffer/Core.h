@@ -1,21 +1,43 @@
-#pragma once
-
-//Handles defines and importing standard library
-#include <iostream>
-#include <string>
-#include <string.h>
-#include <map>
-#include <memory>
-#include <algorithm>
-#include <vector>
-//#if __cplusplus < 201103L
-//#error HBUFFER ONLY SUPPORTS CPP11+ remind the dev to actually work on his code 
-//#endif
-
-#ifndef HBUFF_NO_CONSTEXPR
-#define HBUFF_CONSTEXPR constexpr
-#endif
-
-#ifndef HBUFF_NO_NOEXCEPT
-#define HBUFF_NOEXCEPT noexcept
-#endif
\ No newline at end of file
+#pragma once
+
+//Handles defines and importing standard library
+#include <iostream>
+#include <string>
+#include <string.h>
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+//#if __cplusplus < 201103L
+//#error HBUFFER ONLY SUPPORTS CPP11+ remind the dev to actually work on his code 
+//#endif
+
+#ifndef HBUFF_NO_CONSTEXPR
+#define HBUFF_CONSTEXPR constexpr
+#endif
+
+#ifndef HBUFF_NO_NOEXCEPT
+#define HBUFF_NOEXCEPT noexcept
+#endif
+
+#ifndef HBUFF_CACHE_LINE_SIZE
+/// Counters written by different threads are kept this far apart so they do not share a cache line
+#define HBUFF_CACHE_LINE_SIZE 64
+#endif
+
+/// Returned by searches that did not find anything
+#define HBUFF_NPOS static_cast<size_t>(-1)
+
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+/// Defined when the machine we are compiling for is little endian
+#define HBUFF_HOST_LITTLE_ENDIAN 1
+#endif
+
+/// @brief returns the smallest power of two that is atleast param value
+inline size_t HBufferRoundUpPowerOfTwo(size_t value) HBUFF_NOEXCEPT{
+    size_t power = 1;
+    while(power < value)power <<= 1;
+    return power;
+}
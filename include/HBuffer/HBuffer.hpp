@@ -1,1504 +1,1765 @@
-#pragma once
-
-#include "Core.h"
-
-/// HBUFF_ENDIAN_MODE == 0. Little Endian
-/// HBUFF_ENDIAN_MODE == 1. Big Endian
-
-#ifndef HBUFF_ENDIAN_MODE
-/// Defaulting to Little Endian
-#define HBUFF_ENDIAN_MODE 0
-#endif
-
-/// TODO: For reallocation chekds just check if we cn modify 
-class HBuffer{
-public:
-    friend class HBufferJoin;
-    /// @brief Initializes HBuffer to point to nothing and own nothing
-    HBuffer()HBUFF_NOEXCEPT:m_Data(nullptr), m_Size(0), m_Capacity(0), m_CanFree(false), m_CanModify(false){}
-    /// @brief Points data to str and allows you to decide if that data should be modified or not
-    /// @param str the string literal to point to
-    /// @param canFree gives ownership to buffer
-    /// @param canModify decides if buffer is allowed to modify data
-    HBuffer(const char* str, bool canFree, bool canModify)HBUFF_NOEXCEPT
-        : m_Size(strlen(str)), m_Capacity(m_Size + 1), m_Data(const_cast<char*>(str)), m_CanFree(canFree), m_CanModify(canModify){}
-    
-    
-    /// @brief Makes data point to str and gives it a size/capacity to use depending on canModify. Will complete buffer if canFree is true
-    /// @param str 
-    /// @param len the amount of characters or size in the param str
-    /// @param canFree 
-    /// @param canModify decides if the buffer can directly modify data or if it has to make a copy if it needs to edit data
-    HBuffer(const char* str, size_t len, bool canFree, bool canModify)HBUFF_NOEXCEPT:m_Size(len), m_Data(const_cast<char*>(str)), m_Capacity(m_Size + 1), m_CanFree(canFree), m_CanModify(canModify){}
-    
-    /// @brief Makes data point to str and gives it a size/capacity to use depending on canModify. Will complete buffer if canFree is true
-    /// @param str 
-    /// @param len the amount of characters or size in the param str
-    /// @param capacity the amount of characters or size in the param str
-    /// @param canFree 
-    /// @param canModify decides if the buffer can directly modify data or if it has to make a copy if it needs to edit data
-    explicit HBuffer(char* str, size_t len, size_t capacity, bool canFree, bool canModify)HBUFF_NOEXCEPT:m_Size(len), m_Data(const_cast<char*>(str)), m_Capacity(capacity), m_CanFree(canFree), m_CanModify(canModify){}
-    
-    /// @brief Makes the buffer an exact non owning copy of param buffer
-    /// @param buffer 
-    HBuffer(const HBuffer& buffer)HBUFF_NOEXCEPT :m_Data(buffer.m_Data), m_Size(buffer.m_Size), m_Capacity(buffer.m_Capacity), m_CanFree(false), m_CanModify(buffer.m_CanModify){
-        //We assume @param buffer owns the data and will manage it properly
-    }
-    /// @brief Moves param buffer into self and releases param buffers data
-    /// @param buffer the buffer to get data from and release
-    HBuffer(HBuffer&& buffer) HBUFF_NOEXCEPT{
-        m_Data = buffer.m_Data;
-        m_Size = buffer.m_Size;
-        m_Capacity = buffer.m_Capacity;
-        m_CanFree = buffer.m_CanFree;
-        m_CanModify = buffer.m_CanModify;
-        buffer.Release();
-    }
-
-    /// @brief sets buffer as non owning view of string literal
-    HBuffer(const char* str) HBUFF_NOEXCEPT{
-        m_Data = const_cast<char*>(str);
-        m_Size = strlen(str);
-        m_Capacity = m_Size + 1;
-        m_CanFree = false;
-        m_CanModify = false;
-    }
-    /// @brief Makes a copy of the string
-    /// @param string 
-    explicit HBuffer(const std::string& str) HBUFF_NOEXCEPT{
-        m_Capacity = strlen(str.c_str());
-        m_Size = m_Capacity;
-        m_Data = new char[m_Capacity + 1];
-        m_Data[m_Capacity] = '\0';
-        m_CanFree = true;
-        m_CanModify = true;
-
-        memcpy(m_Data, str.c_str(), m_Size);
-    }
-
-    /// @brief will Free data if owns
-    ~HBuffer(){
-    #ifdef HBUFFER_PRINT_DECONSTRUCTION_STATUS
-        std::cout << "HBuffer Deconstructor Before Free" <<std::endl;
-        if(m_CanFree)delete m_Data;
-        std::cout<< "HBuffer Deconstructor After Free" << std::endl;
-    #else
-        if(m_CanFree)delete m_Data;
-    #endif
-    }
-
-    /// @brief Frees data if can. Only modifies m_CanFree and m_Data
-    inline void Delete() HBUFF_NOEXCEPT{
-        if(m_CanFree)delete m_Data;
-        m_Data = nullptr;
-        m_CanFree = false;
-    }
-    /// @brief Frees data if buffer is owning and releases after regardless
-    inline void Free() HBUFF_NOEXCEPT{  
-        if(m_CanFree){
-            //TODO: implement tracking of allocations
-            //#ifdef HBUFFER_TRACK_ALLOCATIONS
-            //CORE_DEBUG("Freeing HBuffer with size {0}", m_Size);
-            //#endif
-            delete m_Data;
-        }
-        //Release data regardless
-        m_Data = nullptr;
-        m_Size = 0;
-        m_Capacity = 0;
-        m_CanFree = false;
-        m_CanModify = false;
-    }
-    /// @brief releases data without freeing. Will lead to memory leaks unless used properly
-    inline void Release() HBUFF_NOEXCEPT{
-        m_Data = nullptr;
-        m_Size = 0;
-        m_Capacity = 0;
-        m_CanFree = false;
-        m_CanModify = false;
-    }
-    /// @brief only changes m_Data pointer without freeing/resizing.
-    void SetData(char* data) HBUFF_NOEXCEPT{
-        m_Data = data;
-    }
-    /// @brief changes if we own the data or not
-    void SetCanFree(bool value) HBUFF_NOEXCEPT{
-        m_CanFree = value;
-    }
-
-    /// @brief changes if we are allowed to modify the data or not. without nullptr checks
-    void SetCanModify(bool canModify) HBUFF_NOEXCEPT{
-        m_CanModify = canModify;
-    }
-
-    /// @brief Sets the size of the buffer and reallocates and changes data if param size > m_Capacity
-    /// @param size the new buffer size in bytes
-    void SetSize(size_t size) HBUFF_NOEXCEPT{
-        if(size > m_Capacity){
-            char* newData = new char[size];
-            memcpy(newData, m_Data, m_Capacity);
-            if(m_CanFree)delete m_Data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = size;
-            m_Data = newData;
-        }
-        m_Size = size;
-    }
-
-
-    /// @brief assigns the size of the buffer to the param size without doing anything else. Doesnt check if its bigger than capacity or if we have valid data or anything.
-    /// @brief ;aram the new size in bytes
-    void AssignSize(size_t size) HBUFF_NOEXCEPT{
-        m_Size = size;
-    }
-
-    /// @brief strictly assigns the buffers capacity to the param capacity with no questions asked.
-    /// @param capacity the new capacity of the buffer in bytes
-    void AssignCapacity(size_t capacity) HBUFF_NOEXCEPT{
-        m_Capacity = capacity;
-    }
-
-    void Resize(size_t newSize) HBUFF_NOEXCEPT{
-        if(newSize >= m_Capacity){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            delete m_Data;
-            m_Data = data;
-            m_Size = newSize;
-            m_Capacity = newSize;
-            m_CanFree = true;
-            m_CanModify= true;
-            return;
-        }
-        m_Size = newSize;
-    }
-    /// @brief Reserves the buffer to be atleast param newSize bytes. If newSize <= capacity then no reallocation is done. Else we free/release data and reallocate
-    /// @param newCapacity the new capacity of the buffer. Only reallocates if newCapacity > m_Capacity 
-    void Reserve(size_t newCapacity) HBUFF_NOEXCEPT{
-        if(newCapacity <= m_Capacity)return;
-
-        char* data = new char[newCapacity];
-        memcpy(data, m_Data, m_Size);
-        if(m_CanFree)delete m_Data;
-        m_Data = data;
-        m_Capacity = newCapacity;
-        m_CanFree = true;
-        m_CanModify = true;
-    }
-
-    /// @brief Reserves the buffer to be atleast param newSize bytes ontop of m_Size. If newSize <= capacity then no reallocation is done. Else we free/release data and reallocate
-    /// @param newCapacity the new capacity of the buffer. Only reallocates if newCapacity +m_Size > m_Capacity 
-    void ReserveExtra(size_t newCapacity) HBUFF_NOEXCEPT{
-        newCapacity+= m_Size;
-        if(newCapacity <= m_Capacity)return;
-
-        char* data = new char[newCapacity];
-        memcpy(data, m_Data, m_Size);
-        if(m_CanFree)delete m_Data;
-        m_Data = data;
-        m_Capacity = newCapacity;
-        m_CanFree = true;
-        m_CanModify = true;
-    }
-
-    /// @brief Reserves newCapacity of bytes for a string. excluding the additional byte for the null terminator
-    void ReserveString(size_t newCapacity) HBUFF_NOEXCEPT{
-        newCapacity++;
-        if(newCapacity <= m_Capacity)return;
-        m_Capacity = newCapacity;
-        char* data = new char[m_Capacity];
-        memcpy(data, m_Data, m_Size);
-        memset(data + m_Capacity - 1, '\0', 1);
-        if(m_CanFree)delete m_Data;
-        m_Data = data;
-        m_CanModify = true;
-        m_CanFree = true;
-    }
-    
-    /// @return returns the character at i without safety checks
-    char At(size_t i) const HBUFF_NOEXCEPT{
-        return m_Data[i];
-    }
-    /// @return returns the character at i. returns '\0' if out of range
-    char Get(size_t i) const HBUFF_NOEXCEPT{
-        if(i < m_Size)return m_Data[i];
-        return '\0';
-    }
-
-    /// @brief returns the character at param at.
-    /// @param status true if success, false if failed to retrieve
-    /// @param at the position in the buffer to retrieve the byte from
-    char Retrieve(bool& status, size_t at) const noexcept{
-        if(at > m_Size){
-            status = false;
-            return 0;
-        }
-
-        status = true;
-        return m_Data[at];
-    }
-
-    /// @brief Creates a copy of the current buffer
-    HBuffer CreateCopy() const HBUFF_NOEXCEPT{
-        char* data = new char[m_Size];
-        memcpy(data, m_Data, m_Size);
-        return HBuffer(data, m_Size, m_Size, true, true);
-    }
-    /// @brief Allocate a copy of data
-    static HBuffer CreateCopy(const std::string& string) HBUFF_NOEXCEPT{
-        size_t size = string.size();
-        size_t newCapacity = size + 1;
-        char* data = new char[newCapacity];
-        memcpy(data, string.data(), size);
-        memset(data + size, '\0', 1);
-        return HBuffer(data, size, newCapacity, true, true);
-    }
-#pragma region Numbers
-    /// @brief returns a new HBuffer with an ascii encoded base 10 string
-    static HBuffer ToString(size_t number) HBUFF_NOEXCEPT{
-        HBuffer buffer;
-        buffer.ReserveString(5);
-        buffer[0] = '\00';
-        while(number > 0){
-            buffer.AppendString((number % 10) + '0');
-            number /= 10;
-        }
-        buffer.Reverse();
-
-        return buffer;
-    }
-
-    static HBuffer ToString(float number) HBUFF_NOEXCEPT{
-        HBuffer buffer;
-        buffer.ReserveString(10);
-
-        int charsWritten = snprintf(buffer.m_Data, 10, "%.3f", number);
-        buffer.m_Size = charsWritten;
-        return buffer;
-    }
-
-    /// @brief Assumes data in param buffer is a ascii encoded numerical base 10 string.
-    /// @param output a pointer to a size_t to store the result
-    static void StrictToNumber(const HBuffer& buffer, size_t* output) HBUFF_NOEXCEPT{
-        size_t number = 0;
-
-        for(size_t i = 0; i < buffer.GetSize(); i++){
-            number *= 10;
-            number += buffer.m_Data[i] - '0';
-        }
-
-        *output = number;
-    }
-
-    /// @brief Attempts to convert the string to a float
-    /// @return true if success, false if otherwise
-    bool ToFloat(float& output)HBUFF_NOEXCEPT{
-        output = 0;
-
-        float multiplier = 1;
-        bool decimalPlaced = false;
-        for(size_t i = 0; i < m_Size; i++){
-            char c = m_Data[i];
-            if(c >= '0' && c<= '9'){
-                c-='0';
-                if(!decimalPlaced){
-                    output *=10;
-                    output+=c;
-                    continue;
-                }
-
-                multiplier *= 0.1;
-                output += c * multiplier;
-                continue;
-            }
-            if(c == '.'){
-                decimalPlaced=true; 
-                continue;
-            }
-            return false;
-        }
-        return true;
-    }
-#pragma endregion
-public:
-    /// @brief Makes buffer point to a null terminated string literal
-    /// @param str the string to point to
-    /// @param canFree do we own this data
-    /// @param canModify can we modify this data
-    void Assign(const char* str, bool canFree, bool canModify) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = const_cast<char*>(str);
-        m_Size = strlen(m_Data);
-        m_Capacity = m_Size;
-        m_CanFree = canFree;
-        m_CanModify = canModify;
-    }
-
-    /// @brief Sets data to point at a null terminated string literal.
-    /// @param str the string that the buffer points to
-    /// @param len the new length and capacity in bytes
-    /// @param canFree is this buffer owning this data
-    /// @param canModify can we modify this data
-    void Assign(const char* str, size_t len, bool canFree, bool canModify) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = const_cast<char*>(str);
-        m_Size = len;
-        m_Capacity = len;
-        m_CanFree = canFree;
-        m_CanModify = canModify;
-    }
-
-    /// @brief Frees current data and assigns new data
-    /// @param data the new data to point to
-    /// @param len the buffers new length in bytes
-    /// @param capacity the buffers new capacity in bytes
-    /// @param canFree the buffers ability to free the data
-    /// @param canModify the buffers ability to modify its new data
-    void Assign(char* data, size_t len, size_t capacity, bool canFree, bool canModify) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = data;
-        m_Size = len;
-        m_Capacity = capacity;
-        m_CanFree = canFree;
-        m_CanModify = canModify;
-    }
-
-
-    /// @brief frees and assigns self as a non owning view of param buffer. May modify if param buffer allows modifying
-    void Assign(const HBuffer& buffer) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = buffer.m_Data;
-        m_Size = buffer.m_Size;
-        m_Capacity = buffer.m_Capacity;
-        m_CanModify = buffer.m_CanModify;
-        m_CanFree = false;
-    }
-
-    /// @brief Frees data and assigns data to param buffer. Then param buffer is released. Essentially making this buffer the owner
-    void Assign(HBuffer&& buffer) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = buffer.m_Data;
-        m_Size = buffer.m_Size;
-        m_Capacity = buffer.m_Capacity;
-        m_CanModify = buffer.m_CanModify;
-        m_CanFree = buffer.m_CanFree;
-        buffer.Release();
-    }
-
-    /// @brief Sets buffer to a non owning view that has the same properties of the param buffer
-    /// @param buffer 
-    /// @param canFree are we allowing the buffer to now own the data of param buffer? 
-    /// @param canModify are we going to allow the buffer to modify the contents of the new data from param buffer?
-    void Assign(HBuffer& buffer, bool canFree, bool canModify) HBUFF_NOEXCEPT{
-        Free();
-        /*
-        m_Data = buffer.m_Data;
-        m_Size = buffer.m_Size;
-        m_Capacity = buffer.m_Capacity;
-        m_CanModify = buffer.m_CanModify;
-        m_CanFree = false;
-        */
-        m_Data = buffer.m_Data;
-        m_Size = buffer.m_Size;
-        m_Capacity = buffer.m_Capacity;
-        m_CanFree = canFree;
-        m_CanModify = canModify;
-    }
-
-    /// @brief We will append the "foods" data to our buffer and the foods data will get released
-    void Consume(const HBuffer& food) HBUFF_NOEXCEPT{
-        Append(food);
-    }
-    /// @brief appends other buffers data ontop of current buffer and jumps to from. for example Consume(2, "Hello") if buffer is currently empty then new buffer will be "ello", else it will be buff1 + buff2 with the buffer starting at byte 2
-    /// @param from how much bytes to consume. then filled with remaining of current buffer then appends the food
-    void Consume(size_t from, HBuffer& food) HBUFF_NOEXCEPT{
-        ///TODO: might sometime work
-        //Part1 size - 30
-        //Part2 size - 50
-        //Total size - 80
-        //Part1 Change - 0
-        //From - 29
-        //Desired new size - 80
-        size_t otherSize = food.m_Size;
-        size_t totalSize = m_Size + otherSize;
-        from = std::min(totalSize, from);
-        
-        size_t newLen1 = m_Size - std::min(from, m_Size);
-        size_t newLen2 = otherSize - (from >= m_Size ? std::min(otherSize, from - m_Size) : 0);
-        size_t newSize = newLen1 + newLen2;
-
-        if(newSize > m_Capacity || !m_CanModify || !m_Data){
-            m_Capacity = newSize;
-            char* data = new char[m_Capacity];
-            memcpy(data, m_Data + from, newLen1);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-        }else{
-            memcpy(m_Data, m_Data + from, newLen1);
-        }
-        memcpy(m_Data + newLen1, food.m_Data + from - std::min(m_Size, from), newLen2);
-        m_Size = newSize;
-    }
-
-    void InsertAt(size_t at, const HBuffer& buffer) noexcept{
-        size_t otherSize = buffer.GetSize();
-        size_t minimumSize = at + otherSize;
-        if(minimumSize > m_Capacity || !m_CanModify || !m_Data){
-            char* newData = new char[minimumSize];
-            memcpy(newData, m_Data, m_Size);
-            Delete();
-            m_Data = newData;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = minimumSize;
-        }
-
-        memcpy(m_Data + at, buffer.GetData(), otherSize);
-    }
-    /// @brief Inserts a null terminated string
-    /// @param at the place inside the buffer to insert the string into
-    /// @param str the string to copy characters from
-    /// @param characters the amount of actual characters excluding the null terminator
-    void InsertAt(size_t at, const char* str, size_t characters) noexcept{
-        size_t minimumSize = at + characters + 1;
-        if(minimumSize > m_Capacity || !m_CanModify || !m_Data){
-            char* newData = new char[minimumSize];
-            memcpy(newData, m_Data, m_Size);
-            Delete();
-            m_Data = newData;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = minimumSize;
-        }
-
-        memcpy(m_Data + at, str, characters);
-        memset(m_Data + at + characters, 0, 1);
-    }
-    /// @brief Inserts c into the buffer at param at.
-    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
-    /// @param c the byte to insert at c
-    void InsertInt8At(size_t at, int8_t c)HBUFF_NOEXCEPT{
-        size_t minimumSize = at + 1;
-        if(minimumSize >= m_Capacity || !m_CanModify || !m_Data){
-            char* newData = new char[minimumSize];
-            memcpy(newData, m_Data, m_Size);
-            Delete();
-            m_Capacity = minimumSize;
-            m_Data = newData;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        0[m_Data + at] = c;
-    }
-
-    /// @brief Inserts c into the buffer at param at.
-    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
-    /// @param c the byte to insert at c
-    void InsertInt16At(size_t at, int16_t c)HBUFF_NOEXCEPT{
-        if(at + 2 >= m_Capacity || !m_CanModify || !m_Data){
-            char* newData = new char[at + 2];
-            memcpy(newData, m_Data, m_Size);
-            Delete();
-            m_Data = newData;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        char* insertAt = m_Data + at;
-        #if HBUFF_ENDIAN_MODE == 0
-        insertAt[0] = c & 0xFF;
-        insertAt[1] = (c >> 8) & 0xFF;
-        #else
-        insertAt[0] = (c >> 8) & 0xFF;
-        insertAt[1] = c & 0xFF;
-        #endif
-    }
-
-    /// @brief Inserts c into the buffer at param at.
-    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
-    /// @param c the byte to insert at c
-    void InsertInt32At(size_t at, int32_t c)HBUFF_NOEXCEPT{
-        if(at + 4 >= m_Capacity || !m_CanModify || !m_Data){
-            char* newData = new char[at + 4];
-            memcpy(newData, m_Data, m_Size);
-            Delete();
-            m_Data = newData;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        char* insertAt = m_Data + at;
-        #if HBUFF_ENDIAN_MODE == 0
-        insertAt[0] = c & 0xFF;
-        insertAt[1] = (c >> 8) & 0xFF;
-        insertAt[2] = (c >> 16) & 0xFF;
-        insertAt[2] = (c >> 24) & 0xFF;
-        #else
-        insertAt[0] = (c >> 24) & 0xFF;
-        insertAt[1] = (c >> 16) & 0xFF;
-        insertAt[2] = (c >> 8) & 0xFF;
-        insertAt[3] = c & 0xFF;
-        #endif
-    }
-
-    void AppendUInt16(uint16_t value) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + 2;
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = newSize;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-    #if HBUFF_ENDIAN_MODE == 0
-        m_Data[m_Size] = value & 0xFF;
-        m_Data[m_Size + 1] = (value >> 8) & 0xFF;
-    #else
-        m_Data[m_Size] = (value >> 8) & 0xFF;
-        m_Data[m_Size + 1] = value & 0xFF;
-    #endif
-        m_Size = newSize;
-    }
-    void AppendUInt32(uint32_t value) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + 4;
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = newSize;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-    #if HBUFF_ENDIAN_MODE == 0
-        m_Data[m_Size] = value & 0xFF;
-        m_Data[m_Size + 1] = (value >> 8) & 0xFF;
-        m_Data[m_Size + 2] = (value >> 16) & 0xFF;
-        m_Data[m_Size + 3] = (value >> 24) & 0xFF;
-    #else
-        m_Data[m_Size] = (value >> 24) & 0xFF;
-        m_Data[m_Size + 1] = (value >> 16) & 0xFF;
-        m_Data[m_Size + 2] = (value >> 8) & 0xFF;
-        m_Data[m_Size + 3] = value & 0xFF;
-    #endif
-        m_Size = newSize;
-    }
-
-    /// TODO: create a function that can also just extract by treating at as a pointer into the array and assign *dst = *reinterpret_cast<uintn_t*>(m_Data[at])
-    bool ExtractInt8(size_t at, int8_t* dst)const HBUFF_NOEXCEPT{
-        if(at < m_Size){
-            *dst = static_cast<int8_t>(m_Data[at]);
-            return true;
-        }
-        return false;
-    }
-    
-    bool ExtractUInt8(size_t at, uint8_t* dst)const HBUFF_NOEXCEPT{
-        if(at < m_Size){
-            *dst = static_cast<uint8_t>(m_Data[at]);
-            return true;
-        }
-        return false;
-    }
-    bool ExtractInt16(size_t at, int16_t* dst)const HBUFF_NOEXCEPT{
-        if(at + 1 < m_Size){
-        #if HBUFF_ENDIAN_MODE == 0
-            *dst = static_cast<int16_t>(m_Data[at + 1] >> 8 | m_Data[at]);
-        #else
-            *dst = static_cast<int16_t>(m_Data[at] >> 8 | m_Data[at + 1]);
-        #endif
-            return true;
-        }
-        return false;
-    }
-    
-    bool ExtractUInt16(size_t at, uint16_t* dst)const HBUFF_NOEXCEPT{
-        if(at + 1 < m_Size){
-        #if HBUFF_ENDIAN_MODE == 0
-            *dst = static_cast<uint16_t>(m_Data[at + 1] >> 8 | m_Data[at]);
-        #else
-            *dst = static_cast<uint16_t>(m_Data[at] >> 8 | m_Data[at + 1]);
-        #endif
-            return true;
-        }
-        return false;
-    }
-    bool ExtractInt32(size_t at, int32_t* dst)const HBUFF_NOEXCEPT{
-        if(at + 3 < m_Size){
-        #if HBUFF_ENDIAN_MODE == 0
-            *dst = static_cast<int32_t>(m_Data[at + 3] >> 24 | m_Data[at + 2] >> 16 | m_Data[at + 1] >> 8 | m_Data[at]);
-        #else
-            *dst = static_cast<int32_t>(m_Data[at] >> 24 | m_Data[at + 1] >> 16 | m_Data[at + 2] >> 8 | m_Data[at + 3]);
-        #endif
-            return true;
-        }
-        return false;
-    }
-    
-    bool ExtractUInt32(size_t at, uint32_t* dst)const HBUFF_NOEXCEPT{
-        if(at + 3 < m_Size){
-        #if HBUFF_ENDIAN_MODE == 0
-            *dst = static_cast<uint32_t>(m_Data[at + 3] >> 24| m_Data[at + 2] >> 16 | m_Data[at + 1] >> 8 | m_Data[at]);
-        #else
-            *dst = static_cast<uint32_t>(m_Data[at] >> 24 | m_Data[at + 1] >> 16 | m_Data[at + 2] >> 8 | m_Data[at + 3]);
-        #endif
-            return true;
-        }
-        return false;
-    }
-    void Append(const HBuffer& buffer) HBUFF_NOEXCEPT{
-        size_t otherSize = buffer.m_Size;
-        size_t newSize = m_Size + otherSize;
-        
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = newSize;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        memcpy(m_Data + m_Size, buffer.GetData(), otherSize);
-        m_Size = newSize;
-    }
-
-    void Append(const char* str) HBUFF_NOEXCEPT{
-        size_t strLen = strlen(str);
-        size_t newSize = m_Size + strLen;
-
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = newSize;
-        }
-
-        memcpy(m_Data + m_Size, str, strLen);
-        m_Size = newSize;
-    }
-    void Append(const char* str, size_t strLen) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + strLen;
-
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = newSize;
-        }
-
-        memcpy(m_Data + m_Size, str, strLen);
-        m_Size = newSize;
-    }
-
-    void Append(char c) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + 1;
-
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Capacity = newSize;
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-        memset(m_Data + m_Size, c, 1);
-        m_Size = newSize;
-    }
-
-    void Append(const std::string& string){
-        size_t strLen = string.size();
-        size_t newSize = strLen + m_Size;
-
-        if(!m_CanModify || newSize > m_Capacity || !m_Data){
-            char* data = new char[newSize];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = newSize;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-        memcpy(m_Data + m_Size, string.data(), strLen);
-        m_Size = newSize;
-    }
-
-    void AppendString(const HBuffer& buffer) HBUFF_NOEXCEPT{
-        size_t otherSize = buffer.m_Size;
-        size_t newSize = m_Size + otherSize;
-        size_t minCapacity = newSize + 1;
-
-        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
-            char* data = new char[minCapacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = m_Size;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        memcpy(m_Data + m_Size, buffer.GetData(), otherSize);
-        memset(m_Data + newSize, '\0', 1);
-        m_Size = newSize;
-    }
-
-    /// @brief Appends a const char* with a specific length and makes sure buffer ends with a null terminator.
-    void AppendString(const char* str) HBUFF_NOEXCEPT{
-        size_t strLen = strlen(str);
-        size_t newSize = m_Size + strLen;
-        size_t minCapacity = newSize + 1;
-
-        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
-            char* data = new char[minCapacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = minCapacity;
-        }
-
-        memcpy(m_Data + m_Size, str, strLen);
-        memset(m_Data + newSize, '\0', 1);
-        m_Size = newSize;
-    }
-
-    /// @brief Appends a const char* with a specific length and makes sure buffer ends with a null terminator.
-    void AppendString(const char* str, size_t strLen) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + strLen;
-        size_t minCapacity = newSize + 1;
-
-        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
-            char* data = new char[minCapacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = minCapacity;
-        }
-
-        memcpy(m_Data + m_Size, str, strLen);
-        memset(m_Data + newSize, '\0', 1);
-        m_Size = newSize;
-    }
-    
-    void AppendString(const std::string& string){
-        size_t strLen = string.size();
-        size_t newSize = strLen + m_Size;
-        size_t minCapacity = newSize + 1;
-
-        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
-            char* data = new char[minCapacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_Capacity = minCapacity;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-        memcpy(m_Data + m_Size, string.data(), strLen);
-        m_Size = newSize;
-    }
-    /// @brief Appends a single character to the buffer and also makes sure there is a null terminator
-    void AppendString(char c) HBUFF_NOEXCEPT{
-        size_t newSize = m_Size + 1;
-        size_t minCapacity = newSize + 1;
-
-        if(!m_CanModify || minCapacity> m_Capacity || !m_Data){
-            char* data = new char[minCapacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            m_Capacity = minCapacity;
-        }
-        memset(m_Data + m_Size, c, 1);
-        memset(m_Data + newSize, '\0', 1);
-        m_Size = newSize;
-    }
-
-    /// @brief allocates a substring of buffer starting at param at with a length of len.
-    /// @param at the location in the buffer that will start filling up the substring
-    /// @param len the amount of characters to copy to new buffer. If -1 than whole buffer else caps out on buffer
-    HBuffer SubString(size_t at, size_t len) const HBUFF_NOEXCEPT{
-        if(at >= m_Size)return HBuffer();
-        size_t size = std::min(len, m_Size - at);
-
-        char* newData = new char[size + 1];
-        newData[size] = 0;
-        memcpy(newData, m_Data + at, size);
-        return HBuffer(newData, size, size + 1, true, true);
-    }
-
-    /// @brief Allocates a new copy of the buffer up to the size of the buffer
-    HBuffer GetCopy() const HBUFF_NOEXCEPT{
-        char* data = new char[m_Size];
-        memcpy(data, m_Data, m_Size);
-        return HBuffer(data, m_Size, true, true);
-    }
-
-    /// @brief Allocates a copy of the buffer with a null terminator
-    HBuffer GetCopyString() const HBUFF_NOEXCEPT{
-        HBuffer buff;
-        buff.ReserveString(m_Size);
-        buff.Copy(*this);
-        return buff;
-    }
-
-    /// @brief Create a new HBuffer that points to the same data as the current one but with an offset and or different size
-    /// @param allowModify a check to allow this subpointer to modify data as long as the main buffer also can modify this data
-    HBuffer SubPointer(size_t at, size_t len=-1, bool allowModify = true) const HBUFF_NOEXCEPT{
-        if(at >= m_Size)return HBuffer();
-        size_t size = std::min(len, m_Size - at);
-        return HBuffer(m_Data + at, size, m_Capacity - at, false, allowModify && m_CanModify);
-    }
-
-    /// @brief sam as substring without null terminator. allocates a subbuffer of buffer starting at param at with a length of len.
-    /// @param at the location in the buffer that will start filling up the substring
-    /// @param len the amount of characters to copy to new buffer. If -1 than whole buffer. Caps out on buffer size
-    HBuffer SubBuffer(size_t at, size_t len) const HBUFF_NOEXCEPT{
-        HBuffer buffer;
-        //TODO: make sure at isnt greater than buffer size
-        buffer.m_Size = std::min(m_Size - at, len);
-        buffer.m_Capacity = buffer.m_Size;
-        buffer.m_Data = new char[buffer.m_Capacity];
-
-        for(size_t i = 0; i < buffer.m_Size; i++){
-            buffer.m_Data[i] = m_Data[at++];
-        }
-        buffer.m_CanFree = true;
-        buffer.m_CanModify = true;
-        return buffer;
-    }
-    /// @brief swaps the contents of self with param buff
-    /// @param buff
-    void Swap(HBuffer& buff) HBUFF_NOEXCEPT{
-        char* data = buff.m_Data;
-        size_t capacity = buff.m_Capacity;
-        size_t size = buff.m_Size;
-        bool canFree = buff.m_CanFree;
-        bool canModify = buff.m_CanModify;
-
-        buff.m_Data = m_Data;
-        buff.m_Size = m_Size;
-        buff.m_Capacity = m_Capacity;
-        buff.m_CanFree = m_CanFree;
-        buff.m_CanModify = m_CanModify;
-
-        m_Data = data;
-        m_Capacity = capacity;
-        m_Size = size;
-        m_CanFree = canFree;
-        m_CanModify = canModify;
-    }
-
-    /// @brief makes data point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or strlen > capacity.
-    /// @param str the null ternimated string literal we are copying
-    void Copy(const char* str)HBUFF_NOEXCEPT{
-        m_Size = strlen(str);
-        if(m_Size < 1){
-            //copy of nothing
-            //Free();
-            return;
-        }
-        if(!m_Data || !m_CanModify || m_Size > m_Capacity){
-            Delete();
-            m_Data = new char[m_Capacity];
-            m_Capacity = m_Size;
-            memcpy(m_Data, str, m_Size);
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, const_cast<char*>(str), m_Size);
-    }
-    /// @brief makes data at param at point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or strlen > capacity.
-    /// @param at the position in the buffer to copy the data to. Will reallocate if at is greater than capacity
-    /// @param str the null ternimated string literal we are copying
-    void Copy(size_t at, const char* str)HBUFF_NOEXCEPT{
-        size_t strLen = strlen(str);
-        size_t minimumSize = at + strLen;
-        if(minimumSize > m_Size || !m_CanModify || !m_Data){
-            m_Capacity = minimumSize;
-            char* data = new char[minimumSize];
-            memcpy(data, m_Data, m_Size);
-            memcpy(data + at, str, strLen);
-            Delete();
-            m_Data = data;
-            m_Size = minimumSize;
-            m_CanModify = true;
-            m_CanFree = true;
-            return;
-        }
-
-        memcpy(m_Data + at, const_cast<char*>(str), strLen);
-        m_Size = minimumSize > m_Size ? minimumSize : m_Size;
-    }
-    /// @brief makes data at param at point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or len > capacity.
-    /// @param at the position in the buffer to copy the data to. Will reallocate if at is greater than capacity
-    /// @param str the null ternimated string literal we are copying
-    void Copy(size_t at, char* str, size_t len)HBUFF_NOEXCEPT{
-        size_t minimumSize = at + len;
-        if(minimumSize > m_Size || !m_CanModify || !m_Data){
-            m_Capacity = minimumSize;
-            char* data = new char[minimumSize];
-            memcpy(data, m_Data, m_Size);
-            memcpy(data + at, str, len);
-            Delete();
-            m_Data = data;
-            m_Size = minimumSize;
-            m_CanModify = true;
-            m_CanFree = true;
-            return;
-        }
-        
-        memcpy(m_Data + at, const_cast<char*>(str), len);
-        m_Size = minimumSize > m_Size ? minimumSize : m_Size;
-    }
-    /// @brief makes buffers data point to the content of the null terminated string.
-    /// @param str the null terminated string literal to copy
-    /// @param size the amount of bytes to copy
-    void Copy(char* str, size_t size)HBUFF_NOEXCEPT{
-        m_Size = size;
-        if(m_Size < 1){
-            //copy of nothing
-            Free();
-            return;
-        }
-        if(!m_Data || !m_CanModify || m_Size > m_Capacity){
-            Delete();
-
-            m_Data = new char[m_Capacity];
-            m_Capacity = m_Size;
-            memcpy(m_Data, str, m_Size);
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, const_cast<char*>(str), m_Size);
-    }
-    /// @brief makes the buffers content point to a copy of the contents inside the std::string
-    /// @param string the string to make a copy of
-    void Copy(const std::string& string)HBUFF_NOEXCEPT{
-        m_Size = string.size();
-        if(m_Size < 1){
-            //Free();
-            return;
-        }
-        if(!m_Data || !m_CanModify || m_Size > m_Capacity){
-            Delete();
-            m_Data = new char[m_Capacity];
-            m_Size = m_Capacity;
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-        //We have access to a valid memory range to copy to
-        memcpy(m_Data, const_cast<char*>(string.c_str()), m_Size);
-    }
-    /// @brief Makes an exact owning copy of param buff. Frees and reallocates if no self has no valid data ptr, cant modify self, or self size > capacity.
-    /// @param buff the HBuffer to make a copy of
-    void Copy(const HBuffer& buff)HBUFF_NOEXCEPT{
-        size_t newSize = buff.m_Size;
-        if(newSize > 0 && (!m_Data || !m_CanModify || newSize > m_Capacity)){
-            Delete();
-            char* data = new char[newSize];
-            memcpy(data, buff.m_Data, m_Size);
-            m_Capacity = newSize;
-            m_Size = newSize;
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-        //Copy data into buff
-        m_Size = newSize;
-        memcpy(m_Data, buff.m_Data, m_Size);
-    }
-
-    ///@brief The exact same as Copy(const char*) except we add a null terminator at the end to our buffer without including the null terminator in size/capacity. This essentially makes the buffer a string
-    void CopyString(const char* str)HBUFF_NOEXCEPT{
-        m_Size = strlen(str);
-        if(m_Size < 1){
-            //Free();
-            return;
-        }
-        if(!m_Data || m_CanModify || m_Size >= m_Capacity){
-            Delete();
-            m_Capacity = m_Size + 1;
-            m_Data = new char[m_Capacity];
-            memcpy(m_Data, str, m_Size + 1);
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, str, m_Size + 1);
-    }
-    ///@brief The exact same as Copy(char*, size_t) except we add a null terminator at the end to our buffer without including the null terminator in size/capacity. This essentially makes the buffer a string
-    /// @param characters the amount of characters to copy into the buffer. Does not include the null terminator
-    void CopyString(char* str, size_t characters)HBUFF_NOEXCEPT{
-        m_Size = characters;
-        if(m_Size < 1){
-            //Free();
-            return;
-        }
-        if(!m_Data || m_CanModify || m_Size >= m_Capacity){
-            Delete();
-            m_Capacity = m_Size + 1;
-            m_Data = new char[m_Capacity];
-            memcpy(m_Data, str, m_Size);
-            m_Data[m_Size] = '\0';
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, str, m_Size);
-        m_Data[m_Size] = '\0';
-    }
-    void CopyString(const std::string& string) HBUFF_NOEXCEPT{
-        m_Size = string.size();
-        if(m_Size < 1){
-            //Free();
-            return;
-        }
-        if(!m_Data || m_CanModify || m_Size >= m_Capacity){
-            Delete();
-            m_Capacity = m_Size + 1;
-            m_Data = new char[m_Capacity];
-            memcpy(m_Data, string.c_str(), m_Size);
-            m_Data[m_Size] = '\0';
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, string.c_str(), m_Size);
-        m_Data[m_Size] = '\0';
-    }
-    void CopyString(const HBuffer& buff) HBUFF_NOEXCEPT{
-        m_Size = buff.m_Size;
-        if(m_Size < 1){
-            //Free();
-            return;
-        }
-        if(!m_Data || m_CanModify || m_Size >= m_Capacity){
-            Delete();
-            m_Capacity = m_Size + 1;
-            m_Data = new char[m_Capacity];
-            memcpy(m_Data, buff.m_Data, m_Size);
-            m_Data[m_Size] = '\0';
-            
-            m_CanFree = true;
-            m_CanModify = true;
-            return;
-        }
-
-        memcpy(m_Data, buff.m_Data, m_Size);
-        m_Data[m_Size] = '\0';
-    }
-public:
-    /// @brief Splits the buffer into multiple sub pointers with a delimiter
-    /// @param max the max amount of times to split by delimiter
-    template<typename Allocator=std::allocator<HBuffer>>
-    std::vector<HBuffer, Allocator> SubPointerSplitByDelimiter(char delim, size_t max=-1)const HBUFF_NOEXCEPT{
-        std::vector<HBuffer, Allocator> parts;
-        size_t lastAt = 0;
-        size_t i;
-        for(i = 0; i < m_Size; i++){
-            char c = m_Data[i];
-            if(c == delim){
-                parts.emplace_back(SubPointer(lastAt, i - lastAt));
-                lastAt = i +1;
-                max--;
-                if(max==0){
-                    break;
-                }
-            }
-        }
-        if(lastAt < m_Size)parts.emplace_back(SubPointer(lastAt, -1));
-        return parts;
-    }
-
-public:
-    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{
-        size_t i = 0, strLen = strlen(str);
-
-        while(true){
-            if(str[i] == '\0')return true;
-            if(at >= m_Size)return false;
-            if(m_Data[at] != str[i])return false;
-            at++;
-            i++;
-        }
-
-        return true;
-    }
-    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
-        size_t i = 0;
-
-        while(true){
-            if(str[i] == '\0')return true;
-            if(at >= m_Size)return false;
-            if(m_Data[at] != str[i])return false;
-            at++;
-            i++;
-        }
-
-        return true;
-    }
-    bool StartsWith(const char* str) const HBUFF_NOEXCEPT{
-        size_t i = 0, strLen = strlen(str);
-
-        while(true){
-            if(str[i] == '\0')return true;
-            if(i == m_Size)return false;
-            if(m_Data[i] != str[i])return false;
-            i++;
-        }
-
-        return true;
-    }
-    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
-        size_t i = 0;
-
-        while(true){
-            if(str[i] == '\0')return true;
-            if(i == m_Size)return false;
-            if(m_Data[i] != str[i])return false;
-            i++;
-        }
-
-        return true;
-    }
-
-    /// @brief Checks if the buffer ends with a certain string excluding the null terminator.
-    /// @return returns if the buffer ends with the c string. Returns true in anycase where the buffer has 0 bytes or the string has 0 bytes
-    bool EndsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
-        if(len > m_Size)return false;
-        for(size_t i = m_Size - len; i < m_Size; i++){
-            if(m_Data[i] != str[0])return false;
-            str++;
-        }
-        return true;
-    }
-    
-    /// @brief Checks if the buffer ends with a certain string excluding the null terminator.
-    /// @return returns if the buffer ends with the c string. Returns true in anycase where the buffer has 0 bytes or the string has 0 bytes
-    bool EndsWith(const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-        if(len > m_Size)return false;
-        for(size_t i = m_Size - len; i < m_Size; i++){
-            if(m_Data[i] != str[0])return false;
-            str++;
-        }
-        return true;
-    }
-
-    //TODO: POssible rename
-    /// @return returns 0 if success return -1 if buffer is out of data and 1 if data doesnt match
-    int StrXCmp(const char* str) const HBUFF_NOEXCEPT{
-        size_t i = 0;
-        while(true){
-            if(str[i] == '\n')return 0;
-            if(i == m_Size)return -1;
-            if(str[i] != m_Data[i])return 1;
-            i++;
-        }
-        return 0;
-    }
-
-    void Memset(char byte, size_t len) HBUFF_NOEXCEPT{
-        memset(m_Data, byte, len);
-        m_Size = len;
-    }
-    /// @brief Copies contents of buffer into param dest for len bytes
-    void Memcpy(void* src, size_t len) const HBUFF_NOEXCEPT{
-        memcpy(m_Data, src, len);
-    }
-    /// @brief Attempts to copy contents of buffer from at into dest for len bytes
-    void Memcpy(void* src, size_t at, size_t len) const HBUFF_NOEXCEPT{
-        memcpy(m_Data, reinterpret_cast<void*>(reinterpret_cast<size_t>(src) + at), len);
-    }
-
-    /// @brief Reverses the data inside the array from 0-m_Size. Turns data at 0 into data at m_Size and data at m_Size into data at 0
-    void Reverse() HBUFF_NOEXCEPT{
-        for(size_t i = 0; i < m_Size / 2; i++){
-            size_t reverseIndex = m_Size - 1 - i;
-            char temp = m_Data[i];
-            m_Data[i] = m_Data[reverseIndex];
-            m_Data[reverseIndex] = temp;
-        }
-    }
-
-    /// @brief makes sure the string ends with a null terminator. Reallocates buffer if necessary
-    void MakeSafeString() HBUFF_NOEXCEPT{
-        if(m_Capacity > 0 && m_Data[m_Size] == '\0')
-            return;
-        if(!m_Data || !m_CanModify || m_Size >= m_Capacity){
-            m_Capacity = m_Size + 1;
-            char* data = new char[m_Capacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-        m_Data[m_Size] = '\0';
-    }
-    HBuffer GetSafeString() const HBUFF_NOEXCEPT{
-        HBuffer buff;
-        buff.AppendString(*this);
-        return buff;
-    }
-
-    /// @brief Allocates a new c string on the heap with the data of the buffer followed by null terminator without modifying the current buffer.
-    /// @return if current buffer is not a c string or is too small to be one we allocate new data and return a new buffer. Else we return a view of the current one.
-    HBuffer GetSafeCString() const HBUFF_NOEXCEPT{
-        if(m_Capacity < 1 || m_Capacity == m_Size){
-            size_t newCapacity = m_Capacity + 1;
-            char* data = new char[newCapacity];
-            memcpy(data, m_Data, m_Size);
-            return HBuffer(data, m_Size, newCapacity, true, true);
-        }
-        if(m_Data[m_Size] != '\00'){
-            size_t capacity = m_Size + 1;
-            char* data = new char[capacity];
-            memcpy(data, m_Data, m_Size);
-            data[m_Size] = '\00';
-            return HBuffer(data, m_Size, capacity, true, true);
-        }
-        return *this;
-    }
-    
-    /// @brief Makes sure there is a null terminator at the end of the buffer and returns the buffers data. Might of just made this for nothing
-    const char* TurnToSafeCString() HBUFF_NOEXCEPT{
-        if(m_Capacity <= m_Size){
-            m_Capacity = m_Size + 1;
-            char* data = new char[m_Capacity];
-            memcpy(data, m_Data, m_Size);
-            Delete();
-            m_Data = data;
-            m_CanFree = true;
-            m_CanModify = true;
-        }
-
-        memset(m_Data + m_Size, '\0', 1);
-        return m_Data;
-    }
-public:
-    /// @brief if the data is not a null pointer then trust it else we return a basic static memory pointer to a null terminator
-    const char* GetCStr() const HBUFF_NOEXCEPT{return m_Data ? m_Data : "";}
-    /// @brief returns if the buffer owns the data
-    HBUFF_CONSTEXPR bool CanFree() const HBUFF_NOEXCEPT{return m_CanFree;}
-    /// @brief returns if the buffer may modify the data
-    HBUFF_CONSTEXPR bool CanModify() const HBUFF_NOEXCEPT{return m_CanModify;}
-    /// @brief returns the pointer to the data the buffer is using
-    HBUFF_CONSTEXPR char* GetData() const HBUFF_NOEXCEPT{return m_Data;}
-    /// @brief returns the size of the buffer
-    HBUFF_CONSTEXPR size_t GetSize() const HBUFF_NOEXCEPT{return m_Size;}
-    /// @brief returns the capacity of the buffer
-    HBUFF_CONSTEXPR size_t GetCapacity() const HBUFF_NOEXCEPT{return m_Capacity;}
-public:
-    char& operator[](size_t at) HBUFF_NOEXCEPT{
-        return m_Data[at];
-    }
-    /// @brief Assigns the current buffers content as a copy of param right's data
-    HBuffer& operator=(const HBuffer& right) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = right.m_Data;
-        m_Size = right.m_Size;
-        m_Capacity = right.m_Capacity;
-        m_CanModify = right.m_CanModify;
-        m_CanFree = false;
-        return *this;
-    }
-    
-    /// @brief Frees current data if possible and basically does a move constructor with param right
-    HBuffer& operator=(HBuffer&& right) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = right.m_Data;
-        m_Size = right.m_Size;
-        m_Capacity = right.m_Capacity;
-        m_CanFree = right.m_CanFree;
-        m_CanModify = right.m_CanModify;
-        right.Release();
-        return *this;
-    }
-    /// @brief assigns buffer to a non owning string literal
-    HBuffer& operator=(const char* right) HBUFF_NOEXCEPT{
-        Free();
-        m_Data = const_cast<char*>(right);
-        m_Size = strlen(right);
-        m_Capacity = m_Size + 1;
-        m_CanFree = false;
-        m_CanModify = false;
-        return *this;
-    }
-
-    friend HBuffer operator+(const char* left, const HBuffer& right) HBUFF_NOEXCEPT{
-        size_t strLen = strlen(left);
-        if(strLen + right.m_Size < 1)return HBuffer();
-        HBuffer buffer;
-        size_t newSize = strLen + right.m_Size;
-        buffer.Reserve(newSize + 1);
-        buffer.SetSize(newSize);
-        char* data = buffer.GetData();
-        memcpy(data, left, strLen);
-        memcpy(data + strLen, right.m_Data, right.m_Size);
-        memset(data + newSize, '\0', 1);
-        return buffer;
-    }
-    /// @brief appends data as ascii strings
-    HBuffer& operator+=(const char* right) HBUFF_NOEXCEPT{
-        size_t strLen = strlen(right);
-        size_t newSize = m_Size + strLen;
-
-        if(!m_CanFree || !m_CanModify || newSize >= m_Capacity){
-            char* data = new char[newSize];
-            memcpy(m_Data, data, m_Size);
-            Delete();
-            m_Capacity = newSize;
-            m_Data = data;
-        }
-        memcpy(m_Data + m_Size, right, strLen);
-        memset(m_Data, static_cast<int>(newSize-1),'\0');
-        m_Size = newSize;
-        return *this;
-    }
-    
-    /// @brief appends data as ascii strings
-    HBuffer& operator+=(const HBuffer& right) HBUFF_NOEXCEPT{
-        size_t strLen = right.GetSize();
-        size_t newSize = m_Size + strLen + 1;
-
-        if(!m_CanFree || !m_CanModify || newSize >= m_Capacity){
-            char* data = new char[newSize];
-            memcpy(m_Data, data, m_Size);
-            Delete();
-            m_Capacity = newSize;
-
-        }
-        memcpy(m_Data + m_Size, right.GetData(), strLen);
-        memset(m_Data, static_cast<int>(newSize-1),'\0');
-        m_Size = newSize;
-        return *this;
-    }
-    
-    /// @brief compares if the data inside the buffer matches and not the places in memory.
-    HBUFF_CONSTEXPR bool operator==(const HBuffer& right)const HBUFF_NOEXCEPT{
-        if(m_Size != right.m_Size)return false;
-
-        //Assuming if it has a size it has valid memory if not then the user created the buffer wrong
-        //if(!m_Data || !right.m_Data)return false;
-
-        const char* other = right.m_Data;
-        for(size_t i = 0; i < m_Size; i++)
-            if(m_Data[i] != other[i])return false;
-        return true;
-    }
-    /// @brief compares if the data inside the buffers are strings and match
-    HBUFF_CONSTEXPR bool operator==(const char* str)const HBUFF_NOEXCEPT{
-        size_t strLen = 0;
-        while(str[strLen] != '\0')strLen++;
-        if(m_Size != strLen)return false;
-
-        for(size_t i = 0; i < m_Size; i++)
-            if(m_Data[i] != str[i])return false;
-        
-        return true;
-    }
-    /// @brief compares if the data inside the buffers are strings and match
-    HBUFF_CONSTEXPR bool operator==(char c)const HBUFF_NOEXCEPT{
-        if(m_Size != 1)return false;
-        return m_Data[0] == c;
-    }
-    /// @brief returns if the contents are not equal. If one of the buffers does not have data returns false; else returns if contents match.
-    HBUFF_CONSTEXPR bool operator!=(const HBuffer& right)const HBUFF_NOEXCEPT{
-        if(m_Size != right.m_Size)return true;
-        if(!m_Data || !right.m_Data)return false;
-
-        const char* other = right.m_Data;
-        for(size_t i = 0; i < m_Size; i++)
-            if(m_Data[i] != other[i])return true;
-        return false;
-    }
-    /// @brief returns if the contents are not equal. If one of the buffers does not have data returns false; else returns if contents match.
-    HBUFF_CONSTEXPR bool operator!=(const char* str)const HBUFF_NOEXCEPT{
-        size_t strLen = 0;
-        while(str[strLen] != '\0')strLen++;
-        if(m_Size != strLen)return true;
-
-        for(size_t i = 0; i < m_Size; i++)
-            if(m_Data[i] != str[i])return true;
-
-        return false;
-    }
-    /// @brief returns if the contents are not equal. If one of the buffers does not have data returns false; else returns if contents match.
-    HBUFF_CONSTEXPR bool operator!=(char c)const HBUFF_NOEXCEPT{
-        if(m_Size != 1)return true;
-        return m_Data[0] != c;
-    }
-    std::ostream& operator<<(std::ostream& os) {
-        for(size_t i = 0; i < m_Size; i++)os << m_Data[i];
-        return os;
-    }
-    operator bool() const HBUFF_NOEXCEPT{
-        return m_Data != nullptr;
-    }
-private:
-    char* m_Data = nullptr;
-    size_t m_Size = 0;
-    size_t m_Capacity = 0;
-    bool m_CanFree = false;
-    bool m_CanModify = false;
-};
-
-#ifdef HBUFF_USE_FMT_LOGGER
-template <>
-struct fmt::formatter<HBuffer> {
-    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
-
-    template <typename FormatContext>
-    auto format(const HBuffer& buff, FormatContext& ctx) const{
-        // safely use HBuffer's API
-        return fmt::format_to(ctx.out(), "{}", buff.SubString(0, -1).GetCStr());
-    }
-};
-#endif
-namespace std {
-    template<>
-    struct hash<HBuffer> {
-        std::size_t operator()(const HBuffer& buff) const HBUFF_NOEXCEPT{
-            std::size_t hash = 0;
-            std::size_t prime = 31; // A small prime number
-
-            char* data = buff.GetData();
-            for (size_t i = 0; i < buff.GetSize(); i++)
-                hash = hash * prime + data[i];
-
-            return hash;
-        }
-    };
+#pragma once
+
+#include "Core.h"
+#include "HBufferAllocators.hpp"
+#include "HBufferStats.hpp"
+#include "HBufferTrace.hpp"
+#include "HBufferSimd.hpp"
+#include "HBufferHash.hpp"
+#include "HBufferNumbers.hpp"
+
+/// HBUFF_ENDIAN_MODE == 0. Little Endian
+/// HBUFF_ENDIAN_MODE == 1. Big Endian
+
+#ifndef HBUFF_ENDIAN_MODE
+/// Defaulting to Little Endian
+#define HBUFF_ENDIAN_MODE 0
+#endif
+
+#include "HBufferBinary.hpp"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// HBUFF_GROWTH_MODE == 0. Exact fit. Appending reallocates to exactly the needed size
+/// HBUFF_GROWTH_MODE == 1. Grows capacity by 1.5x
+/// HBUFF_GROWTH_MODE == 2. Grows capacity by 2x
+/// HBUFF_GROWTH_MODE == 3. Grows capacity by 2x and rounds up to a multiple of HBUFF_GROWTH_PAGE_SIZE once past a page
+
+#ifndef HBUFF_GROWTH_MODE
+/// Defaulting to 2x growth
+#define HBUFF_GROWTH_MODE 2
+#endif
+
+#ifndef HBUFF_GROWTH_PAGE_SIZE
+#define HBUFF_GROWTH_PAGE_SIZE 4096
+#endif
+
+#ifndef HBUFF_GROWTH_MIN_CAPACITY
+/// Smallest capacity a growing buffer allocates so the first few appends do not each reallocate
+#define HBUFF_GROWTH_MIN_CAPACITY 16
+#endif
+
+#ifndef HBUFF_SMALL_BUFFER_SIZE
+/// When > 0 owned data of up to this many bytes is stored inside the HBuffer object instead of on the heap. 24 fits 23 characters and a null terminator
+/// Inline data moves with the object so views of a small buffer must not outlive a move of it. Defaulting to off
+#define HBUFF_SMALL_BUFFER_SIZE 0
+#endif
+
+#ifndef HBUFF_COW_UNIQUE_CHECK
+/// When 1 a shared buffer that is the only reference left writes into the shared block instead of copying on its first mutation
+#define HBUFF_COW_UNIQUE_CHECK 1
+#endif
+
+#ifndef HBUFF_GROWTH_CAP
+/// When not 0 a single growth never adds more than this many bytes so huge buffers grow linearly
+#define HBUFF_GROWTH_CAP 0
+#endif
+
+/// madvise hints for HBuffer::MapFile and HBuffer::Advise. Combine with |
+#define HBUFF_MAP_ADVICE_NONE 0
+/// Read front to back. The kernel reads ahead aggressively and drops pages behind
+#define HBUFF_MAP_ADVICE_SEQUENTIAL 1
+/// Read in no order. Turns read ahead off
+#define HBUFF_MAP_ADVICE_RANDOM 2
+/// Start paging the data in now
+#define HBUFF_MAP_ADVICE_WILLNEED 4
+/// Back the mapping with transparent huge pages where the kernel supports it
+#define HBUFF_MAP_ADVICE_HUGEPAGE 8
+
+/// @brief how HBuffer::MapFile maps a file
+enum class HBufferMapMode : uint8_t{
+    /// The pages are read only. Mutating the buffer copies it first
+    ReadOnly = 0,
+    /// The pages are writable but private. Writes never reach the file and only the pages written get copied, by the kernel
+    Private = 1
+};
+
+/// @brief gives back bytes a shared block does not own. Gets the data, its size and the context it was created with
+typedef void (*HBufferReleaseHook)(char* data, size_t size, void* context);
+
+/// @brief Header placed in front of the bytes of a shared buffer so the count and the data come from a single allocation.
+/// @brief Every HBuffer pointing into the bytes holds one reference and the last one to let go frees the block
+struct HBufferSharedBlock{
+    std::atomic<size_t> m_References;
+    /// @brief where the whole block came from. nullptr means new[]
+    HBufferAllocator* m_Allocator;
+    /// @brief size of the whole allocation including this header
+    size_t m_BlockSize;
+    /// @brief set when the bytes live somewhere else and are given back through it, see HBufferExternalBlock. nullptr when they follow this header
+    HBufferReleaseHook m_Release;
+
+    inline char* GetData() HBUFF_NOEXCEPT;
+    inline size_t GetCapacity() const HBUFF_NOEXCEPT;
+    /// @brief returns if the last reference may write into the bytes instead of copying them
+    inline bool IsWritable() const HBUFF_NOEXCEPT;
+};
+/// @brief A shared block for bytes it does not own, like a file mapping. Only the header is allocated
+struct HBufferExternalBlock : HBufferSharedBlock{
+    char* m_External;
+    size_t m_ExternalSize;
+    void* m_Context;
+    bool m_Writable;
+};
+inline char* HBufferSharedBlock::GetData() HBUFF_NOEXCEPT{
+    if(m_Release)return static_cast<HBufferExternalBlock*>(this)->m_External;
+    return reinterpret_cast<char*>(this + 1);
+}
+inline size_t HBufferSharedBlock::GetCapacity() const HBUFF_NOEXCEPT{
+    if(m_Release)return static_cast<const HBufferExternalBlock*>(this)->m_ExternalSize;
+    return m_BlockSize - sizeof(HBufferSharedBlock);
+}
+inline bool HBufferSharedBlock::IsWritable() const HBUFF_NOEXCEPT{
+    return !m_Release || static_cast<const HBufferExternalBlock*>(this)->m_Writable;
+}
+
+/// TODO: For reallocation chekds just check if we cn modify 
+class HBuffer{
+public:
+    friend class HBufferJoin;
+    /// @brief Initializes HBuffer to point to nothing and own nothing
+    HBuffer()HBUFF_NOEXCEPT:m_Data(nullptr), m_Size(0), m_Capacity(0), m_CanFree(false), m_CanModify(false){}
+    /// @brief Initializes HBuffer to point to nothing and own nothing. Any data it allocates later comes from param allocator
+    /// @param allocator where the buffer gets its memory from. nullptr uses the thread default allocator or the heap
+    explicit HBuffer(HBufferAllocator* allocator)HBUFF_NOEXCEPT:m_Data(nullptr), m_Size(0), m_Capacity(0), m_CanFree(false), m_CanModify(false), m_Allocator(allocator){}
+    /// @brief Points data to str and allows you to decide if that data should be modified or not
+    /// @param str the string literal to point to
+    /// @param canFree gives ownership to buffer
+    /// @param canModify decides if buffer is allowed to modify data
+    HBuffer(const char* str, bool canFree, bool canModify)HBUFF_NOEXCEPT
+        : m_Size(strlen(str)), m_Capacity(m_Size + 1), m_Data(const_cast<char*>(str)), m_CanFree(canFree), m_CanModify(canModify){
+        if(canFree)HBufferStats::RecordAllocate(m_Capacity);
+    }
+    
+    
+    /// @brief Makes data point to str and gives it a size/capacity to use depending on canModify. Will complete buffer if canFree is true
+    /// @param str 
+    /// @param len the amount of characters or size in the param str
+    /// @param canFree 
+    /// @param canModify decides if the buffer can directly modify data or if it has to make a copy if it needs to edit data
+    HBuffer(const char* str, size_t len, bool canFree, bool canModify)HBUFF_NOEXCEPT:m_Size(len), m_Data(const_cast<char*>(str)), m_Capacity(m_Size + 1), m_CanFree(canFree), m_CanModify(canModify){
+        if(canFree)HBufferStats::RecordAllocate(m_Capacity);
+    }
+    
+    /// @brief Makes data point to str and gives it a size/capacity to use depending on canModify. Will complete buffer if canFree is true
+    /// @param str 
+    /// @param len the amount of characters or size in the param str
+    /// @param capacity the amount of characters or size in the param str
+    /// @param canFree 
+    /// @param canModify decides if the buffer can directly modify data or if it has to make a copy if it needs to edit data
+    explicit HBuffer(char* str, size_t len, size_t capacity, bool canFree, bool canModify)HBUFF_NOEXCEPT:m_Size(len), m_Data(const_cast<char*>(str)), m_Capacity(capacity), m_CanFree(canFree), m_CanModify(canModify){
+        if(canFree)HBufferStats::RecordAllocate(m_Capacity);
+    }
+    
+    /// @brief Makes the buffer an exact non owning copy of param buffer
+    /// @param buffer 
+    HBuffer(const HBuffer& buffer)HBUFF_NOEXCEPT :m_Data(buffer.m_Data), m_Size(buffer.m_Size), m_Capacity(buffer.m_Capacity), m_CanFree(false), m_CanModify(buffer.m_CanModify), m_Allocator(buffer.m_Allocator){
+        //We assume @param buffer owns the data and will manage it properly. Unless it is shared in which case we take a reference
+        ShareWith(buffer);
+        HBufferTrace::Record(HBufferTraceEvent::Copy, m_Size);
+    }
+    /// @brief Moves param buffer into self and releases param buffers data
+    /// @param buffer the buffer to get data from and release
+    HBuffer(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        m_Data = buffer.m_Data;
+        m_Size = buffer.m_Size;
+        m_Capacity = buffer.m_Capacity;
+        m_CanFree = buffer.m_CanFree;
+        m_CanModify = buffer.m_CanModify;
+        m_Allocator = buffer.m_Allocator;
+        m_Shared = buffer.m_Shared;
+        TakeInline(buffer);
+        buffer.Release();
+    }
+
+    /// @brief sets buffer as non owning view of string literal
+    HBuffer(const char* str) HBUFF_NOEXCEPT{
+        m_Data = const_cast<char*>(str);
+        m_Size = strlen(str);
+        m_Capacity = m_Size + 1;
+        m_CanFree = false;
+        m_CanModify = false;
+    }
+    /// @brief Makes a copy of the string
+    /// @param string 
+    explicit HBuffer(const std::string& str) HBUFF_NOEXCEPT{
+        m_Size = strlen(str.c_str());
+        m_Capacity = m_Size + 1;
+        m_Data = AllocateData(m_Capacity);
+        m_Data[m_Size] = '\0';
+        m_CanFree = true;
+        m_CanModify = true;
+
+        memcpy(m_Data, str.c_str(), m_Size);
+    }
+
+    /// @brief will Free data if owns
+    ~HBuffer(){
+        ReleaseData(m_Allocator);
+    }
+
+    /// @brief Frees data if can. Only modifies m_CanFree and m_Data
+    inline void Delete() HBUFF_NOEXCEPT{
+        ReleaseData(m_Allocator);
+        m_Data = nullptr;
+        m_CanFree = false;
+        m_Shared = nullptr;
+    }
+    /// @brief Frees data if buffer is owning and releases after regardless
+    inline void Free() HBUFF_NOEXCEPT{  
+        if(m_CanFree || m_Shared){
+            ReleaseData(m_Allocator);
+        }
+        //Release data regardless
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Capacity = 0;
+        m_CanFree = false;
+        m_CanModify = false;
+        m_Shared = nullptr;
+    }
+    /// @brief releases data without freeing. Will lead to memory leaks unless used properly
+    inline void Release() HBUFF_NOEXCEPT{
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Capacity = 0;
+        m_CanFree = false;
+        m_CanModify = false;
+        m_Shared = nullptr;
+    }
+    /// @brief only changes m_Data pointer without freeing/resizing.
+    void SetData(char* data) HBUFF_NOEXCEPT{
+        m_Data = data;
+    }
+    /// @brief changes if we own the data or not
+    void SetCanFree(bool value) HBUFF_NOEXCEPT{
+        m_CanFree = value;
+    }
+
+    /// @brief changes if we are allowed to modify the data or not. without nullptr checks
+    void SetCanModify(bool canModify) HBUFF_NOEXCEPT{
+        m_CanModify = canModify;
+    }
+
+    /// @brief changes where the buffer gets its memory from. If we own data it gets moved into memory from the new allocator
+    /// @param allocator the new allocator. nullptr uses the thread default allocator or the heap
+    void SetAllocator(HBufferAllocator* allocator) HBUFF_NOEXCEPT{
+        if(allocator == m_Allocator)return;
+        if(!m_CanFree || !m_Data || IsInline()){
+            m_Allocator = allocator;
+            return;
+        }
+        HBufferAllocator* oldAllocator = m_Allocator;
+        char* oldData = m_Data;
+        size_t oldCapacity = m_Capacity;
+
+        m_Allocator = allocator;
+        m_Data = AllocateData(m_Capacity);
+        memcpy(m_Data, oldData, std::min(m_Size, oldCapacity));
+        DeallocateData(oldAllocator, oldData, oldCapacity);
+    }
+
+    /// @brief Sets the size of the buffer and reallocates and changes data if param size > m_Capacity
+    /// @param size the new buffer size in bytes
+    void SetSize(size_t size) HBUFF_NOEXCEPT{
+        if(size > m_Capacity)Reallocate(size, m_Capacity);
+        m_Size = size;
+    }
+
+
+    /// @brief assigns the size of the buffer to the param size without doing anything else. Doesnt check if its bigger than capacity or if we have valid data or anything.
+    /// @brief ;aram the new size in bytes
+    void AssignSize(size_t size) HBUFF_NOEXCEPT{
+        m_Size = size;
+    }
+
+    /// @brief strictly assigns the buffers capacity to the param capacity with no questions asked.
+    /// @param capacity the new capacity of the buffer in bytes
+    void AssignCapacity(size_t capacity) HBUFF_NOEXCEPT{
+        m_Capacity = capacity;
+    }
+
+    /// @brief drops the first param len bytes by moving the start forward, so nothing is copied and views into the rest stay valid.
+    /// @brief Heap data we own is first handed to a shared block that frees the whole allocation later. Inline data moves down instead,
+    /// @brief and data from an allocator that is not thread safe is copied once into a shared block, see ShareOwned
+    void RemovePrefix(size_t len) HBUFF_NOEXCEPT{
+        len = std::min(len, m_Size);
+        if(len < 1)return;
+        if(len == m_Size){
+            //Nothing is left to move so an owned buffer keeps its allocation for reuse
+            if(m_CanFree || IsInline())m_Size = 0;
+            else{
+                m_Data += len;
+                m_Capacity -= len;
+                m_Size = 0;
+            }
+            return;
+        }
+        if(IsInline())memmove(m_Data, m_Data + len, m_Size - len);
+        else if(m_CanFree){
+            ShareOwned(len);
+            return;
+        }
+        else{
+            m_Data += len;
+            m_Capacity -= len;
+        }
+        m_Size -= len;
+    }
+
+    void Resize(size_t newSize) HBUFF_NOEXCEPT{
+        if(newSize >= m_Capacity)Reallocate(newSize, m_Size);
+        m_Size = newSize;
+    }
+    /// @brief Reserves the buffer to be atleast param newSize bytes. If newSize <= capacity then no reallocation is done. Else we free/release data and reallocate
+    /// @param newCapacity the new capacity of the buffer. Only reallocates if newCapacity > m_Capacity 
+    void Reserve(size_t newCapacity) HBUFF_NOEXCEPT{
+        if(newCapacity <= m_Capacity)return;
+        Reallocate(newCapacity, m_Size);
+    }
+
+    /// @brief Reserves the buffer to be atleast param newSize bytes ontop of m_Size. If newSize <= capacity then no reallocation is done. Else we free/release data and reallocate
+    /// @param newCapacity the new capacity of the buffer. Only reallocates if newCapacity +m_Size > m_Capacity 
+    void ReserveExtra(size_t newCapacity) HBUFF_NOEXCEPT{
+        newCapacity+= m_Size;
+        if(newCapacity <= m_Capacity)return;
+        Reallocate(newCapacity, m_Size);
+    }
+
+    /// @brief grows the size by param len bytes and returns where the new bytes start so they can be written in place. The new bytes are not initialized
+    /// @brief Grows capacity the same way Append does
+    char* Extend(size_t len) HBUFF_NOEXCEPT{
+        size_t newSize = m_Size + len;
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+        char* at = m_Data + m_Size;
+        m_Size = newSize;
+        return at;
+    }
+
+    /// @brief returns the capacity a buffer of param current bytes grows to when it needs atleast param required bytes. Follows HBUFF_GROWTH_MODE
+    static size_t GetGrowthCapacity(size_t current, size_t required) HBUFF_NOEXCEPT{
+    #if HBUFF_GROWTH_MODE == 0
+        (void)current;
+        return required;
+    #else
+        #if HBUFF_GROWTH_MODE == 1
+        size_t grown = current + current / 2;
+        #else
+        size_t grown = current > static_cast<size_t>(-1) / 2 ? static_cast<size_t>(-1) : current * 2;
+        #endif
+        #if HBUFF_GROWTH_CAP > 0
+        if(grown - current > HBUFF_GROWTH_CAP)grown = current + HBUFF_GROWTH_CAP;
+        #endif
+        grown = std::max(grown, std::max<size_t>(required, HBUFF_GROWTH_MIN_CAPACITY));
+        #if HBUFF_GROWTH_MODE == 3
+        if(grown >= HBUFF_GROWTH_PAGE_SIZE && grown <= static_cast<size_t>(-1) - HBUFF_GROWTH_PAGE_SIZE)
+            grown = (grown + HBUFF_GROWTH_PAGE_SIZE - 1) / HBUFF_GROWTH_PAGE_SIZE * HBUFF_GROWTH_PAGE_SIZE;
+        #endif
+        return grown;
+    #endif
+    }
+
+    /// @brief Reserves newCapacity of bytes for a string. excluding the additional byte for the null terminator
+    void ReserveString(size_t newCapacity) HBUFF_NOEXCEPT{
+        newCapacity++;
+        if(newCapacity <= m_Capacity)return;
+        Reallocate(newCapacity, m_Size);
+        memset(m_Data + newCapacity - 1, '\0', 1);
+    }
+    
+    /// @return returns the character at i without safety checks
+    char At(size_t i) const HBUFF_NOEXCEPT{
+        return m_Data[i];
+    }
+    /// @return returns the character at i. returns '\0' if out of range
+    char Get(size_t i) const HBUFF_NOEXCEPT{
+        if(i < m_Size)return m_Data[i];
+        return '\0';
+    }
+
+    /// @brief returns the character at param at.
+    /// @param status true if success, false if failed to retrieve
+    /// @param at the position in the buffer to retrieve the byte from
+    char Retrieve(bool& status, size_t at) const noexcept{
+        if(at > m_Size){
+            status = false;
+            return 0;
+        }
+
+        status = true;
+        return m_Data[at];
+    }
+
+    /// @brief Creates a copy of the current buffer
+    HBuffer CreateCopy() const HBUFF_NOEXCEPT{
+        HBuffer buffer(m_Allocator);
+        buffer.Reserve(m_Size);
+        if(m_Size > 0)memcpy(buffer.m_Data, m_Data, m_Size);
+        buffer.m_Size = m_Size;
+        return buffer;
+    }
+    /// @brief Allocate a copy of data
+    static HBuffer CreateCopy(const std::string& string) HBUFF_NOEXCEPT{
+        size_t size = string.size();
+        HBuffer buffer;
+        buffer.Reserve(size + 1);
+        memcpy(buffer.m_Data, string.data(), size);
+        memset(buffer.m_Data + size, '\0', 1);
+        buffer.m_Size = size;
+        return buffer;
+    }
+#pragma region Numbers
+    /// @brief returns a new HBuffer with an ascii encoded base 10 string of param number. Works for every integer and floating point type
+    /// @brief floating point numbers are written with the fewest digits that still parse back to the same value
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    static HBuffer ToString(T number) HBUFF_NOEXCEPT{
+        HBuffer buffer;
+        buffer.AppendNumber(number);
+        return buffer;
+    }
+
+    /// @brief writes param number as an ascii encoded base 10 string straight into the end of the buffer and keeps it null terminated
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    void AppendNumber(T number) HBUFF_NOEXCEPT{
+        size_t minCapacity = m_Size + HBufferNumbers::GetMaxChars<T>() + 1;
+
+        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+        m_Size += HBufferNumbers::Format(m_Data + m_Size, number);
+        m_Data[m_Size] = '\0';
+    }
+
+    /// @brief Attempts to parse the whole buffer as an ascii encoded base 10 number. Signed types accept a leading '-'
+    /// @return true if success, false if the buffer is not a number or it does not fit in param output. output is left untouched on failure
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    bool ToNumber(T& output) const HBUFF_NOEXCEPT{
+        return HBufferNumbers::Parse(m_Data, m_Size, output);
+    }
+
+    /// @brief Assumes data in param buffer is a ascii encoded numerical base 10 string.
+    /// @param output a pointer to a size_t to store the result
+    static void StrictToNumber(const HBuffer& buffer, size_t* output) HBUFF_NOEXCEPT{
+        size_t number = 0;
+        buffer.ToNumber(number);
+        *output = number;
+    }
+
+    /// @brief Attempts to convert the string to a float
+    /// @return true if success, false if otherwise
+    bool ToFloat(float& output)HBUFF_NOEXCEPT{
+        return ToNumber(output);
+    }
+#pragma endregion
+public:
+    /// @brief Makes buffer point to a null terminated string literal
+    /// @param str the string to point to
+    /// @param canFree do we own this data
+    /// @param canModify can we modify this data
+    void Assign(const char* str, bool canFree, bool canModify) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = const_cast<char*>(str);
+        m_Size = strlen(m_Data);
+        m_Capacity = m_Size;
+        m_CanFree = canFree;
+        m_CanModify = canModify;
+        //Adopted data is expected to come from new[]
+        if(canFree){
+            m_Allocator = nullptr;
+            HBufferStats::RecordAllocate(m_Capacity);
+        }
+    }
+
+    /// @brief Sets data to point at a null terminated string literal.
+    /// @param str the string that the buffer points to
+    /// @param len the new length and capacity in bytes
+    /// @param canFree is this buffer owning this data
+    /// @param canModify can we modify this data
+    void Assign(const char* str, size_t len, bool canFree, bool canModify) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = const_cast<char*>(str);
+        m_Size = len;
+        m_Capacity = len;
+        m_CanFree = canFree;
+        m_CanModify = canModify;
+        if(canFree){
+            m_Allocator = nullptr;
+            HBufferStats::RecordAllocate(m_Capacity);
+        }
+    }
+
+    /// @brief Frees current data and assigns new data
+    /// @param data the new data to point to
+    /// @param len the buffers new length in bytes
+    /// @param capacity the buffers new capacity in bytes
+    /// @param canFree the buffers ability to free the data
+    /// @param canModify the buffers ability to modify its new data
+    void Assign(char* data, size_t len, size_t capacity, bool canFree, bool canModify) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = data;
+        m_Size = len;
+        m_Capacity = capacity;
+        m_CanFree = canFree;
+        m_CanModify = canModify;
+        if(canFree){
+            m_Allocator = nullptr;
+            HBufferStats::RecordAllocate(m_Capacity);
+        }
+    }
+
+
+    /// @brief frees and assigns self as a non owning view of param buffer. May modify if param buffer allows modifying
+    void Assign(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = buffer.m_Data;
+        m_Size = buffer.m_Size;
+        m_Capacity = buffer.m_Capacity;
+        m_CanModify = buffer.m_CanModify;
+        m_CanFree = false;
+        m_Allocator = buffer.m_Allocator;
+        ShareWith(buffer);
+    }
+
+    /// @brief Frees data and assigns data to param buffer. Then param buffer is released. Essentially making this buffer the owner
+    void Assign(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = buffer.m_Data;
+        m_Size = buffer.m_Size;
+        m_Capacity = buffer.m_Capacity;
+        m_CanModify = buffer.m_CanModify;
+        m_CanFree = buffer.m_CanFree;
+        m_Allocator = buffer.m_Allocator;
+        m_Shared = buffer.m_Shared;
+        TakeInline(buffer);
+        buffer.Release();
+    }
+
+    /// @brief Sets buffer to a non owning view that has the same properties of the param buffer
+    /// @param buffer 
+    /// @param canFree are we allowing the buffer to now own the data of param buffer? 
+    /// @param canModify are we going to allow the buffer to modify the contents of the new data from param buffer?
+    void Assign(HBuffer& buffer, bool canFree, bool canModify) HBUFF_NOEXCEPT{
+        Free();
+        /*
+        m_Data = buffer.m_Data;
+        m_Size = buffer.m_Size;
+        m_Capacity = buffer.m_Capacity;
+        m_CanModify = buffer.m_CanModify;
+        m_CanFree = false;
+        */
+        m_Data = buffer.m_Data;
+        m_Size = buffer.m_Size;
+        m_Capacity = buffer.m_Capacity;
+        m_CanFree = canFree;
+        m_CanModify = canModify;
+        m_Allocator = buffer.m_Allocator;
+        //Owning another buffers inline storage is not possible so we own a copy of it instead
+        if(canFree)TakeInline(buffer);
+        //Shared data is only ever owned through a reference
+        if(buffer.m_Shared){
+            m_CanFree = false;
+            m_CanModify = false;
+            ShareWith(buffer);
+        }
+    }
+
+    /// @brief We will append the "foods" data to our buffer and the foods data will get released
+    void Consume(const HBuffer& food) HBUFF_NOEXCEPT{
+        Append(food);
+    }
+    /// @brief appends other buffers data ontop of current buffer and jumps to from. for example Consume(2, "Hello") if buffer is currently empty then new buffer will be "ello", else it will be buff1 + buff2 with the buffer starting at byte 2
+    /// @param from how much bytes to consume. then filled with remaining of current buffer then appends the food
+    void Consume(size_t from, HBuffer& food) HBUFF_NOEXCEPT{
+        ///TODO: might sometime work
+        //Part1 size - 30
+        //Part2 size - 50
+        //Total size - 80
+        //Part1 Change - 0
+        //From - 29
+        //Desired new size - 80
+        size_t otherSize = food.m_Size;
+        size_t totalSize = m_Size + otherSize;
+        from = std::min(totalSize, from);
+        
+        size_t newLen1 = m_Size - std::min(from, m_Size);
+        size_t newLen2 = otherSize - (from >= m_Size ? std::min(otherSize, from - m_Size) : 0);
+        size_t newSize = newLen1 + newLen2;
+        size_t foodOffset = from - std::min(m_Size, from);
+
+        if(newSize > m_Capacity || !m_CanModify || !m_Data){
+            HBuffer buffer(m_Allocator);
+            buffer.Reserve(newSize);
+            if(newLen1 > 0)memcpy(buffer.m_Data, m_Data + from, newLen1);
+            Swap(buffer);
+        }else if(newLen1 > 0){
+            memmove(m_Data, m_Data + from, newLen1);
+        }
+        if(newLen2 > 0)memcpy(m_Data + newLen1, food.m_Data + foodOffset, newLen2);
+        m_Size = newSize;
+    }
+
+    void InsertAt(size_t at, const HBuffer& buffer) noexcept{
+        size_t otherSize = buffer.GetSize();
+        size_t minimumSize = at + otherSize;
+        if(minimumSize > m_Capacity || !m_CanModify || !m_Data){
+            Grow(minimumSize);
+        }
+
+        memcpy(m_Data + at, buffer.GetData(), otherSize);
+    }
+    /// @brief Inserts a null terminated string
+    /// @param at the place inside the buffer to insert the string into
+    /// @param str the string to copy characters from
+    /// @param characters the amount of actual characters excluding the null terminator
+    void InsertAt(size_t at, const char* str, size_t characters) noexcept{
+        size_t minimumSize = at + characters + 1;
+        if(minimumSize > m_Capacity || !m_CanModify || !m_Data){
+            Grow(minimumSize);
+        }
+
+        memcpy(m_Data + at, str, characters);
+        memset(m_Data + at + characters, 0, 1);
+    }
+    /// @brief Inserts c into the buffer at param at.
+    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
+    /// @param c the byte to insert at c
+    void InsertInt8At(size_t at, int8_t c)HBUFF_NOEXCEPT{
+        size_t minimumSize = at + 1;
+        if(minimumSize >= m_Capacity || !m_CanModify || !m_Data){
+            Grow(minimumSize);
+        }
+
+        0[m_Data + at] = c;
+    }
+
+    /// @brief Inserts c into the buffer at param at.
+    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
+    /// @param c the byte to insert at c
+    void InsertInt16At(size_t at, int16_t c)HBUFF_NOEXCEPT{
+        if(at + 2 >= m_Capacity || !m_CanModify || !m_Data){
+            Grow(at + 2);
+        }
+
+        HBufferBinary::Store(m_Data + at, c);
+    }
+
+    /// @brief Inserts c into the buffer at param at.
+    /// @param at the position to insert the char at. If we cant access the buffer or at >= m_Capacity we reallocate and the new buffers size is at + 1.
+    /// @param c the byte to insert at c
+    void InsertInt32At(size_t at, int32_t c)HBUFF_NOEXCEPT{
+        if(at + 4 >= m_Capacity || !m_CanModify || !m_Data){
+            Grow(at + 4);
+        }
+
+        HBufferBinary::Store(m_Data + at, c);
+    }
+
+    void AppendUInt16(uint16_t value) HBUFF_NOEXCEPT{
+        AppendBinary(value);
+    }
+    void AppendUInt32(uint32_t value) HBUFF_NOEXCEPT{
+        AppendBinary(value);
+    }
+    void AppendUInt64(uint64_t value) HBUFF_NOEXCEPT{
+        AppendBinary(value);
+    }
+    /// @brief appends param value as sizeof(T) bytes in param endian order with a single store
+    template<typename T>
+    void AppendBinary(T value, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT{
+        HBufferBinary::Store(Extend(sizeof(T)), value, endian);
+    }
+
+    /// @brief reads a T stored in param endian order at param at straight out of the buffer
+    /// @return returns false if the buffer does not have sizeof(T) bytes at param at
+    template<typename T>
+    bool Extract(size_t at, T* dst, HBufferEndian endian = HBufferEndian::Default)const HBUFF_NOEXCEPT{
+        if(at > m_Size || m_Size - at < sizeof(T))return false;
+        *dst = HBufferBinary::Load<T>(m_Data + at, endian);
+        return true;
+    }
+    bool ExtractInt8(size_t at, int8_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractUInt8(size_t at, uint8_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractInt16(size_t at, int16_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractUInt16(size_t at, uint16_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractInt32(size_t at, int32_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractUInt32(size_t at, uint32_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    bool ExtractUInt64(size_t at, uint64_t* dst)const HBUFF_NOEXCEPT{
+        return Extract(at, dst);
+    }
+    void Append(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        size_t otherSize = buffer.m_Size;
+        size_t newSize = m_Size + otherSize;
+        
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+
+        memcpy(m_Data + m_Size, buffer.GetData(), otherSize);
+        m_Size = newSize;
+    }
+
+    void Append(const char* str) HBUFF_NOEXCEPT{
+        size_t strLen = strlen(str);
+        size_t newSize = m_Size + strLen;
+
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+
+        memcpy(m_Data + m_Size, str, strLen);
+        m_Size = newSize;
+    }
+    void Append(const char* str, size_t strLen) HBUFF_NOEXCEPT{
+        size_t newSize = m_Size + strLen;
+
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+
+        memcpy(m_Data + m_Size, str, strLen);
+        m_Size = newSize;
+    }
+
+    void Append(char c) HBUFF_NOEXCEPT{
+        size_t newSize = m_Size + 1;
+
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+        memset(m_Data + m_Size, c, 1);
+        m_Size = newSize;
+    }
+
+    void Append(const std::string& string){
+        size_t strLen = string.size();
+        size_t newSize = strLen + m_Size;
+
+        if(!m_CanModify || newSize > m_Capacity || !m_Data){
+            Grow(newSize);
+        }
+        memcpy(m_Data + m_Size, string.data(), strLen);
+        m_Size = newSize;
+    }
+
+    void AppendString(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        size_t otherSize = buffer.m_Size;
+        size_t newSize = m_Size + otherSize;
+        size_t minCapacity = newSize + 1;
+
+        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+
+        memcpy(m_Data + m_Size, buffer.GetData(), otherSize);
+        memset(m_Data + newSize, '\0', 1);
+        m_Size = newSize;
+    }
+
+    /// @brief Appends a const char* with a specific length and makes sure buffer ends with a null terminator.
+    void AppendString(const char* str) HBUFF_NOEXCEPT{
+        size_t strLen = strlen(str);
+        size_t newSize = m_Size + strLen;
+        size_t minCapacity = newSize + 1;
+
+        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+
+        memcpy(m_Data + m_Size, str, strLen);
+        memset(m_Data + newSize, '\0', 1);
+        m_Size = newSize;
+    }
+
+    /// @brief Appends a const char* with a specific length and makes sure buffer ends with a null terminator.
+    void AppendString(const char* str, size_t strLen) HBUFF_NOEXCEPT{
+        size_t newSize = m_Size + strLen;
+        size_t minCapacity = newSize + 1;
+
+        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+
+        memcpy(m_Data + m_Size, str, strLen);
+        memset(m_Data + newSize, '\0', 1);
+        m_Size = newSize;
+    }
+    
+    void AppendString(const std::string& string){
+        size_t strLen = string.size();
+        size_t newSize = strLen + m_Size;
+        size_t minCapacity = newSize + 1;
+
+        if(!m_CanModify || minCapacity > m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+        memcpy(m_Data + m_Size, string.data(), strLen);
+        m_Size = newSize;
+    }
+    /// @brief Appends a single character to the buffer and also makes sure there is a null terminator
+    void AppendString(char c) HBUFF_NOEXCEPT{
+        size_t newSize = m_Size + 1;
+        size_t minCapacity = newSize + 1;
+
+        if(!m_CanModify || minCapacity> m_Capacity || !m_Data){
+            Grow(minCapacity);
+        }
+        memset(m_Data + m_Size, c, 1);
+        memset(m_Data + newSize, '\0', 1);
+        m_Size = newSize;
+    }
+
+    /// @brief allocates a substring of buffer starting at param at with a length of len.
+    /// @param at the location in the buffer that will start filling up the substring
+    /// @param len the amount of characters to copy to new buffer. If -1 than whole buffer else caps out on buffer
+    HBuffer SubString(size_t at, size_t len) const HBUFF_NOEXCEPT{
+        if(at >= m_Size)return HBuffer();
+        size_t size = std::min(len, m_Size - at);
+
+        HBuffer buffer(m_Allocator);
+        buffer.Reserve(size + 1);
+        buffer.m_Data[size] = 0;
+        memcpy(buffer.m_Data, m_Data + at, size);
+        buffer.m_Size = size;
+        return buffer;
+    }
+
+    /// @brief Allocates a new copy of the buffer up to the size of the buffer
+    HBuffer GetCopy() const HBUFF_NOEXCEPT{
+        return CreateCopy();
+    }
+
+    /// @brief Allocates a copy of the buffer with a null terminator
+    HBuffer GetCopyString() const HBUFF_NOEXCEPT{
+        HBuffer buff;
+        buff.ReserveString(m_Size);
+        buff.Copy(*this);
+        return buff;
+    }
+
+    /// @brief Create a new HBuffer that points to the same data as the current one but with an offset and or different size
+    /// @param allowModify a check to allow this subpointer to modify data as long as the main buffer also can modify this data
+    HBuffer SubPointer(size_t at, size_t len=-1, bool allowModify = true) const HBUFF_NOEXCEPT{
+        if(at >= m_Size)return HBuffer();
+        size_t size = std::min(len, m_Size - at);
+        HBuffer buffer(m_Data + at, size, m_Capacity - at, false, allowModify && m_CanModify);
+        buffer.ShareWith(*this);
+        return buffer;
+    }
+
+    /// @brief sam as substring without null terminator. allocates a subbuffer of buffer starting at param at with a length of len.
+    /// @param at the location in the buffer that will start filling up the substring
+    /// @param len the amount of characters to copy to new buffer. If -1 than whole buffer. Caps out on buffer size
+    HBuffer SubBuffer(size_t at, size_t len) const HBUFF_NOEXCEPT{
+        HBuffer buffer(m_Allocator);
+        //TODO: make sure at isnt greater than buffer size
+        size_t size = std::min(m_Size - at, len);
+        buffer.Reserve(size);
+        if(size > 0)memcpy(buffer.m_Data, m_Data + at, size);
+        buffer.m_Size = size;
+        return buffer;
+    }
+    /// @brief swaps the contents of self with param buff
+    /// @param buff
+    void Swap(HBuffer& buff) HBUFF_NOEXCEPT{
+    #if HBUFF_SMALL_BUFFER_SIZE > 0
+        if(IsInline() || buff.IsInline()){
+            //Inline data has to be copied across so let the moves handle it
+            HBuffer temp(std::move(buff));
+            buff = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
+    #endif
+        char* data = buff.m_Data;
+        size_t capacity = buff.m_Capacity;
+        size_t size = buff.m_Size;
+        bool canFree = buff.m_CanFree;
+        bool canModify = buff.m_CanModify;
+        HBufferAllocator* allocator = buff.m_Allocator;
+        HBufferSharedBlock* shared = buff.m_Shared;
+
+        buff.m_Data = m_Data;
+        buff.m_Size = m_Size;
+        buff.m_Capacity = m_Capacity;
+        buff.m_CanFree = m_CanFree;
+        buff.m_CanModify = m_CanModify;
+        buff.m_Allocator = m_Allocator;
+        buff.m_Shared = m_Shared;
+
+        m_Data = data;
+        m_Capacity = capacity;
+        m_Size = size;
+        m_CanFree = canFree;
+        m_CanModify = canModify;
+        m_Allocator = allocator;
+        m_Shared = shared;
+    }
+
+    /// @brief makes data point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or strlen > capacity.
+    /// @param str the null ternimated string literal we are copying
+    void Copy(const char* str)HBUFF_NOEXCEPT{
+        m_Size = strlen(str);
+        if(m_Size < 1){
+            //copy of nothing
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size > m_Capacity)Reallocate(m_Size, 0);
+
+        memcpy(m_Data, const_cast<char*>(str), m_Size);
+    }
+    /// @brief makes data at param at point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or strlen > capacity.
+    /// @param at the position in the buffer to copy the data to. Will reallocate if at is greater than capacity
+    /// @param str the null ternimated string literal we are copying
+    void Copy(size_t at, const char* str)HBUFF_NOEXCEPT{
+        size_t strLen = strlen(str);
+        size_t minimumSize = at + strLen;
+        if(minimumSize > m_Capacity || !m_CanModify || !m_Data)Grow(minimumSize);
+
+        memcpy(m_Data + at, const_cast<char*>(str), strLen);
+        m_Size = minimumSize > m_Size ? minimumSize : m_Size;
+    }
+    /// @brief makes data at param at point to a copy of the null terminated string literal. Frees and reallocates if no data, cant modify, or len > capacity.
+    /// @param at the position in the buffer to copy the data to. Will reallocate if at is greater than capacity
+    /// @param str the null ternimated string literal we are copying
+    void Copy(size_t at, char* str, size_t len)HBUFF_NOEXCEPT{
+        size_t minimumSize = at + len;
+        if(minimumSize > m_Capacity || !m_CanModify || !m_Data)Grow(minimumSize);
+        
+        memcpy(m_Data + at, const_cast<char*>(str), len);
+        m_Size = minimumSize > m_Size ? minimumSize : m_Size;
+    }
+    /// @brief makes buffers data point to the content of the null terminated string.
+    /// @param str the null terminated string literal to copy
+    /// @param size the amount of bytes to copy
+    void Copy(char* str, size_t size)HBUFF_NOEXCEPT{
+        if(size < 1){
+            //copy of nothing
+            Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || size > m_Capacity)Reallocate(size, 0);
+
+        m_Size = size;
+        memcpy(m_Data, const_cast<char*>(str), m_Size);
+    }
+    /// @brief makes the buffers content point to a copy of the contents inside the std::string
+    /// @param string the string to make a copy of
+    void Copy(const std::string& string)HBUFF_NOEXCEPT{
+        m_Size = string.size();
+        if(m_Size < 1){
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size > m_Capacity)Reallocate(m_Size, 0);
+        //We have access to a valid memory range to copy to
+        memcpy(m_Data, const_cast<char*>(string.c_str()), m_Size);
+    }
+    /// @brief Makes an exact owning copy of param buff. Frees and reallocates if no self has no valid data ptr, cant modify self, or self size > capacity.
+    /// @param buff the HBuffer to make a copy of
+    void Copy(const HBuffer& buff)HBUFF_NOEXCEPT{
+        size_t newSize = buff.m_Size;
+        if(newSize > 0 && (!m_Data || !m_CanModify || newSize > m_Capacity))Reallocate(newSize, 0);
+        //Copy data into buff
+        m_Size = newSize;
+        if(m_Size > 0)memcpy(m_Data, buff.m_Data, m_Size);
+    }
+
+    ///@brief The exact same as Copy(const char*) except we add a null terminator at the end to our buffer without including the null terminator in size/capacity. This essentially makes the buffer a string
+    void CopyString(const char* str)HBUFF_NOEXCEPT{
+        m_Size = strlen(str);
+        if(m_Size < 1){
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size >= m_Capacity)Reallocate(m_Size + 1, 0);
+
+        memcpy(m_Data, str, m_Size + 1);
+    }
+    ///@brief The exact same as Copy(char*, size_t) except we add a null terminator at the end to our buffer without including the null terminator in size/capacity. This essentially makes the buffer a string
+    /// @param characters the amount of characters to copy into the buffer. Does not include the null terminator
+    void CopyString(char* str, size_t characters)HBUFF_NOEXCEPT{
+        m_Size = characters;
+        if(m_Size < 1){
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size >= m_Capacity)Reallocate(m_Size + 1, 0);
+
+        memcpy(m_Data, str, m_Size);
+        m_Data[m_Size] = '\0';
+    }
+    void CopyString(const std::string& string) HBUFF_NOEXCEPT{
+        m_Size = string.size();
+        if(m_Size < 1){
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size >= m_Capacity)Reallocate(m_Size + 1, 0);
+
+        memcpy(m_Data, string.c_str(), m_Size);
+        m_Data[m_Size] = '\0';
+    }
+    void CopyString(const HBuffer& buff) HBUFF_NOEXCEPT{
+        m_Size = buff.m_Size;
+        if(m_Size < 1){
+            //Free();
+            return;
+        }
+        if(!m_Data || !m_CanModify || m_Size >= m_Capacity)Reallocate(m_Size + 1, 0);
+
+        memcpy(m_Data, buff.m_Data, m_Size);
+        m_Data[m_Size] = '\0';
+    }
+public:
+    /// @brief Splits the buffer into multiple sub pointers with a delimiter. HBufferSplitter does the same lazily without allocating the vector
+    /// @param max the max amount of times to split by delimiter
+    template<typename Allocator=std::allocator<HBuffer>>
+    std::vector<HBuffer, Allocator> SubPointerSplitByDelimiter(char delim, size_t max=-1)const HBUFF_NOEXCEPT{
+        std::vector<HBuffer, Allocator> parts;
+        size_t lastAt = 0;
+        while(lastAt < m_Size){
+            size_t i = Find(delim, lastAt);
+            if(i == HBUFF_NPOS)break;
+            parts.emplace_back(SubPointer(lastAt, i - lastAt));
+            lastAt = i +1;
+            max--;
+            if(max==0){
+                break;
+            }
+        }
+        if(lastAt < m_Size)parts.emplace_back(SubPointer(lastAt, -1));
+        return parts;
+    }
+#pragma region Search
+    /// @brief finds the first param c at or after param from
+    /// @return returns the index of the byte or HBUFF_NPOS if not found
+    size_t Find(char c, size_t from = 0) const HBUFF_NOEXCEPT{
+        if(from >= m_Size)return HBUFF_NPOS;
+        size_t found = HBufferSimd::FindByte(m_Data + from, m_Size - from, c);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : from + found;
+    }
+    /// @brief finds the first occurrence of param str at or after param from
+    /// @param len the amount of bytes in str
+    /// @return returns the index the match starts at or HBUFF_NPOS if not found
+    size_t Find(const char* str, size_t len, size_t from = 0) const HBUFF_NOEXCEPT{
+        if(from > m_Size)return HBUFF_NPOS;
+        size_t found = HBufferSimd::Find(m_Data + from, m_Size - from, str, len);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : from + found;
+    }
+    /// @brief finds the first occurrence of the null terminated param str
+    size_t Find(const char* str) const HBUFF_NOEXCEPT{
+        return Find(str, strlen(str));
+    }
+    /// @brief finds the first occurrence of the contents of param buffer at or after param from
+    size_t Find(const HBuffer& buffer, size_t from = 0) const HBUFF_NOEXCEPT{
+        return Find(buffer.m_Data, buffer.m_Size, from);
+    }
+    /// @brief finds the last param c before param before
+    /// @return returns the index of the byte or HBUFF_NPOS if not found
+    size_t FindLast(char c, size_t before = -1) const HBUFF_NOEXCEPT{
+        return HBufferSimd::FindLastByte(m_Data, std::min(before, m_Size), c);
+    }
+    /// @brief finds the last occurrence of param str that ends before param before
+    /// @return returns the index the match starts at or HBUFF_NPOS if not found
+    size_t FindLast(const char* str, size_t len, size_t before = -1) const HBUFF_NOEXCEPT{
+        return HBufferSimd::FindLast(m_Data, std::min(before, m_Size), str, len);
+    }
+    /// @brief finds the last occurrence of the null terminated param str
+    size_t FindLast(const char* str) const HBUFF_NOEXCEPT{
+        return FindLast(str, strlen(str));
+    }
+    /// @brief finds the first byte at or after param from that is any of the bytes in param set
+    /// @param setLen the amount of bytes in set
+    /// @return returns the index of the byte or HBUFF_NPOS if not found
+    size_t FindFirstOf(const char* set, size_t setLen, size_t from = 0) const HBUFF_NOEXCEPT{
+        if(from >= m_Size)return HBUFF_NPOS;
+        size_t found = HBufferSimd::FindAnyOf(m_Data + from, m_Size - from, set, setLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : from + found;
+    }
+    /// @brief finds the first byte that is any of the bytes in the null terminated param set
+    size_t FindFirstOf(const char* set) const HBUFF_NOEXCEPT{
+        return FindFirstOf(set, strlen(set));
+    }
+    /// @brief returns if the buffer contains param str anywhere
+    bool Contains(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return Find(str, len) != HBUFF_NPOS;
+    }
+    /// @brief returns if the buffer contains param c anywhere
+    bool Contains(char c) const HBUFF_NOEXCEPT{
+        return Find(c) != HBUFF_NPOS;
+    }
+#pragma endregion
+#pragma region Case
+    /// @brief lower cases every ASCII letter in the buffer. Copies the data first if we can not modify it
+    void ToLower() HBUFF_NOEXCEPT{
+        if(m_Size < 1)return;
+        Detach();
+        HBufferSimd::ToLower(m_Data, m_Data, m_Size);
+    }
+    /// @brief upper cases every ASCII letter in the buffer. Copies the data first if we can not modify it
+    void ToUpper() HBUFF_NOEXCEPT{
+        if(m_Size < 1)return;
+        Detach();
+        HBufferSimd::ToUpper(m_Data, m_Data, m_Size);
+    }
+    /// @brief Creates a null terminated copy of the buffer with every ASCII letter lower cased
+    HBuffer CreateLowercaseCopy() const HBUFF_NOEXCEPT{
+        HBuffer buffer(m_Allocator);
+        buffer.ReserveString(m_Size);
+        HBufferSimd::ToLower(buffer.m_Data, m_Data, m_Size);
+        buffer.m_Size = m_Size;
+        return buffer;
+    }
+    /// @brief Creates a null terminated copy of the buffer with every ASCII letter upper cased
+    HBuffer CreateUppercaseCopy() const HBUFF_NOEXCEPT{
+        HBuffer buffer(m_Allocator);
+        buffer.ReserveString(m_Size);
+        HBufferSimd::ToUpper(buffer.m_Data, m_Data, m_Size);
+        buffer.m_Size = m_Size;
+        return buffer;
+    }
+    /// @brief returns if the buffer holds the same bytes as param str when ASCII case is ignored
+    bool EqualsIgnoreCase(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return m_Size == len && HBufferSimd::EqualsIgnoreCase(m_Data, str, len);
+    }
+    bool EqualsIgnoreCase(const char* str) const HBUFF_NOEXCEPT{
+        return EqualsIgnoreCase(str, strlen(str));
+    }
+    bool EqualsIgnoreCase(const HBuffer& buffer) const HBUFF_NOEXCEPT{
+        return EqualsIgnoreCase(buffer.m_Data, buffer.m_Size);
+    }
+    /// @brief returns if the buffer starts with param str when ASCII case is ignored
+    bool StartsWithIgnoreCase(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return m_Size >= len && HBufferSimd::EqualsIgnoreCase(m_Data, str, len);
+    }
+    bool StartsWithIgnoreCase(const char* str) const HBUFF_NOEXCEPT{
+        return StartsWithIgnoreCase(str, strlen(str));
+    }
+    bool StartsWithIgnoreCase(const HBuffer& buffer) const HBUFF_NOEXCEPT{
+        return StartsWithIgnoreCase(buffer.m_Data, buffer.m_Size);
+    }
+    /// @brief finds the first occurrence of param str at or after param from ignoring ASCII case
+    /// @return returns the index the match starts at or HBUFF_NPOS if not found
+    size_t FindIgnoreCase(const char* str, size_t len, size_t from = 0) const HBUFF_NOEXCEPT{
+        if(from > m_Size)return HBUFF_NPOS;
+        size_t found = HBufferSimd::FindIgnoreCase(m_Data + from, m_Size - from, str, len);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : from + found;
+    }
+    size_t FindIgnoreCase(const char* str) const HBUFF_NOEXCEPT{
+        return FindIgnoreCase(str, strlen(str));
+    }
+    size_t FindIgnoreCase(const HBuffer& buffer, size_t from = 0) const HBUFF_NOEXCEPT{
+        return FindIgnoreCase(buffer.m_Data, buffer.m_Size, from);
+    }
+#pragma endregion
+
+#pragma region Compare
+    /// @brief returns if the buffer holds param str starting at param at
+    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
+        if(at > m_Size || m_Size - at < len)return false;
+        return HBufferSimd::Equals(m_Data + at, str, len);
+    }
+    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{
+        return StartsWith(at, str, strlen(str));
+    }
+    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return StartsWith(0, str, len);
+    }
+    bool StartsWith(const char* str) const HBUFF_NOEXCEPT{
+        return StartsWith(0, str, strlen(str));
+    }
+
+    /// @brief Checks if the buffer ends with a certain string excluding the null terminator.
+    /// @return returns if the buffer ends with the c string. Returns true in anycase where the string has 0 bytes
+    bool EndsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        if(len > m_Size)return false;
+        return HBufferSimd::Equals(m_Data + m_Size - len, str, len);
+    }
+    
+    /// @brief Checks if the buffer ends with a certain string excluding the null terminator.
+    /// @return returns if the buffer ends with the c string. Returns true in anycase where the string has 0 bytes
+    bool EndsWith(const char* str) const HBUFF_NOEXCEPT{
+        return EndsWith(str, strlen(str));
+    }
+
+    //TODO: POssible rename
+    /// @return returns 0 if the buffer starts with the null terminated param str, -1 if the buffer runs out of data first and 1 if data doesnt match
+    int StrXCmp(const char* str) const HBUFF_NOEXCEPT{
+        size_t len = strlen(str);
+        if(len <= m_Size)return HBufferSimd::Equals(m_Data, str, len) ? 0 : 1;
+        return HBufferSimd::Equals(m_Data, str, m_Size) ? -1 : 1;
+    }
+
+    /// @brief orders the buffer against param str byte by byte as unsigned values. A buffer that is a prefix of the other orders first
+    /// @return returns < 0 if the buffer orders before str, 0 if they match and > 0 if it orders after
+    int Compare(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        size_t common = std::min(m_Size, len);
+        int result = common > 0 ? memcmp(m_Data, str, common) : 0;
+        if(result != 0)return result;
+        return m_Size < len ? -1 : (m_Size > len ? 1 : 0);
+    }
+    int Compare(const char* str) const HBUFF_NOEXCEPT{
+        return Compare(str, strlen(str));
+    }
+    int Compare(const HBuffer& buffer) const HBUFF_NOEXCEPT{
+        return Compare(buffer.m_Data, buffer.m_Size);
+    }
+    /// @brief returns if the buffer holds exactly param len bytes matching param str. Checks the size before touching any data
+    bool Equals(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return m_Size == len && HBufferSimd::Equals(m_Data, str, len);
+    }
+#pragma endregion
+
+    /// @brief fills the buffer with param len copies of param byte and sets the size to param len. Copies first if we can not modify the data
+    void Memset(char byte, size_t len) HBUFF_NOEXCEPT{
+        if(len < 1){
+            m_Size = 0;
+            return;
+        }
+        if(!m_Data || !m_CanModify || len > m_Capacity)Reallocate(len, 0);
+        memset(m_Data, byte, len);
+        m_Size = len;
+    }
+    /// @brief Copies param len bytes of param src over the start of the buffer. Copies first if we can not modify the data
+    void Memcpy(const void* src, size_t len) HBUFF_NOEXCEPT{
+        if(len < 1)return;
+        if(!m_Data || !m_CanModify || len > m_Capacity)Reallocate(std::max(len, m_Size), m_Size);
+        memcpy(m_Data, src, len);
+    }
+    /// @brief Copies param len bytes of param src starting at param at over the start of the buffer. Copies first if we can not modify the data
+    void Memcpy(const void* src, size_t at, size_t len) HBUFF_NOEXCEPT{
+        Memcpy(static_cast<const char*>(src) + at, len);
+    }
+
+    /// @brief Reverses the data inside the array from 0-m_Size. Turns data at 0 into data at m_Size and data at m_Size into data at 0
+    void Reverse() HBUFF_NOEXCEPT{
+        if(m_Size < 2)return;
+        Detach();
+        for(size_t i = 0; i < m_Size / 2; i++){
+            size_t reverseIndex = m_Size - 1 - i;
+            char temp = m_Data[i];
+            m_Data[i] = m_Data[reverseIndex];
+            m_Data[reverseIndex] = temp;
+        }
+    }
+
+    /// @brief makes sure the string ends with a null terminator. Reallocates buffer if necessary
+    void MakeSafeString() HBUFF_NOEXCEPT{
+        if(m_Capacity > 0 && m_Data[m_Size] == '\0')
+            return;
+        if(!m_Data || !m_CanModify || m_Size >= m_Capacity)Reallocate(m_Size + 1, m_Size);
+        m_Data[m_Size] = '\0';
+    }
+    HBuffer GetSafeString() const HBUFF_NOEXCEPT{
+        HBuffer buff;
+        buff.AppendString(*this);
+        return buff;
+    }
+
+    /// @brief Allocates a new c string on the heap with the data of the buffer followed by null terminator without modifying the current buffer.
+    /// @return if current buffer is not a c string or is too small to be one we allocate new data and return a new buffer. Else we return a view of the current one.
+    HBuffer GetSafeCString() const HBUFF_NOEXCEPT{
+        if(m_Capacity < 1 || m_Capacity <= m_Size || m_Data[m_Size] != '\00'){
+            HBuffer buffer(m_Allocator);
+            buffer.ReserveString(m_Size);
+            if(m_Size > 0)memcpy(buffer.m_Data, m_Data, m_Size);
+            buffer.m_Data[m_Size] = '\00';
+            buffer.m_Size = m_Size;
+            return buffer;
+        }
+        return *this;
+    }
+    
+    /// @brief Makes sure there is a null terminator at the end of the buffer and returns the buffers data. Might of just made this for nothing
+    const char* TurnToSafeCString() HBUFF_NOEXCEPT{
+        if(m_Data && m_Capacity > m_Size && m_Data[m_Size] == '\0')return m_Data;
+        if(!m_Data || !m_CanModify || m_Capacity <= m_Size)Reallocate(m_Size + 1, m_Size);
+
+        memset(m_Data + m_Size, '\0', 1);
+        return m_Data;
+    }
+public:
+    /// @brief if the data is not a null pointer then trust it else we return a basic static memory pointer to a null terminator
+    const char* GetCStr() const HBUFF_NOEXCEPT{return m_Data ? m_Data : "";}
+    /// @brief returns if the buffer owns the data
+    HBUFF_CONSTEXPR bool CanFree() const HBUFF_NOEXCEPT{return m_CanFree;}
+    /// @brief returns if the buffer may modify the data
+    HBUFF_CONSTEXPR bool CanModify() const HBUFF_NOEXCEPT{return m_CanModify;}
+    /// @brief returns the pointer to the data the buffer is using
+    HBUFF_CONSTEXPR char* GetData() const HBUFF_NOEXCEPT{return m_Data;}
+    /// @brief returns the size of the buffer
+    HBUFF_CONSTEXPR size_t GetSize() const HBUFF_NOEXCEPT{return m_Size;}
+    /// @brief returns the capacity of the buffer
+    HBUFF_CONSTEXPR size_t GetCapacity() const HBUFF_NOEXCEPT{return m_Capacity;}
+public:
+    /// @brief returns a reference to the byte at param at. Never copies, so writing through it on shared data changes every buffer sharing it. Use GetWritable to write
+    char& operator[](size_t at) HBUFF_NOEXCEPT{
+        return m_Data[at];
+    }
+    const char& operator[](size_t at) const HBUFF_NOEXCEPT{
+        return m_Data[at];
+    }
+    /// @brief returns a reference to the byte at param at that is safe to write through. Detaches first if the data is shared or can not be modified
+    char& GetWritable(size_t at) HBUFF_NOEXCEPT{
+        Detach();
+        return m_Data[at];
+    }
+    /// @brief Assigns the current buffers content as a copy of param right's data
+    HBuffer& operator=(const HBuffer& right) HBUFF_NOEXCEPT{
+        if(this == &right)return *this;
+        Free();
+        m_Data = right.m_Data;
+        m_Size = right.m_Size;
+        m_Capacity = right.m_Capacity;
+        m_CanModify = right.m_CanModify;
+        m_CanFree = false;
+        m_Allocator = right.m_Allocator;
+        ShareWith(right);
+        HBufferTrace::Record(HBufferTraceEvent::Copy, m_Size);
+        return *this;
+    }
+    
+    /// @brief Frees current data if possible and basically does a move constructor with param right
+    HBuffer& operator=(HBuffer&& right) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = right.m_Data;
+        m_Size = right.m_Size;
+        m_Capacity = right.m_Capacity;
+        m_CanFree = right.m_CanFree;
+        m_CanModify = right.m_CanModify;
+        m_Allocator = right.m_Allocator;
+        m_Shared = right.m_Shared;
+        TakeInline(right);
+        right.Release();
+        return *this;
+    }
+    /// @brief assigns buffer to a non owning string literal
+    HBuffer& operator=(const char* right) HBUFF_NOEXCEPT{
+        Free();
+        m_Data = const_cast<char*>(right);
+        m_Size = strlen(right);
+        m_Capacity = m_Size + 1;
+        m_CanFree = false;
+        m_CanModify = false;
+        return *this;
+    }
+
+    friend HBuffer operator+(const char* left, const HBuffer& right) HBUFF_NOEXCEPT{
+        size_t strLen = strlen(left);
+        if(strLen + right.m_Size < 1)return HBuffer();
+        HBuffer buffer;
+        size_t newSize = strLen + right.m_Size;
+        buffer.Reserve(newSize + 1);
+        buffer.SetSize(newSize);
+        char* data = buffer.GetData();
+        memcpy(data, left, strLen);
+        memcpy(data + strLen, right.m_Data, right.m_Size);
+        memset(data + newSize, '\0', 1);
+        return buffer;
+    }
+    /// @brief appends data as ascii strings
+    HBuffer& operator+=(const char* right) HBUFF_NOEXCEPT{
+        AppendString(right);
+        return *this;
+    }
+    
+    /// @brief appends data as ascii strings
+    HBuffer& operator+=(const HBuffer& right) HBUFF_NOEXCEPT{
+        AppendString(right);
+        return *this;
+    }
+    
+    /// @brief compares if the data inside the buffer matches and not the places in memory.
+    bool operator==(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return Equals(right.m_Data, right.m_Size);
+    }
+    /// @brief compares if the data inside the buffers are strings and match
+    bool operator==(const char* str)const HBUFF_NOEXCEPT{
+        return Equals(str, strlen(str));
+    }
+    /// @brief compares if the data inside the buffers are strings and match
+    HBUFF_CONSTEXPR bool operator==(char c)const HBUFF_NOEXCEPT{
+        if(m_Size != 1)return false;
+        return m_Data[0] == c;
+    }
+    /// @brief returns if the contents are not equal
+    bool operator!=(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return !Equals(right.m_Data, right.m_Size);
+    }
+    /// @brief returns if the contents are not equal
+    bool operator!=(const char* str)const HBUFF_NOEXCEPT{
+        return !Equals(str, strlen(str));
+    }
+    /// @brief returns if the contents are not equal. If one of the buffers does not have data returns false; else returns if contents match.
+    HBUFF_CONSTEXPR bool operator!=(char c)const HBUFF_NOEXCEPT{
+        if(m_Size != 1)return true;
+        return m_Data[0] != c;
+    }
+    /// @brief orders buffers by content the same way Compare does so HBuffer can key std::map and sorted arrays
+    bool operator<(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return Compare(right) < 0;
+    }
+    bool operator<=(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return Compare(right) <= 0;
+    }
+    bool operator>(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return Compare(right) > 0;
+    }
+    bool operator>=(const HBuffer& right)const HBUFF_NOEXCEPT{
+        return Compare(right) >= 0;
+    }
+    std::ostream& operator<<(std::ostream& os) {
+        for(size_t i = 0; i < m_Size; i++)os << m_Data[i];
+        return os;
+    }
+    operator bool() const HBUFF_NOEXCEPT{
+        return m_Data != nullptr;
+    }
+public:
+    /// @brief returns the allocator the buffer gets its memory from. nullptr means the thread default allocator or the heap
+    HBUFF_CONSTEXPR HBufferAllocator* GetAllocator() const HBUFF_NOEXCEPT{return m_Allocator;}
+    /// @brief returns if the data lives inside the buffer object itself. Always false unless HBUFF_SMALL_BUFFER_SIZE > 0
+    bool IsInline() const HBUFF_NOEXCEPT{
+    #if HBUFF_SMALL_BUFFER_SIZE > 0
+        return m_Data == m_Inline;
+    #else
+        return false;
+    #endif
+    }
+    /// @brief returns if the data is shared through a reference counted block. Copies and sub pointers of a shared buffer keep the data alive
+    HBUFF_CONSTEXPR bool IsShared() const HBUFF_NOEXCEPT{return m_Shared != nullptr;}
+    /// @brief returns if no other buffer can see our data through a reference. Always true for data that is not shared.
+    /// @brief Plain views made with the copy constructor of a non shared buffer are not tracked
+    bool IsUnique() const HBUFF_NOEXCEPT{
+        return !m_Shared || m_Shared->m_References.load(std::memory_order_acquire) == 1;
+    }
+    /// @brief makes sure the next mutation writes into memory no other buffer can see. Copies the data unless it is already ours or we hold the last reference to it.
+    /// @brief Shared data that is not writable, like a read only mapping, is always copied
+    void Detach() HBUFF_NOEXCEPT{
+        if(!m_Data || m_CanModify)return;
+        if(CanWriteShared(m_Size))return;
+        Reallocate(m_Size + 1, m_Size);
+        m_Data[m_Size] = '\0';
+    }
+    /// @brief returns how many buffers hold a reference to the shared data or 0 if it is not shared
+    size_t GetReferenceCount() const HBUFF_NOEXCEPT{
+        return m_Shared ? m_Shared->m_References.load(std::memory_order_acquire) : 0;
+    }
+public:
+    /// @brief moves the data into a reference counted block. From then on copies and sub pointers share the data without copying it, on any thread.
+    /// @brief Shared data is copy on write. The first mutation through any of the buffers sharing it gives just that buffer its own copy. See HBUFF_COW_UNIQUE_CHECK
+    /// @brief The block comes from the buffer's allocator or the thread default only if it is thread safe and from the heap otherwise, since the last reference can let go on any thread
+    void MakeShared() HBUFF_NOEXCEPT{
+        if(m_Shared)return;
+        HBufferSharedBlock* block = AllocateSharedBlock(m_Size + 1);
+        char* data = block->GetData();
+        if(m_Size > 0)memcpy(data, m_Data, m_Size);
+        data[m_Size] = '\0';
+        ReleaseData(m_Allocator);
+        m_Data = data;
+        m_Capacity = block->GetCapacity();
+        m_CanFree = false;
+        m_CanModify = false;
+        m_Shared = block;
+    }
+    /// @brief creates a shared buffer holding a null terminated copy of param len bytes of param data
+    /// @param allocator where the block comes from if it is thread safe. nullptr uses the thread default allocator if it is thread safe or the heap
+    static HBuffer CreateShared(const char* data, size_t len, HBufferAllocator* allocator = nullptr) HBUFF_NOEXCEPT{
+        HBuffer buffer(data, len, false, false);
+        buffer.m_Allocator = allocator;
+        buffer.MakeShared();
+        return buffer;
+    }
+    /// @brief takes ownership of param size bytes at param data without copying them. The last buffer sharing them calls param release.
+    /// @brief Works for any memory: a network library's receive buffer, an arena, memory from another allocator. Copies and sub pointers share it like CreateShared
+    /// @param context handed to param release as is
+    /// @param writable if the last reference may write into the data instead of copying it first
+    /// @param allocator where the small reference counted header comes from if it is thread safe. nullptr uses the thread default allocator if it is thread safe or the heap
+    static HBuffer Adopt(char* data, size_t size, HBufferReleaseHook release, void* context = nullptr, bool writable = true, HBufferAllocator* allocator = nullptr) HBUFF_NOEXCEPT{
+        return CreateExternal(data, size, release, context, writable, allocator);
+    }
+    /// @brief takes sole ownership of param data that came from param allocator, which frees it when the buffer is done with it. Nothing is allocated
+    /// @brief For malloc memory pass HBufferMallocAllocator::Get(). nullptr means the data came from new[]
+    /// @param capacity the size that was allocated. Passed back to the allocator's Deallocate
+    static HBuffer Adopt(char* data, size_t size, size_t capacity, HBufferAllocator* allocator) HBUFF_NOEXCEPT{
+        HBuffer buffer(data, size, capacity, true, true);
+        buffer.m_Allocator = allocator;
+        return buffer;
+    }
+#if !defined(_WIN32)
+#pragma region Mapping
+    /// @brief maps the whole file at param path into memory and returns a shared buffer over it. Nothing is read until it is touched.
+    /// @brief The mapping is unmapped once the last buffer sharing it lets go. The data is not null terminated
+    /// @param advice HBUFF_MAP_ADVICE_ flags passed on to madvise
+    /// @return returns an empty buffer if the file can not be opened, mapped or is empty. See errno
+    static HBuffer MapFile(const char* path, HBufferMapMode mode = HBufferMapMode::ReadOnly, uint32_t advice = HBUFF_MAP_ADVICE_NONE) HBUFF_NOEXCEPT{
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if(fd < 0)return HBuffer();
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size <= 0){
+            close(fd);
+            return HBuffer();
+        }
+        size_t size = static_cast<size_t>(info.st_size);
+        bool writable = mode == HBufferMapMode::Private;
+        void* map = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+        //The mapping keeps the file alive on its own
+        close(fd);
+        if(map == MAP_FAILED)return HBuffer();
+        Advise(map, size, advice);
+        return CreateExternal(static_cast<char*>(map), size, &Unmap, nullptr, writable);
+    }
+    /// @brief passes HBUFF_MAP_ADVICE_ flags for the pages under the buffer to madvise. Only useful for mapped buffers
+    /// @return returns false if any hint was rejected
+    bool Advise(uint32_t advice) const HBUFF_NOEXCEPT{
+        return Advise(m_Data, m_Size, advice);
+    }
+#pragma endregion
+#endif
+private:
+#if !defined(_WIN32)
+    static bool Advise(void* data, size_t len, uint32_t advice) HBUFF_NOEXCEPT{
+        if(!data || len < 1)return true;
+        //madvise wants a page aligned start
+        uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~(page - 1);
+        len += reinterpret_cast<uintptr_t>(data) - start;
+        void* at = reinterpret_cast<void*>(start);
+        bool result = true;
+        if(advice & HBUFF_MAP_ADVICE_SEQUENTIAL)result &= madvise(at, len, MADV_SEQUENTIAL) == 0;
+        if(advice & HBUFF_MAP_ADVICE_RANDOM)result &= madvise(at, len, MADV_RANDOM) == 0;
+        if(advice & HBUFF_MAP_ADVICE_WILLNEED)result &= madvise(at, len, MADV_WILLNEED) == 0;
+    #if defined(MADV_HUGEPAGE)
+        if(advice & HBUFF_MAP_ADVICE_HUGEPAGE)result &= madvise(at, len, MADV_HUGEPAGE) == 0;
+    #endif
+        return result;
+    }
+    static void Unmap(char* data, size_t size, void*) HBUFF_NOEXCEPT{
+        munmap(data, size);
+    }
+#endif
+    /// @brief hands the heap data we own to a shared block and drops its first param from bytes. The block gives the whole allocation back through ReleaseOwned without copying it.
+    /// @brief Shared data may be let go on any thread, so data from an allocator that is not thread safe is copied once into a block from the heap instead
+    void ShareOwned(size_t from) HBUFF_NOEXCEPT{
+        if(m_Allocator && !m_Allocator->IsThreadSafe()){
+            size_t size = m_Size - from;
+            HBufferSharedBlock* block = AllocateSharedBlock(size + 1);
+            char* data = block->GetData();
+            memcpy(data, m_Data + from, size);
+            data[size] = '\0';
+            ReleaseData(m_Allocator);
+            m_Data = data;
+            m_Size = size;
+            m_Capacity = block->GetCapacity();
+            m_Shared = block;
+        }
+        else{
+            HBufferExternalBlock* block = static_cast<HBufferExternalBlock*>(AllocateSharedBlock(sizeof(HBufferExternalBlock) - sizeof(HBufferSharedBlock)));
+            block->m_Release = &ReleaseOwned;
+            block->m_External = m_Data;
+            block->m_ExternalSize = m_Capacity;
+            block->m_Context = m_Allocator;
+            block->m_Writable = true;
+            m_Shared = block;
+            m_Data += from;
+            m_Size -= from;
+            m_Capacity -= from;
+        }
+        m_CanFree = false;
+        m_CanModify = false;
+    }
+    /// @brief frees data ShareOwned took over. param context is the allocator it came from, nullptr means new[]
+    static void ReleaseOwned(char* data, size_t capacity, void* context) HBUFF_NOEXCEPT{
+        HBufferStats::RecordFree(capacity);
+        HBufferTrace::Record(HBufferTraceEvent::Free, capacity);
+        HBufferAllocator* allocator = static_cast<HBufferAllocator*>(context);
+        if(allocator)allocator->Deallocate(data, capacity);
+        else delete[] data;
+    }
+    /// @brief allocates param capacity bytes for this buffer. The allocator may round capacity up to what it actually handed out
+    char* AllocateData(size_t& capacity) HBUFF_NOEXCEPT{
+    #if HBUFF_SMALL_BUFFER_SIZE > 0
+        if(capacity <= HBUFF_SMALL_BUFFER_SIZE && m_Data != m_Inline){
+            capacity = HBUFF_SMALL_BUFFER_SIZE;
+            return m_Inline;
+        }
+    #endif
+        if(!m_Allocator)m_Allocator = HBufferAllocator::GetThreadDefault();
+        if(m_Allocator)capacity = m_Allocator->RoundUpCapacity(capacity);
+        HBufferStats::RecordAllocate(capacity);
+        HBufferTrace::Record(HBufferTraceEvent::Allocate, capacity);
+        if(!m_Allocator)return new char[capacity];
+        return m_Allocator->Allocate(capacity);
+    }
+    /// @brief gives data back to the allocator it came from. A nullptr allocator means the data came from new[]
+    void DeallocateData(HBufferAllocator* allocator, char* data, size_t capacity) HBUFF_NOEXCEPT{
+        if(!data)return;
+    #if HBUFF_SMALL_BUFFER_SIZE > 0
+        if(data == m_Inline)return;
+    #endif
+        HBufferStats::RecordFree(capacity);
+        HBufferTrace::Record(HBufferTraceEvent::Free, capacity);
+        if(allocator)allocator->Deallocate(data, capacity);
+        else delete[] data;
+    }
+    /// @brief if param buffer keeps its data inline we copy it into our own inline storage and point to that. Called after taking over its fields
+    void TakeInline(const HBuffer& buffer) HBUFF_NOEXCEPT{
+    #if HBUFF_SMALL_BUFFER_SIZE > 0
+        if(!buffer.IsInline())return;
+        memcpy(m_Inline, buffer.m_Inline, HBUFF_SMALL_BUFFER_SIZE);
+        m_Data = m_Inline;
+    #else
+        (void)buffer;
+    #endif
+    }
+    /// @brief reallocates to hold atleast param minCapacity bytes plus room to grow so repeated appends are amortized. Keeps m_Size bytes
+    void Grow(size_t minCapacity) HBUFF_NOEXCEPT{
+        minCapacity = std::max(minCapacity, m_Size);
+        if(CanWriteShared(minCapacity))return;
+        Reallocate(GetGrowthCapacity(m_Size, minCapacity), m_Size);
+    }
+    /// @brief moves the first param keep bytes into a new owned allocation of atleast param newCapacity bytes. Frees old data if we own it
+    void Reallocate(size_t newCapacity, size_t keep) HBUFF_NOEXCEPT{
+        if(CanWriteShared(newCapacity))return;
+        if(m_Data){
+            HBufferStats::RecordReallocate();
+            HBufferTrace::Record(HBufferTraceEvent::Reallocate, newCapacity, m_Capacity);
+        }
+        HBufferAllocator* oldAllocator = m_Allocator;
+        char* data = AllocateData(newCapacity);
+        keep = std::min(keep, newCapacity);
+        if(m_Data && keep > 0 && data != m_Data)memcpy(data, m_Data, keep);
+        ReleaseData(oldAllocator);
+        m_Data = data;
+        m_Capacity = newCapacity;
+        m_CanFree = true;
+        m_CanModify = true;
+        m_Shared = nullptr;
+    }
+    /// @brief returns if we hold the last reference to shared data that already has room for param capacity bytes.
+    /// @brief Mutators call Grow/Reallocate whenever m_CanModify is false so this is where copy on write gets skipped. m_CanModify stays false so later copies still copy on write
+    bool CanWriteShared(size_t capacity) const HBUFF_NOEXCEPT{
+    #if HBUFF_COW_UNIQUE_CHECK
+        return m_Shared && capacity <= m_Capacity && m_Shared->IsWritable() && IsUnique();
+    #else
+        (void)capacity;
+        return false;
+    #endif
+    }
+    /// @brief frees our data if we own it or drops our reference if it is shared. Does not reset any members
+    void ReleaseData(HBufferAllocator* allocator) HBUFF_NOEXCEPT{
+        if(m_Shared){
+            if(m_Shared->m_References.fetch_sub(1, std::memory_order_acq_rel) == 1)FreeSharedBlock(m_Shared);
+            return;
+        }
+        if(!m_CanFree)return;
+        if(HBufferStats::s_Enabled && m_Data && !IsInline())HBufferStats::RecordSlack(m_Capacity > m_Size ? m_Capacity - m_Size : 0);
+        DeallocateData(allocator, m_Data, m_Capacity);
+    }
+    /// @brief takes a reference on param buffer's shared block if it has one. Expects our own data to already be released
+    void ShareWith(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        m_Shared = buffer.m_Shared;
+        if(m_Shared)m_Shared->m_References.fetch_add(1, std::memory_order_relaxed);
+    }
+    /// @brief allocates a shared block with room for atleast param capacity bytes and a single reference
+    HBufferSharedBlock* AllocateSharedBlock(size_t capacity) HBUFF_NOEXCEPT{
+        HBufferAllocator* allocator = m_Allocator ? m_Allocator : HBufferAllocator::GetThreadDefault();
+        //The last reference can let go on any thread so the block only comes from an allocator that takes memory back anywhere
+        if(allocator && !allocator->IsThreadSafe())allocator = nullptr;
+        size_t blockSize = sizeof(HBufferSharedBlock) + capacity;
+        char* memory;
+        if(allocator){
+            blockSize = allocator->RoundUpCapacity(blockSize);
+            memory = allocator->Allocate(blockSize);
+        }
+        else memory = new char[blockSize];
+        HBufferStats::RecordAllocate(blockSize);
+        HBufferTrace::Record(HBufferTraceEvent::Allocate, blockSize);
+        HBufferSharedBlock* block = reinterpret_cast<HBufferSharedBlock*>(memory);
+        new(&block->m_References) std::atomic<size_t>(1);
+        block->m_Allocator = allocator;
+        block->m_BlockSize = blockSize;
+        block->m_Release = nullptr;
+        return block;
+    }
+    /// @brief creates a buffer holding the only reference to a block around param size bytes at param data that param release gives back
+    static HBuffer CreateExternal(char* data, size_t size, HBufferReleaseHook release, void* context, bool writable, HBufferAllocator* allocator = nullptr) HBUFF_NOEXCEPT{
+        HBuffer buffer(allocator);
+        HBufferExternalBlock* block = static_cast<HBufferExternalBlock*>(buffer.AllocateSharedBlock(sizeof(HBufferExternalBlock) - sizeof(HBufferSharedBlock)));
+        block->m_Release = release;
+        block->m_External = data;
+        block->m_ExternalSize = size;
+        block->m_Context = context;
+        block->m_Writable = writable;
+        buffer.m_Data = data;
+        buffer.m_Size = size;
+        buffer.m_Capacity = size;
+        buffer.m_Shared = block;
+        return buffer;
+    }
+    static void FreeSharedBlock(HBufferSharedBlock* block) HBUFF_NOEXCEPT{
+        if(block->m_Release){
+            HBufferExternalBlock* external = static_cast<HBufferExternalBlock*>(block);
+            block->m_Release(external->m_External, external->m_ExternalSize, external->m_Context);
+        }
+        HBufferAllocator* allocator = block->m_Allocator;
+        size_t blockSize = block->m_BlockSize;
+        char* memory = reinterpret_cast<char*>(block);
+        block->m_References.~atomic();
+        HBufferStats::RecordFree(blockSize);
+        HBufferTrace::Record(HBufferTraceEvent::Free, blockSize);
+        if(allocator)allocator->Deallocate(memory, blockSize);
+        else delete[] memory;
+    }
+private:
+    char* m_Data = nullptr;
+    size_t m_Size = 0;
+    size_t m_Capacity = 0;
+    bool m_CanFree = false;
+    bool m_CanModify = false;
+    HBufferAllocator* m_Allocator = nullptr;
+    HBufferSharedBlock* m_Shared = nullptr;
+#if HBUFF_SMALL_BUFFER_SIZE > 0
+    char m_Inline[HBUFF_SMALL_BUFFER_SIZE];
+#endif
+};
+
+#ifdef HBUFF_USE_FMT_LOGGER
+template <>
+struct fmt::formatter<HBuffer> {
+    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+
+    template <typename FormatContext>
+    auto format(const HBuffer& buff, FormatContext& ctx) const{
+        // safely use HBuffer's API
+        return fmt::format_to(ctx.out(), "{}", buff.SubString(0, -1).GetCStr());
+    }
+};
+#endif
+namespace std {
+    template<>
+    struct hash<HBuffer> {
+        std::size_t operator()(const HBuffer& buff) const HBUFF_NOEXCEPT{
+            return static_cast<std::size_t>(HBufferHash::Hash(buff.GetData(), buff.GetSize()));
+        }
+    };
 }
\ No newline at end of file
@@ -1,5 +1,556 @@
-#pragma once
-#include "Core.h"
-
-
-/// TODO: have allocators
+#pragma once
+#include "Core.h"
+#include <mutex>
+
+#ifndef HBUFF_ARENA_CHUNK_SIZE
+/// Default size of each block the arena allocator bumps through
+#define HBUFF_ARENA_CHUNK_SIZE 65536
+#endif
+
+#ifndef HBUFF_POOL_BLOCK_SIZE
+/// Default block size handed out by the pool allocator
+#define HBUFF_POOL_BLOCK_SIZE 256
+#endif
+
+#ifndef HBUFF_SIZE_CLASS_MIN
+/// Smallest power of two class used by the size class allocator
+#define HBUFF_SIZE_CLASS_MIN 16
+#endif
+
+#ifndef HBUFF_SIZE_CLASS_MAX
+/// Largest power of two class used by the size class allocator. Anything bigger goes to the heap
+#define HBUFF_SIZE_CLASS_MAX 65536
+#endif
+
+#ifndef HBUFF_RECYCLE_THREAD_CACHE_BYTES
+/// Bytes of each class a thread keeps for itself in the recycling allocator before moving half of them to the shared overflow. Always atleast 2 blocks
+#define HBUFF_RECYCLE_THREAD_CACHE_BYTES 262144
+#endif
+
+#ifndef HBUFF_RECYCLE_SHARED_BYTES
+/// Default limit of bytes the recycling allocator's shared overflow keeps. Blocks past it go back to the heap
+#define HBUFF_RECYCLE_SHARED_BYTES 16777216
+#endif
+
+/// @brief Interface for where a HBuffer gets its memory from. A buffer with a nullptr allocator uses new[]/delete[].
+/// @brief An allocator must outlive every buffer that allocated from it.
+class HBufferAllocator{
+public:
+    virtual ~HBufferAllocator(){}
+
+    /// @brief returns the capacity that will actually be handed out for a request of param size bytes so buffers can use the slack
+    virtual size_t RoundUpCapacity(size_t size) const HBUFF_NOEXCEPT{return size;}
+    /// @brief allocates param size bytes. size has already been passed through RoundUpCapacity
+    virtual char* Allocate(size_t size) HBUFF_NOEXCEPT = 0;
+    /// @brief gives back data previously returned by Allocate
+    /// @param capacity the same size that was passed to Allocate
+    virtual void Deallocate(char* data, size_t capacity) HBUFF_NOEXCEPT = 0;
+    /// @brief returns if data may be allocated and given back on any thread. Shared blocks only come from allocators that are, see HBuffer::MakeShared
+    virtual bool IsThreadSafe() const HBUFF_NOEXCEPT{return false;}
+public:
+    /// @brief returns the allocator buffers on this thread use when they have not been given one. nullptr means the heap
+    static HBufferAllocator* GetThreadDefault() HBUFF_NOEXCEPT{return ThreadDefault();}
+    /// @brief changes the allocator buffers on this thread use when they have not been given one
+    static void SetThreadDefault(HBufferAllocator* allocator) HBUFF_NOEXCEPT{ThreadDefault() = allocator;}
+private:
+    static HBufferAllocator*& ThreadDefault() HBUFF_NOEXCEPT{
+        thread_local HBufferAllocator* allocator = nullptr;
+        return allocator;
+    }
+};
+
+/// @brief Sets the thread default allocator for the lifetime of the scope and restores the previous one after.
+/// @brief Buffers that allocate inside the scope keep the allocator and give their data back to it on whatever thread frees them.
+/// @brief With an allocator that is not thread safe those buffers must stay on this thread, or be made shared first, which copies them into a block from a thread safe allocator
+class HBufferAllocatorScope{
+public:
+    explicit HBufferAllocatorScope(HBufferAllocator* allocator) HBUFF_NOEXCEPT : m_Previous(HBufferAllocator::GetThreadDefault()){
+        HBufferAllocator::SetThreadDefault(allocator);
+    }
+    ~HBufferAllocatorScope(){
+        HBufferAllocator::SetThreadDefault(m_Previous);
+    }
+    HBufferAllocatorScope(const HBufferAllocatorScope&) = delete;
+    HBufferAllocatorScope& operator=(const HBufferAllocatorScope&) = delete;
+private:
+    HBufferAllocator* m_Previous;
+};
+
+/// @brief Allocates with malloc and frees with free. Mostly for adopting memory that came from malloc, see HBuffer::Adopt. Thread safe.
+class HBufferMallocAllocator : public HBufferAllocator{
+public:
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        return static_cast<char*>(malloc(size));
+    }
+    void Deallocate(char* data, size_t) HBUFF_NOEXCEPT override{
+        free(data);
+    }
+    bool IsThreadSafe() const HBUFF_NOEXCEPT override{return true;}
+public:
+    /// @brief returns the one instance every buffer can share
+    static HBufferMallocAllocator* Get() HBUFF_NOEXCEPT{
+        static HBufferMallocAllocator allocator;
+        return &allocator;
+    }
+};
+
+/// @brief Bump allocator. Allocating is a pointer increment and freeing does nothing except for the most recent allocation.
+/// @brief Call Reset() to reclaim everything at once. Buffers that allocated from the arena must not be used after Reset(). Not thread safe.
+class HBufferArenaAllocator : public HBufferAllocator{
+public:
+    explicit HBufferArenaAllocator(size_t chunkSize = HBUFF_ARENA_CHUNK_SIZE) HBUFF_NOEXCEPT : m_ChunkSize(chunkSize){}
+    ~HBufferArenaAllocator(){
+        for(size_t i = 0; i < m_Chunks.size(); i++)delete[] m_Chunks[i].m_Data;
+    }
+    HBufferArenaAllocator(const HBufferArenaAllocator&) = delete;
+    HBufferArenaAllocator& operator=(const HBufferArenaAllocator&) = delete;
+
+    size_t RoundUpCapacity(size_t size) const HBUFF_NOEXCEPT override{
+        return (size + (s_Alignment - 1)) & ~(s_Alignment - 1);
+    }
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        while(m_Current < m_Chunks.size()){
+            Chunk& chunk = m_Chunks[m_Current];
+            if(chunk.m_Size - m_Offset >= size){
+                char* data = chunk.m_Data + m_Offset;
+                m_Offset += size;
+                m_BytesUsed += size;
+                return data;
+            }
+            //Chunks left over from before a Reset() are reused in order
+            m_Current++;
+            m_Offset = 0;
+        }
+
+        Chunk chunk;
+        chunk.m_Size = std::max(m_ChunkSize, size);
+        chunk.m_Data = new char[chunk.m_Size];
+        m_Chunks.push_back(chunk);
+        m_Current = m_Chunks.size() - 1;
+        m_Offset = size;
+        m_BytesUsed += size;
+        return chunk.m_Data;
+    }
+    /// @brief only reclaims the memory if it was the last allocation so a buffer growing on top of the arena does not waste its old block
+    void Deallocate(char* data, size_t capacity) HBUFF_NOEXCEPT override{
+        if(m_Current >= m_Chunks.size() || capacity > m_Offset)return;
+        if(m_Chunks[m_Current].m_Data + m_Offset - capacity != data)return;
+        m_Offset -= capacity;
+        m_BytesUsed -= capacity;
+    }
+
+    /// @brief reclaims every allocation at once while keeping the chunks around for reuse
+    void Reset() HBUFF_NOEXCEPT{
+        m_Current = 0;
+        m_Offset = 0;
+        m_BytesUsed = 0;
+    }
+    /// @brief reclaims every allocation and gives the chunks back to the heap
+    void Clear() HBUFF_NOEXCEPT{
+        for(size_t i = 0; i < m_Chunks.size(); i++)delete[] m_Chunks[i].m_Data;
+        m_Chunks.clear();
+        Reset();
+    }
+public:
+    /// @brief returns the amount of bytes handed out since the last Reset()
+    size_t GetBytesUsed() const HBUFF_NOEXCEPT{return m_BytesUsed;}
+    /// @brief returns the amount of bytes the arena is holding onto from the heap
+    size_t GetBytesReserved() const HBUFF_NOEXCEPT{
+        size_t total = 0;
+        for(size_t i = 0; i < m_Chunks.size(); i++)total += m_Chunks[i].m_Size;
+        return total;
+    }
+private:
+    struct Chunk{
+        char* m_Data = nullptr;
+        size_t m_Size = 0;
+    };
+    static constexpr size_t s_Alignment = 16;
+    std::vector<Chunk> m_Chunks;
+    size_t m_ChunkSize;
+    size_t m_Current = 0;
+    size_t m_Offset = 0;
+    size_t m_BytesUsed = 0;
+};
+
+/// @brief Hands out fixed size blocks from a free list. Requests bigger than the block size go to the heap.
+/// @brief Not thread safe. Use GetThreadPool() or one instance per thread and free buffers on the thread that allocated them.
+class HBufferPoolAllocator : public HBufferAllocator{
+public:
+    explicit HBufferPoolAllocator(size_t blockSize = HBUFF_POOL_BLOCK_SIZE, size_t blocksPerChunk = 64) HBUFF_NOEXCEPT
+        : m_BlockSize(std::max(blockSize, sizeof(void*))), m_BlocksPerChunk(std::max<size_t>(blocksPerChunk, 1)){}
+    ~HBufferPoolAllocator(){
+        for(size_t i = 0; i < m_Chunks.size(); i++)delete[] m_Chunks[i];
+    }
+    HBufferPoolAllocator(const HBufferPoolAllocator&) = delete;
+    HBufferPoolAllocator& operator=(const HBufferPoolAllocator&) = delete;
+
+    size_t RoundUpCapacity(size_t size) const HBUFF_NOEXCEPT override{
+        return size <= m_BlockSize ? m_BlockSize : size;
+    }
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        if(size > m_BlockSize)return new char[size];
+        if(!m_FreeList){
+            char* chunk = new char[m_BlockSize * m_BlocksPerChunk];
+            m_Chunks.push_back(chunk);
+            for(size_t i = 0; i < m_BlocksPerChunk; i++)Push(chunk + i * m_BlockSize);
+        }
+        char* block = m_FreeList;
+        memcpy(&m_FreeList, block, sizeof(char*));
+        return block;
+    }
+    void Deallocate(char* data, size_t capacity) HBUFF_NOEXCEPT override{
+        if(capacity > m_BlockSize){
+            delete[] data;
+            return;
+        }
+        Push(data);
+    }
+public:
+    size_t GetBlockSize() const HBUFF_NOEXCEPT{return m_BlockSize;}
+    /// @brief returns a pool owned by the calling thread
+    static HBufferPoolAllocator& GetThreadPool() HBUFF_NOEXCEPT{
+        thread_local HBufferPoolAllocator pool;
+        return pool;
+    }
+private:
+    void Push(char* block) HBUFF_NOEXCEPT{
+        memcpy(block, &m_FreeList, sizeof(char*));
+        m_FreeList = block;
+    }
+private:
+    std::vector<char*> m_Chunks;
+    char* m_FreeList = nullptr;
+    size_t m_BlockSize;
+    size_t m_BlocksPerChunk;
+};
+
+/// @brief Rounds every request up to a power of two class and keeps a free list per class.
+/// @brief Requests above HBUFF_SIZE_CLASS_MAX go to the heap. Not thread safe.
+class HBufferSizeClassAllocator : public HBufferAllocator{
+public:
+    HBufferSizeClassAllocator() HBUFF_NOEXCEPT{
+        for(size_t i = 0; i < s_ClassCount; i++)m_FreeLists[i] = nullptr;
+    }
+    ~HBufferSizeClassAllocator(){
+        Trim();
+    }
+    HBufferSizeClassAllocator(const HBufferSizeClassAllocator&) = delete;
+    HBufferSizeClassAllocator& operator=(const HBufferSizeClassAllocator&) = delete;
+
+    size_t RoundUpCapacity(size_t size) const HBUFF_NOEXCEPT override{
+        if(size > HBUFF_SIZE_CLASS_MAX)return size;
+        size_t capacity = HBUFF_SIZE_CLASS_MIN;
+        while(capacity < size)capacity <<= 1;
+        return capacity;
+    }
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        if(size > HBUFF_SIZE_CLASS_MAX)return new char[size];
+        size_t index = GetClassIndex(size);
+        char* block = m_FreeLists[index];
+        if(!block)return new char[size];
+        memcpy(&m_FreeLists[index], block, sizeof(char*));
+        return block;
+    }
+    void Deallocate(char* data, size_t capacity) HBUFF_NOEXCEPT override{
+        if(capacity > HBUFF_SIZE_CLASS_MAX){
+            delete[] data;
+            return;
+        }
+        size_t index = GetClassIndex(capacity);
+        memcpy(data, &m_FreeLists[index], sizeof(char*));
+        m_FreeLists[index] = data;
+    }
+
+    /// @brief gives every cached block back to the heap
+    void Trim() HBUFF_NOEXCEPT{
+        for(size_t i = 0; i < s_ClassCount; i++){
+            char* block = m_FreeLists[i];
+            while(block){
+                char* next;
+                memcpy(&next, block, sizeof(char*));
+                delete[] block;
+                block = next;
+            }
+            m_FreeLists[i] = nullptr;
+        }
+    }
+public:
+    /// @brief returns the index of the class param capacity falls into. 0 is HBUFF_SIZE_CLASS_MIN
+    static size_t GetClassIndex(size_t capacity) HBUFF_NOEXCEPT{
+        size_t index = 0;
+        size_t classSize = HBUFF_SIZE_CLASS_MIN;
+        while(classSize < capacity){
+            classSize <<= 1;
+            index++;
+        }
+        return index;
+    }
+    /// @brief one free list per bit of size_t is enough for any HBUFF_SIZE_CLASS_MIN/HBUFF_SIZE_CLASS_MAX pair
+    static constexpr size_t s_ClassCount = sizeof(size_t) * 8;
+private:
+    char* m_FreeLists[s_ClassCount];
+};
+
+/// @brief counters of a HBufferRecyclingAllocator. Only allocations of up to HBUFF_SIZE_CLASS_MAX bytes are counted
+struct HBufferRecyclingStats{
+    /// @brief allocations served from the calling thread's cache
+    uint64_t m_ThreadHits = 0;
+    /// @brief allocations served by refilling the thread's cache from the shared overflow
+    uint64_t m_SharedHits = 0;
+    /// @brief allocations that had to go to the heap
+    uint64_t m_Misses = 0;
+    /// @brief blocks given back to be reused
+    uint64_t m_Recycled = 0;
+    /// @brief blocks given back to the heap because the shared overflow was full or Trim was called
+    uint64_t m_Released = 0;
+    /// @brief bytes waiting in the shared overflow. What thread caches hold is not included
+    uint64_t m_SharedBytes = 0;
+
+    /// @brief returns the share of allocations that reused a block, 0 if there were none
+    double GetHitRate() const HBUFF_NOEXCEPT{
+        uint64_t total = m_ThreadHits + m_SharedHits + m_Misses;
+        return total > 0 ? static_cast<double>(m_ThreadHits + m_SharedHits) / total : 0.0;
+    }
+};
+
+/// @brief Thread safe version of HBufferSizeClassAllocator for buffers of a few recurring sizes that are made and freed over and over.
+/// @brief Every thread keeps free lists of its own so most allocations and frees take no lock. A thread with too many blocks of a class moves half of them to a shared overflow that other threads refill from.
+/// @brief Blocks may be freed on any thread. The allocator must outlive the threads that used it, use Get() for one that lives as long as the process.
+class HBufferRecyclingAllocator : public HBufferAllocator{
+public:
+    /// @param maxSharedBytes most bytes the shared overflow keeps before giving blocks back to the heap
+    explicit HBufferRecyclingAllocator(size_t maxSharedBytes = HBUFF_RECYCLE_SHARED_BYTES) HBUFF_NOEXCEPT : m_MaxSharedBytes(maxSharedBytes){}
+    ~HBufferRecyclingAllocator(){
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        //Only caches of the destroying thread or of threads that never exit are left
+        for(ThreadCache* cache : m_Caches){
+            for(size_t i = 0; i < s_ClassCount; i++)DeleteList(cache->m_Lists[i]);
+            cache->m_Owner.store(nullptr, std::memory_order_release);
+        }
+        for(size_t i = 0; i < s_ClassCount; i++)DeleteList(m_Shared[i]);
+    }
+    HBufferRecyclingAllocator(const HBufferRecyclingAllocator&) = delete;
+    HBufferRecyclingAllocator& operator=(const HBufferRecyclingAllocator&) = delete;
+
+    size_t RoundUpCapacity(size_t size) const HBUFF_NOEXCEPT override{
+        if(size > HBUFF_SIZE_CLASS_MAX)return size;
+        return HBufferRoundUpPowerOfTwo(std::max<size_t>(size, HBUFF_SIZE_CLASS_MIN));
+    }
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        ThreadCache* cache = size <= HBUFF_SIZE_CLASS_MAX ? GetThreadCache(true) : nullptr;
+        if(!cache)return new char[size];
+        size_t index = GetClassIndex(size);
+        if(cache->m_Lists[index]){
+            Increment(cache->m_ThreadHits);
+            return cache->Pop(index);
+        }
+        if(Refill(*cache, index)){
+            Increment(cache->m_SharedHits);
+            return cache->Pop(index);
+        }
+        Increment(cache->m_Misses);
+        //Always a whole class so the block fits anything of its class once it is recycled
+        return new char[GetClassSize(index)];
+    }
+    void Deallocate(char* data, size_t capacity) HBUFF_NOEXCEPT override{
+        if(capacity > HBUFF_SIZE_CLASS_MAX){
+            delete[] data;
+            return;
+        }
+        size_t index = GetClassIndex(capacity);
+        ThreadCache* cache = GetThreadCache(true);
+        if(!cache){
+            //The thread's cache is already gone, it is exiting. The block still only stays if the overflow has room for it
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(PushShared(data, index))m_Totals.m_Recycled++;
+            return;
+        }
+        Increment(cache->m_Recycled);
+        cache->Push(data, index);
+        size_t limit = GetThreadLimit(index);
+        if(cache->m_Counts[index] > limit)Flush(*cache, index, limit / 2);
+    }
+    bool IsThreadSafe() const HBUFF_NOEXCEPT override{return true;}
+public:
+    /// @brief gives blocks in the shared overflow back to the heap until it holds atmost param maxSharedBytes. Blocks in thread caches are left alone, see TrimThreadCache
+    void Trim(size_t maxSharedBytes = 0) HBUFF_NOEXCEPT{
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for(size_t i = s_ClassCount; i-- > 0 && m_Totals.m_SharedBytes > maxSharedBytes;){
+            while(m_Shared[i] && m_Totals.m_SharedBytes > maxSharedBytes){
+                delete[] PopShared(i);
+                m_Totals.m_Released++;
+            }
+        }
+    }
+    /// @brief moves every block the calling thread holds into the shared overflow so Trim can reach them
+    void TrimThreadCache() HBUFF_NOEXCEPT{
+        ThreadCache* cache = GetThreadCache(false);
+        if(!cache)return;
+        for(size_t i = 0; i < s_ClassCount; i++)Flush(*cache, i, 0);
+    }
+    /// @brief changes how many bytes the shared overflow keeps. Does not trim what is already there, see Trim
+    void SetMaxSharedBytes(size_t maxSharedBytes) HBUFF_NOEXCEPT{
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_MaxSharedBytes = maxSharedBytes;
+    }
+    /// @brief returns the counters of every thread so far. Safe while other threads allocate
+    HBufferRecyclingStats GetStats() HBUFF_NOEXCEPT{
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        HBufferRecyclingStats stats = m_Totals;
+        for(ThreadCache* cache : m_Caches)cache->AddTo(stats);
+        return stats;
+    }
+    /// @brief returns the one instance every thread can share. Never destroyed so buffers freed during static destruction are fine
+    static HBufferRecyclingAllocator* Get() HBUFF_NOEXCEPT{
+        static HBufferRecyclingAllocator* allocator = new HBufferRecyclingAllocator;
+        return allocator;
+    }
+private:
+    static constexpr size_t s_ClassCount = HBufferSizeClassAllocator::s_ClassCount;
+    /// @brief free lists of one thread for one allocator. Only the thread touches the lists. The counters are read by GetStats so they are atomics without read modify writes
+    struct ThreadCache{
+        std::atomic<HBufferRecyclingAllocator*> m_Owner{nullptr};
+        char* m_Lists[s_ClassCount] = {};
+        size_t m_Counts[s_ClassCount] = {};
+        std::atomic<uint64_t> m_ThreadHits{0};
+        std::atomic<uint64_t> m_SharedHits{0};
+        std::atomic<uint64_t> m_Misses{0};
+        std::atomic<uint64_t> m_Recycled{0};
+
+        void Push(char* block, size_t index) HBUFF_NOEXCEPT{
+            memcpy(block, &m_Lists[index], sizeof(char*));
+            m_Lists[index] = block;
+            m_Counts[index]++;
+        }
+        char* Pop(size_t index) HBUFF_NOEXCEPT{
+            char* block = m_Lists[index];
+            memcpy(&m_Lists[index], block, sizeof(char*));
+            m_Counts[index]--;
+            return block;
+        }
+        void AddTo(HBufferRecyclingStats& stats) const HBUFF_NOEXCEPT{
+            stats.m_ThreadHits += m_ThreadHits.load(std::memory_order_relaxed);
+            stats.m_SharedHits += m_SharedHits.load(std::memory_order_relaxed);
+            stats.m_Misses += m_Misses.load(std::memory_order_relaxed);
+            stats.m_Recycled += m_Recycled.load(std::memory_order_relaxed);
+        }
+    };
+    /// @brief every cache of one thread, one per allocator it used. Hands them back to their allocators when the thread exits
+    struct ThreadCaches{
+        std::vector<ThreadCache*> m_Caches;
+        ThreadCache* m_Last = nullptr;
+
+        ~ThreadCaches(){
+            ThreadState() = State::Retired;
+            for(ThreadCache* cache : m_Caches){
+                HBufferRecyclingAllocator* owner = cache->m_Owner.load(std::memory_order_acquire);
+                if(owner)owner->Detach(cache);
+                delete cache;
+            }
+        }
+    };
+    enum class State : uint8_t{None, Live, Retired};
+private:
+    /// @brief returns the calling thread's cache for this allocator. Creates it if param create is true. nullptr once the thread's caches are being destroyed
+    ThreadCache* GetThreadCache(bool create) HBUFF_NOEXCEPT{
+        if(ThreadState() == State::Retired)return nullptr;
+        thread_local ThreadCaches caches;
+        ThreadState() = State::Live;
+        if(caches.m_Last && caches.m_Last->m_Owner.load(std::memory_order_relaxed) == this)return caches.m_Last;
+        for(ThreadCache* cache : caches.m_Caches){
+            if(cache->m_Owner.load(std::memory_order_relaxed) != this)continue;
+            caches.m_Last = cache;
+            return cache;
+        }
+        if(!create)return nullptr;
+        ThreadCache* cache = new ThreadCache;
+        cache->m_Owner.store(this, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Caches.push_back(cache);
+        }
+        caches.m_Caches.push_back(cache);
+        caches.m_Last = cache;
+        return cache;
+    }
+    /// @brief trivially destructible so it can still be read after ThreadCaches is gone
+    static State& ThreadState() HBUFF_NOEXCEPT{
+        thread_local State state = State::None;
+        return state;
+    }
+    /// @brief returns how many blocks of class param index a thread keeps
+    static size_t GetThreadLimit(size_t index) HBUFF_NOEXCEPT{
+        return std::max<size_t>(2, HBUFF_RECYCLE_THREAD_CACHE_BYTES / GetClassSize(index));
+    }
+    static size_t GetClassSize(size_t index) HBUFF_NOEXCEPT{
+        return static_cast<size_t>(HBUFF_SIZE_CLASS_MIN) << index;
+    }
+    static size_t GetClassIndex(size_t capacity) HBUFF_NOEXCEPT{
+        return HBufferSizeClassAllocator::GetClassIndex(capacity);
+    }
+    /// @brief moves up to half a thread's worth of blocks of class param index from the shared overflow into param cache
+    /// @return returns false if the shared overflow had none
+    bool Refill(ThreadCache& cache, size_t index) HBUFF_NOEXCEPT{
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if(!m_Shared[index])return false;
+        size_t count = std::max<size_t>(1, GetThreadLimit(index) / 2);
+        for(size_t i = 0; i < count && m_Shared[index]; i++)cache.Push(PopShared(index), index);
+        return true;
+    }
+    /// @brief moves blocks of class param index out of param cache until it holds param keep of them
+    void Flush(ThreadCache& cache, size_t index, size_t keep) HBUFF_NOEXCEPT{
+        if(cache.m_Counts[index] <= keep)return;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        while(cache.m_Counts[index] > keep)PushShared(cache.Pop(index), index);
+    }
+    /// @brief called by a thread that is exiting. Keeps its counters and its blocks
+    void Detach(ThreadCache* cache) HBUFF_NOEXCEPT{
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        cache->AddTo(m_Totals);
+        for(size_t i = 0; i < s_ClassCount; i++){
+            while(cache->m_Lists[i])PushShared(cache->Pop(i), i);
+        }
+        m_Caches.erase(std::find(m_Caches.begin(), m_Caches.end(), cache));
+    }
+    /// @brief expects m_Mutex to be held. Gives param block back to the heap instead if the overflow is full
+    /// @return returns false if the block went back to the heap
+    bool PushShared(char* block, size_t index) HBUFF_NOEXCEPT{
+        size_t size = GetClassSize(index);
+        if(m_Totals.m_SharedBytes + size > m_MaxSharedBytes){
+            delete[] block;
+            m_Totals.m_Released++;
+            return false;
+        }
+        memcpy(block, &m_Shared[index], sizeof(char*));
+        m_Shared[index] = block;
+        m_Totals.m_SharedBytes += size;
+        return true;
+    }
+    /// @brief expects m_Mutex to be held and the list of param index to not be empty
+    char* PopShared(size_t index) HBUFF_NOEXCEPT{
+        char* block = m_Shared[index];
+        memcpy(&m_Shared[index], block, sizeof(char*));
+        m_Totals.m_SharedBytes -= GetClassSize(index);
+        return block;
+    }
+    static void DeleteList(char*& list) HBUFF_NOEXCEPT{
+        while(list){
+            char* next;
+            memcpy(&next, list, sizeof(char*));
+            delete[] list;
+            list = next;
+        }
+    }
+    static void Increment(std::atomic<uint64_t>& counter) HBUFF_NOEXCEPT{
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+private:
+    std::mutex m_Mutex;
+    /// @brief counters of threads that exited plus what only the shared side knows
+    HBufferRecyclingStats m_Totals;
+    size_t m_MaxSharedBytes;
+    /// @brief the shared overflow, one free list per class
+    char* m_Shared[s_ClassCount] = {};
+    std::vector<ThreadCache*> m_Caches;
+};
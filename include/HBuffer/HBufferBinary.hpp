@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core.h"
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <stdlib.h>
+#endif
+
+/// @brief byte order of binary data. Default follows HBUFF_ENDIAN_MODE and Native is whatever the machine uses
+enum class HBufferEndian : uint8_t{
+    Little = 0,
+    Big = 1,
+#if defined(HBUFF_HOST_LITTLE_ENDIAN)
+    Native = Little,
+#else
+    Native = Big,
+#endif
+#if defined(HBUFF_ENDIAN_MODE) && HBUFF_ENDIAN_MODE == 1
+    Default = Big
+#else
+    Default = Little
+#endif
+};
+
+/// Encoding of fixed width numbers, LEB128 varints and zigzag on raw memory. Used by HBuffer, HBufferWriter and HBufferReader.
+/// Fixed width values are moved with a single unaligned load or store and only byte swapped when the wanted order is not the native one.
+struct HBufferBinary{
+public:
+    /// @brief the most bytes a 64 bit LEB128 varint takes
+    static constexpr size_t s_MaxVarIntSize = 10;
+
+    /// @brief writes param value to param dst in param endian order. dst does not need to be aligned
+    template<typename T>
+    static void Store(char* dst, T value, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT{
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "HBufferBinary only stores numbers");
+        typename Bits<sizeof(T)>::Type bits;
+        memcpy(&bits, &value, sizeof(T));
+        if(endian != HBufferEndian::Native)bits = ByteSwap(bits);
+        memcpy(dst, &bits, sizeof(T));
+    }
+    /// @brief reads a T stored in param endian order from param src. src does not need to be aligned
+    template<typename T>
+    static T Load(const char* src, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT{
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "HBufferBinary only loads numbers");
+        typename Bits<sizeof(T)>::Type bits;
+        memcpy(&bits, src, sizeof(T));
+        if(endian != HBufferEndian::Native)bits = ByteSwap(bits);
+        T value;
+        memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+    /// @brief writes param count values to param dst. A single memcpy when the order is native
+    template<typename T>
+    static void StoreArray(char* dst, const T* values, size_t count, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT{
+        if(count < 1)return;
+        if(sizeof(T) == 1 || endian == HBufferEndian::Native){
+            memcpy(dst, values, count * sizeof(T));
+            return;
+        }
+        for(size_t i = 0; i < count; i++)Store(dst + i * sizeof(T), values[i], endian);
+    }
+    /// @brief reads param count values from param src. A single memcpy when the order is native
+    template<typename T>
+    static void LoadArray(T* values, const char* src, size_t count, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT{
+        if(count < 1)return;
+        if(sizeof(T) == 1 || endian == HBufferEndian::Native){
+            memcpy(values, src, count * sizeof(T));
+            return;
+        }
+        for(size_t i = 0; i < count; i++)values[i] = Load<T>(src + i * sizeof(T), endian);
+    }
+
+    /// @brief writes param value as an unsigned LEB128 varint. dst needs room for s_MaxVarIntSize bytes
+    /// @return returns the amount of bytes written
+    static size_t StoreVarUInt(char* dst, uint64_t value) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        while(value >= 0x80){
+            dst[i++] = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        dst[i++] = static_cast<char>(value);
+        return i;
+    }
+    /// @brief reads an unsigned LEB128 varint from the first param len bytes of param src
+    /// @return returns the amount of bytes read or 0 if the varint is cut off or does not fit in 64 bits
+    static size_t LoadVarUInt(const char* src, size_t len, uint64_t& value) HBUFF_NOEXCEPT{
+        uint64_t result = 0;
+        size_t max = std::min(len, s_MaxVarIntSize);
+        for(size_t i = 0; i < max; i++){
+            uint64_t byte = static_cast<uint8_t>(src[i]);
+            //The 10th byte only has room for the top bit of a 64 bit value
+            if(i == s_MaxVarIntSize - 1 && byte > 1)return 0;
+            result |= (byte & 0x7F) << (7 * i);
+            if(byte < 0x80){
+                value = result;
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+    /// @brief returns the amount of bytes StoreVarUInt takes for param value
+    static size_t GetVarUIntSize(uint64_t value) HBUFF_NOEXCEPT{
+        size_t size = 1;
+        while(value >= 0x80){
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    /// @brief maps signed values to unsigned so small negatives stay small as varints. 0,-1,1,-2 become 0,1,2,3
+    static uint64_t ZigZagEncode(int64_t value) HBUFF_NOEXCEPT{
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+    static int64_t ZigZagDecode(uint64_t value) HBUFF_NOEXCEPT{
+        return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+    }
+
+    static uint8_t ByteSwap(uint8_t value) HBUFF_NOEXCEPT{return value;}
+    static uint16_t ByteSwap(uint16_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_ushort(value);
+    #else
+        return __builtin_bswap16(value);
+    #endif
+    }
+    static uint32_t ByteSwap(uint32_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_ulong(value);
+    #else
+        return __builtin_bswap32(value);
+    #endif
+    }
+    static uint64_t ByteSwap(uint64_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        return _byteswap_uint64(value);
+    #else
+        return __builtin_bswap64(value);
+    #endif
+    }
+private:
+    /// @brief the unsigned integer with the same size as a value so it can be byte swapped
+    template<size_t Size>
+    struct Bits;
+};
+
+template<> struct HBufferBinary::Bits<1>{using Type = uint8_t;};
+template<> struct HBufferBinary::Bits<2>{using Type = uint16_t;};
+template<> struct HBufferBinary::Bits<4>{using Type = uint32_t;};
+template<> struct HBufferBinary::Bits<8>{using Type = uint64_t;};
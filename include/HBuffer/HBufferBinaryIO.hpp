@@ -0,0 +1,124 @@
+#pragma once
+
+#include "HBuffer.hpp"
+
+/// @brief Appends binary values to the end of a HBuffer. Every write takes an optional byte order that overrides the writer's.
+/// @brief The buffer must outlive the writer.
+class HBufferWriter{
+public:
+    explicit HBufferWriter(HBuffer& buffer, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT : m_Buffer(buffer), m_Endian(endian){}
+
+    /// @brief appends param value as sizeof(T) bytes
+    template<typename T>
+    void Write(T value) HBUFF_NOEXCEPT{
+        HBufferBinary::Store(m_Buffer.Extend(sizeof(T)), value, m_Endian);
+    }
+    template<typename T>
+    void Write(T value, HBufferEndian endian) HBUFF_NOEXCEPT{
+        HBufferBinary::Store(m_Buffer.Extend(sizeof(T)), value, endian);
+    }
+    /// @brief appends param count values. A single memcpy when the byte order is native
+    template<typename T>
+    void WriteArray(const T* values, size_t count) HBUFF_NOEXCEPT{
+        WriteArray(values, count, m_Endian);
+    }
+    template<typename T>
+    void WriteArray(const T* values, size_t count, HBufferEndian endian) HBUFF_NOEXCEPT{
+        HBufferBinary::StoreArray(m_Buffer.Extend(count * sizeof(T)), values, count, endian);
+    }
+    /// @brief appends param value as an unsigned LEB128 varint
+    void WriteVarUInt(uint64_t value) HBUFF_NOEXCEPT{
+        char bytes[HBufferBinary::s_MaxVarIntSize];
+        size_t size = HBufferBinary::StoreVarUInt(bytes, value);
+        memcpy(m_Buffer.Extend(size), bytes, size);
+    }
+    /// @brief appends param value zigzag encoded as a LEB128 varint
+    void WriteVarInt(int64_t value) HBUFF_NOEXCEPT{
+        WriteVarUInt(HBufferBinary::ZigZagEncode(value));
+    }
+    /// @brief appends param len raw bytes
+    void WriteBytes(const void* data, size_t len) HBUFF_NOEXCEPT{
+        if(len > 0)memcpy(m_Buffer.Extend(len), data, len);
+    }
+public:
+    HBuffer& GetBuffer() HBUFF_NOEXCEPT{return m_Buffer;}
+    HBufferEndian GetEndian() const HBUFF_NOEXCEPT{return m_Endian;}
+    void SetEndian(HBufferEndian endian) HBUFF_NOEXCEPT{m_Endian = endian;}
+private:
+    HBuffer& m_Buffer;
+    HBufferEndian m_Endian;
+};
+
+/// @brief Reads binary values from a HBuffer front to back. Every read takes an optional byte order that overrides the reader's.
+/// @brief Reads that run out of data return false and leave the position where it was. The buffer's data must outlive the reader.
+class HBufferReader{
+public:
+    explicit HBufferReader(const HBuffer& buffer, HBufferEndian endian = HBufferEndian::Default) HBUFF_NOEXCEPT : m_Buffer(buffer), m_Endian(endian){}
+
+    template<typename T>
+    bool Read(T& value) HBUFF_NOEXCEPT{
+        return Read(value, m_Endian);
+    }
+    template<typename T>
+    bool Read(T& value, HBufferEndian endian) HBUFF_NOEXCEPT{
+        if(GetRemaining() < sizeof(T))return false;
+        value = HBufferBinary::Load<T>(m_Buffer.GetData() + m_Position, endian);
+        m_Position += sizeof(T);
+        return true;
+    }
+    /// @brief reads param count values into param values. A single memcpy when the byte order is native
+    template<typename T>
+    bool ReadArray(T* values, size_t count) HBUFF_NOEXCEPT{
+        return ReadArray(values, count, m_Endian);
+    }
+    template<typename T>
+    bool ReadArray(T* values, size_t count, HBufferEndian endian) HBUFF_NOEXCEPT{
+        if(GetRemaining() / sizeof(T) < count)return false;
+        HBufferBinary::LoadArray(values, m_Buffer.GetData() + m_Position, count, endian);
+        m_Position += count * sizeof(T);
+        return true;
+    }
+    /// @brief reads an unsigned LEB128 varint
+    bool ReadVarUInt(uint64_t& value) HBUFF_NOEXCEPT{
+        size_t size = HBufferBinary::LoadVarUInt(m_Buffer.GetData() + m_Position, GetRemaining(), value);
+        m_Position += size;
+        return size > 0;
+    }
+    /// @brief reads a zigzag encoded LEB128 varint
+    bool ReadVarInt(int64_t& value) HBUFF_NOEXCEPT{
+        uint64_t encoded;
+        if(!ReadVarUInt(encoded))return false;
+        value = HBufferBinary::ZigZagDecode(encoded);
+        return true;
+    }
+    /// @brief copies param len raw bytes into param data
+    bool ReadBytes(void* data, size_t len) HBUFF_NOEXCEPT{
+        if(GetRemaining() < len)return false;
+        if(len > 0)memcpy(data, m_Buffer.GetData() + m_Position, len);
+        m_Position += len;
+        return true;
+    }
+    /// @brief points param view at the next param len bytes without copying them
+    bool ReadView(HBuffer& view, size_t len) HBUFF_NOEXCEPT{
+        if(GetRemaining() < len)return false;
+        view = m_Buffer.SubPointer(m_Position, len, false);
+        m_Position += len;
+        return true;
+    }
+    bool Skip(size_t len) HBUFF_NOEXCEPT{
+        if(GetRemaining() < len)return false;
+        m_Position += len;
+        return true;
+    }
+public:
+    size_t GetPosition() const HBUFF_NOEXCEPT{return m_Position;}
+    /// @brief moves the read position. Clamped to the size of the buffer
+    void SetPosition(size_t position) HBUFF_NOEXCEPT{m_Position = std::min(position, m_Buffer.GetSize());}
+    size_t GetRemaining() const HBUFF_NOEXCEPT{return m_Buffer.GetSize() - m_Position;}
+    HBufferEndian GetEndian() const HBUFF_NOEXCEPT{return m_Endian;}
+    void SetEndian(HBufferEndian endian) HBUFF_NOEXCEPT{m_Endian = endian;}
+private:
+    HBuffer m_Buffer;
+    HBufferEndian m_Endian;
+    size_t m_Position = 0;
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Core.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/// HBUFF_HASH_MODE == 0. The old hash * 31 + byte loop
+/// HBUFF_HASH_MODE == 1. wyhash style. Mixes 16 bytes per step and 48 per step on long keys
+
+#ifndef HBUFF_HASH_MODE
+/// Defaulting to wyhash
+#define HBUFF_HASH_MODE 1
+#endif
+
+/// Hash functions used by std::hash<HBuffer> and HBufferLowercaseHash. They work on raw bytes so anything can use them.
+/// The Lowercase versions hash as if every ASCII upper case letter was lower case so they agree with a case insensitive equals.
+struct HBufferHash{
+public:
+    /// @brief hashes param len bytes of param data with whatever HBUFF_HASH_MODE picks
+    static uint64_t Hash(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return HashFrom(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+    /// @brief same as Hash but ASCII case is ignored
+    static uint64_t HashLowercase(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return HashLowercaseFrom(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+    /// @brief hashes param len bytes that do not sit in one piece of memory. Gives the same value as Hash over the same bytes laid out flat
+    /// @param source anything with a Read(size_t at, void* out, size_t count) const that copies count bytes starting at byte at into out
+    template<typename Source>
+    static uint64_t HashFrom(const Source& source, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+    #if HBUFF_HASH_MODE == 0
+        return Legacy<false>(source, len, seed);
+    #else
+        return Wy<false>(source, len, seed);
+    #endif
+    }
+    template<typename Source>
+    static uint64_t HashLowercaseFrom(const Source& source, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+    #if HBUFF_HASH_MODE == 0
+        return Legacy<true>(source, len, seed);
+    #else
+        return Wy<true>(source, len, seed);
+    #endif
+    }
+
+    /// @brief wyhash. Reads 8 bytes at a time and mixes them through 64x64->128 bit multiplies
+    static uint64_t WyHash(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return Wy<false>(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+    static uint64_t WyHashLowercase(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return Wy<true>(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+    /// @brief the hash * 31 + byte loop HBuffer used before. Kept around to compare against
+    static uint64_t LegacyHash(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return Legacy<false>(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+    static uint64_t LegacyHashLowercase(const void* data, size_t len, uint64_t seed = 0) HBUFF_NOEXCEPT{
+        return Legacy<true>(PointerSource{static_cast<const uint8_t*>(data)}, len, seed);
+    }
+
+    /// @brief lower cases every ASCII letter packed in param word at once without branching on any of them
+    static uint64_t FoldCase(uint64_t word) HBUFF_NOEXCEPT{
+        const uint64_t ones = 0x0101010101010101ull;
+        const uint64_t high = 0x8080808080808080ull;
+        //Setting the high bit first keeps each byte's subtraction from borrowing into the next byte
+        uint64_t aboveA = (word | high) - ones * 'A';
+        uint64_t aboveZ = (word | high) - ones * ('Z' + 1);
+        uint64_t upper = aboveA & ~aboveZ & ~word & high;
+        return word | (upper >> 2);
+    }
+private:
+    /// @brief the Source for plain memory
+    struct PointerSource{
+        const uint8_t* m_Data;
+        void Read(size_t at, void* out, size_t count) const HBUFF_NOEXCEPT{memcpy(out, m_Data + at, count);}
+    };
+
+    template<bool Lowercase, typename Source>
+    static uint64_t Legacy(const Source& source, size_t len, uint64_t seed) HBUFF_NOEXCEPT{
+        std::size_t hash = static_cast<std::size_t>(seed);
+        for(size_t i = 0; i < len; i++){
+            char c;
+            source.Read(i, &c, 1);
+            if(Lowercase && c >= 'A' && c <= 'Z')c += 'a' - 'A';
+            hash = hash * 31 + c;
+        }
+        return hash;
+    }
+
+    /// @brief p is the offset of the next unmixed byte in param source
+    template<bool Lowercase, typename Source>
+    static uint64_t Wy(const Source& source, size_t len, uint64_t seed) HBUFF_NOEXCEPT{
+        size_t p = 0;
+        seed ^= Mix(seed ^ s_Secret[0], s_Secret[1]);
+        uint64_t a, b;
+        if(len <= 16){
+            if(len >= 4){
+                size_t offset = (len >> 3) << 2;
+                a = (Read4<Lowercase>(source, p) << 32) | Read4<Lowercase>(source, p + offset);
+                b = (Read4<Lowercase>(source, p + len - 4) << 32) | Read4<Lowercase>(source, p + len - 4 - offset);
+            }
+            else if(len > 0){
+                a = Read3<Lowercase>(source, len);
+                b = 0;
+            }
+            else a = b = 0;
+        }
+        else{
+            size_t left = len;
+            if(left > 48){
+                uint64_t seed1 = seed;
+                uint64_t seed2 = seed;
+                do{
+                    seed = Mix(Read8<Lowercase>(source, p) ^ s_Secret[1], Read8<Lowercase>(source, p + 8) ^ seed);
+                    seed1 = Mix(Read8<Lowercase>(source, p + 16) ^ s_Secret[2], Read8<Lowercase>(source, p + 24) ^ seed1);
+                    seed2 = Mix(Read8<Lowercase>(source, p + 32) ^ s_Secret[3], Read8<Lowercase>(source, p + 40) ^ seed2);
+                    p += 48;
+                    left -= 48;
+                }while(left > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while(left > 16){
+                seed = Mix(Read8<Lowercase>(source, p) ^ s_Secret[1], Read8<Lowercase>(source, p + 8) ^ seed);
+                p += 16;
+                left -= 16;
+            }
+            //The last 16 bytes overlap what was already mixed instead of padding
+            a = Read8<Lowercase>(source, p + left - 16);
+            b = Read8<Lowercase>(source, p + left - 8);
+        }
+        a ^= s_Secret[1];
+        b ^= seed;
+        Multiply(a, b);
+        return Mix(a ^ s_Secret[0] ^ len, b ^ s_Secret[1]);
+    }
+
+    /// @brief replaces param a and param b with the low and high halves of a * b
+    static void Multiply(uint64_t& a, uint64_t& b) HBUFF_NOEXCEPT{
+    #if defined(__SIZEOF_INT128__)
+        __uint128_t result = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(result);
+        b = static_cast<uint64_t>(result >> 64);
+    #elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+    #else
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t carry = t < rl;
+        uint64_t low = t + (rm1 << 32);
+        carry += low < t;
+        a = low;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    #endif
+    }
+    static uint64_t Mix(uint64_t a, uint64_t b) HBUFF_NOEXCEPT{
+        Multiply(a, b);
+        return a ^ b;
+    }
+
+    template<bool Lowercase, typename Source>
+    static uint64_t Read8(const Source& source, size_t at) HBUFF_NOEXCEPT{
+        uint64_t value;
+        source.Read(at, &value, sizeof(value));
+        return Lowercase ? FoldCase(value) : value;
+    }
+    template<bool Lowercase, typename Source>
+    static uint64_t Read4(const Source& source, size_t at) HBUFF_NOEXCEPT{
+        uint32_t value;
+        source.Read(at, &value, sizeof(value));
+        return Lowercase ? FoldCase(value) : value;
+    }
+    /// @brief packs the first, middle and last byte of 1 to 3 bytes
+    template<bool Lowercase, typename Source>
+    static uint64_t Read3(const Source& source, size_t len) HBUFF_NOEXCEPT{
+        uint8_t first, middle, last;
+        source.Read(0, &first, 1);
+        source.Read(len >> 1, &middle, 1);
+        source.Read(len - 1, &last, 1);
+        uint64_t value = (static_cast<uint64_t>(first) << 16) | (static_cast<uint64_t>(middle) << 8) | last;
+        return Lowercase ? FoldCase(value) : value;
+    }
+private:
+    static constexpr uint64_t s_Secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+};
@@ -1,424 +1,464 @@
-#pragma once
-
-#include "HBuffer.hpp"
-
-class HBufferJoin{
-public:
-    HBufferJoin() HBUFF_NOEXCEPT{}
-    HBufferJoin(HBuffer& buff1, HBuffer& buff2) HBUFF_NOEXCEPT : m_Buffer1(buff1), m_Buffer2(buff2){}
-    HBufferJoin(HBuffer&& buff1) HBUFF_NOEXCEPT : m_Buffer1(buff1){}
-    HBufferJoin(HBuffer&& buff1, HBuffer&& buff2) HBUFF_NOEXCEPT : m_Buffer1(buff1), m_Buffer2(buff2){}
-    HBufferJoin(const HBufferJoin& join)noexcept{
-        m_Buffer1 = join.m_Buffer1;
-        m_Buffer2 = join.m_Buffer2;
-    }
-    HBufferJoin(HBufferJoin&& join)noexcept{
-        m_Buffer1 = std::move(join.m_Buffer1);
-        m_Buffer2 = std::move(join.m_Buffer2);
-    }
-    ~HBufferJoin(){}
-
-    /// @brief calls Free() on buffers
-    void Free() HBUFF_NOEXCEPT{
-        m_Buffer1.Free();
-        m_Buffer2.Free();
-    }
-    
-    HBuffer SubStringToDelim(char delimeter)const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t totalLength = len1 + len2;
-
-        size_t i = 0;
-        while(true){
-            if(i == len1)break;
-            if(str1[i] == delimeter)return SubString(0, i);
-            i++;
-        }
-
-        i = 0;
-        while(true){
-            if(i == len2)break;
-            if(str2[i] == delimeter)break;
-            i++;
-        }
-        //TODO: Do substringing inside
-        return SubString(0, i);
-    }
-    HBuffer SubString(size_t pos, size_t len=-1) const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t totalLength = len1 + len2;
-
-        if(pos >= totalLength)
-            return HBuffer(nullptr, 0, 0, false, false);
-        
-        len = std::min(totalLength - pos, len);
-
-        //size_t newLen1 = std::min(len, len1 - std::min(len1, pos));
-        size_t newLen1 = std::min(len, len1 - (pos >= len1 ? len1 : pos));
-        size_t newLen2 = std::min(len - newLen1, len2 - (pos >= len1 ? pos - len1: 0));
-        //size_t newLen2 = std::min(len2 - (pos >= len1 ? std::min(len2, pos - len1) : 0), len - len1);
-        size_t totalLen = newLen1 + newLen2;
-        char* str = new char[totalLen + 1];
-        
-        memcpy(str, str1 + pos, newLen1);
-        memcpy(str + newLen1, str2 + (pos <= len1 ? 0 : pos - len1), newLen2);
-        memset(str + totalLen, '\0', 1);
-        
-        return HBuffer(str, len, len + 1, true, true);
-    }
-    
-    HBuffer SubBuffer(size_t pos, size_t len) const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t totalLength = len1 + len2;
-        
-        if(pos >= totalLength)
-            return HBuffer(nullptr, 0, false, false);
-        len = std::min(totalLength - pos, len);
-
-        //Or maybe out of range exception
-        if(len < 1)return HBuffer(nullptr, 0, false, false);
-        size_t newLen1 = std::min(len, len1 - (pos >= len1 ? len1 : pos));
-        size_t newLen2 = std::min(len - newLen1, len2 - (pos >= len1 ? pos - len1 : 0));
-        size_t totalLen = newLen1 + newLen2;
-        char* str = new char[totalLen];
-
-        memcpy(str, str1 + pos, newLen1);
-        memcpy(str + newLen1, str2 + (pos <= len1 ? 0 : pos - len1), newLen2);
-        return HBuffer(str, len, true, true);
-    }
-public:
-    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = at, strPos = 0;
-        while(true){
-            if(strPos == len)return true;
-            if(i >= len1)break;
-            if(str[strPos] != str1[i])return false;
-            i++;
-            strPos++;
-        }
-
-        i-=len1;
-        while(true){
-            if(strPos == len)return true;
-            if(i >= len2)return false;
-            if(str[strPos] != str2[i])return false;
-            i++;
-            strPos++;
-        }
-        return true;
-    }
-    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
-        char* str1 = m_Buffer1.GetData();
-        char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t strPos = 0;
-        while(true){
-            if(strPos == len)return true;
-            if(at >= len1)break;
-            if(str[strPos] != str1[at])return false;
-            at++;
-            strPos++;
-        }
-
-        at-=len1;
-        while(true){
-            if(strPos == len)return true;
-            if(at >= len2)return false;
-            if(str[strPos] != str2[at])return false;
-            at++;
-            strPos++;
-        }
-        return true;
-    }
-    bool StartsWith(const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-
-        char* str1 = m_Buffer1.GetData();
-        char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-        while(true){
-            if(strPos == len)return true;
-            if(i == len1)break;
-            if(str[strPos] != str1[i])return false;
-            i++;
-            strPos++;
-        }
-
-        i=0;
-        while(true){
-            if(strPos == len)return true;
-            if(i == len2)return false;
-            if(str[strPos] != str2[i])return false;
-            i++;
-            strPos++;
-        }
-        return true;
-    }
-    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-        while(true){
-            if(strPos == len)return true;
-            if(i == len1)break;
-            if(str[strPos] != str1[i])return false;
-            i++;
-            strPos++;
-        }
-
-        i=0;
-        while(true){
-            if(strPos == len)return true;
-            if(i == len2)return false;
-            if(str[strPos] != str2[i])return false;
-            i++;
-            strPos++;
-        }
-
-        return true;
-    }
-    
-    ///@brief opies from buffers into dest.
-    ///@return returns 0 if success
-    int Memcpy(void* src, size_t len) const HBUFF_NOEXCEPT{
-        char* str1 = m_Buffer1.GetData();
-        char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len1)break;
-            str1[i] = static_cast<const char*>(src)[i];
-            i++;
-            strPos++;
-        }
-
-        i=0;
-        while(true){
-            if(strPos == len)break;
-            if(i == len2)return 1;
-            str1[i] = static_cast<const char*>(src)[i];
-            i++;
-            strPos++;
-        }
-        return 0;
-    }
-    int Memcpy(void* src, size_t offset, size_t len) const HBUFF_NOEXCEPT{
-        char* str1 = m_Buffer1.GetData();
-        char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = offset, strPos = 0;
-        while(true){
-            if(strPos == len)return 0;
-            if(i >= len1)break;
-            str1[i] = static_cast<const char*>(src)[i];
-            i++;
-            strPos++;
-        }
-
-        i-= len1;
-        while(true){
-            if(strPos == len)break;
-            if(i >= len2)return 1;
-            str1[i] = static_cast<const char*>(src)[i];
-            i++;
-            strPos++;
-        }
-        return 0;
-    }
-     ///@brief opies from buffers into dest.
-    ///@return returns 0 if success
-    int MemcpyTo(void* dest, size_t len) const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len1)break;
-            static_cast<char*>(dest)[i] = str1[i];
-            i++;
-            strPos++;
-        }
-
-        i=0;
-        while(true){
-            if(strPos == len)break;
-            if(i == len2)return 1;
-            static_cast<char*>(dest)[i] = str2[i];
-            i++;
-            strPos++;
-        }
-        return 0;
-    }
-    int MemcpyTo(void* dest, size_t offset, size_t len) const HBUFF_NOEXCEPT{
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = offset, strPos = 0;
-        while(true){
-            if(strPos == len)return 0;
-            if(i >= len1)break;
-            static_cast<char*>(dest)[strPos] = str1[i];
-            i++;
-            strPos++;
-        }
-
-        i-= len1;
-        while(true){
-            if(strPos == len)break;
-            if(i >= len2)return 1;
-            static_cast<char*>(dest)[strPos] = str2[i];
-            i++;
-            strPos++;
-        }
-        return 0;
-    }
-    /// @brief Compares param str with buffers combined as one to act as string
-    int StrCmp(const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len1)break;
-            if(str[strPos] != str1[i]){
-                return str1[i] - str[strPos];
-            }
-            i++;
-            strPos++;
-        }
-
-        i=0;
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len2 || str[strPos] != str2[i]){
-                return str2[i] - str[strPos];
-            }
-            i++;
-            strPos++;
-        }
-        return 0;
-    }
-    
-    /// @return returns 0 if success return -1 if buffer is out of data and 1 if data doesnt match
-    int StrXCmp(const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = 0, strPos = 0;
-
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len1)break;
-            if(str[strPos] != str1[i])return 1;
-            i++;
-            strPos++;
-        }
-
-        i-=len1;
-        while(true){
-            if(strPos == len)return 0;
-            if(i == len2)return -1;
-            if(str[strPos] != str2[i])return 1;
-            i++;
-            strPos++;
-        }
-    }
-    int StrXCmp(size_t at, const char* str) const HBUFF_NOEXCEPT{
-        size_t len = strlen(str);
-
-        const char* str1 = m_Buffer1.GetData();
-        const char* str2 = m_Buffer2.GetData();
-        size_t len1 = m_Buffer1.GetSize();
-        size_t len2 = m_Buffer2.GetSize();
-        size_t i = at, strPos = 0;
-
-        ///Use first buffer
-        while(true){
-            if(strPos == len)return 0;
-            if(i >= len1){
-                //i = 0;
-                break;
-            }
-            if(str[strPos] != str1[i])return 1;
-            i++;
-            strPos++;
-        }
-        i -= len1;
-        while(true){
-            if(strPos == len)return 0;
-            if(i >= len2)return -1;
-            if(str[strPos] != str2[i])return 1;
-            i++;
-            strPos++;
-        }
-    }
-public:
-    HBufferJoin& operator=(const HBufferJoin& right)noexcept{
-        m_Buffer1 = right.m_Buffer1;
-        m_Buffer2 = right.m_Buffer2;
-        return *this;
-    }
-    HBufferJoin& operator=(HBufferJoin&& right)noexcept{
-        m_Buffer1 = std::move(right.m_Buffer1);
-        m_Buffer2 = std::move(right.m_Buffer2);
-        return *this;
-    }
-public:
-    /// @brief attempts to get the byte from the join at index i. Does not do safety checks so there is segfault potential.
-    /// @return returns the character at i.
-    char At(size_t i) const HBUFF_NOEXCEPT{
-        if(i < m_Buffer1.m_Size)return m_Buffer1.m_Data[i];
-        return m_Buffer2.m_Data[i - m_Buffer1.m_Size];
-    }
-    /// @brief same as function At(size_t i) except we have safety checks where if out of range we return '\0'
-    /// @return returns the character at i. returns '\0' if out of range of buffers
-    char Get(size_t i) const HBUFF_NOEXCEPT{
-        if(i < m_Buffer1.m_Size)return m_Buffer1.m_Data[i];
-        if(i >= m_Buffer1.m_Size + m_Buffer2.m_Size)return '\0';
-        return m_Buffer2.m_Data[i - m_Buffer1.m_Size];
-    }
-public:
-    HBUFF_CONSTEXPR HBuffer& GetBuffer1() const HBUFF_NOEXCEPT{return (HBuffer&)m_Buffer1;}
-    HBUFF_CONSTEXPR HBuffer& GetBuffer2() const HBUFF_NOEXCEPT{return (HBuffer&)m_Buffer2;}
-    HBUFF_CONSTEXPR size_t GetSize() const HBUFF_NOEXCEPT{return m_Buffer1.GetSize() + m_Buffer2.GetSize();}
-private:
-    HBuffer m_Buffer1;
-    HBuffer m_Buffer2;
+#pragma once
+
+#include "HBuffer.hpp"
+#include "HBufferScatter.hpp"
+
+class HBufferJoin{
+public:
+    HBufferJoin() HBUFF_NOEXCEPT{}
+    HBufferJoin(HBuffer& buff1, HBuffer& buff2) HBUFF_NOEXCEPT : m_Buffer1(buff1), m_Buffer2(buff2){}
+    HBufferJoin(HBuffer&& buff1) HBUFF_NOEXCEPT : m_Buffer1(buff1){}
+    HBufferJoin(HBuffer&& buff1, HBuffer&& buff2) HBUFF_NOEXCEPT : m_Buffer1(buff1), m_Buffer2(buff2){}
+    HBufferJoin(const HBufferJoin& join)noexcept{
+        m_Buffer1 = join.m_Buffer1;
+        m_Buffer2 = join.m_Buffer2;
+    }
+    HBufferJoin(HBufferJoin&& join)noexcept{
+        m_Buffer1 = std::move(join.m_Buffer1);
+        m_Buffer2 = std::move(join.m_Buffer2);
+    }
+    ~HBufferJoin(){}
+
+    /// @brief calls Free() on buffers
+    void Free() HBUFF_NOEXCEPT{
+        m_Buffer1.Free();
+        m_Buffer2.Free();
+    }
+    
+    /// @brief copies everything before the first param delimeter. If there is no delimeter we copy the whole join
+    HBuffer SubStringToDelim(char delimeter)const HBUFF_NOEXCEPT{
+        return SubString(0, Find(delimeter));
+    }
+    HBuffer SubString(size_t pos, size_t len=-1) const HBUFF_NOEXCEPT{
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t totalLength = len1 + len2;
+
+        if(pos >= totalLength)
+            return HBuffer(nullptr, 0, 0, false, false);
+        
+        len = std::min(totalLength - pos, len);
+
+        //size_t newLen1 = std::min(len, len1 - std::min(len1, pos));
+        size_t newLen1 = std::min(len, len1 - (pos >= len1 ? len1 : pos));
+        size_t newLen2 = std::min(len - newLen1, len2 - (pos >= len1 ? pos - len1: 0));
+        //size_t newLen2 = std::min(len2 - (pos >= len1 ? std::min(len2, pos - len1) : 0), len - len1);
+        size_t totalLen = newLen1 + newLen2;
+        HBuffer buffer;
+        buffer.ReserveString(totalLen);
+        char* str = buffer.m_Data;
+        
+        memcpy(str, str1 + pos, newLen1);
+        memcpy(str + newLen1, str2 + (pos <= len1 ? 0 : pos - len1), newLen2);
+        memset(str + totalLen, '\0', 1);
+        buffer.m_Size = totalLen;
+        
+        return buffer;
+    }
+    
+    HBuffer SubBuffer(size_t pos, size_t len) const HBUFF_NOEXCEPT{
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t totalLength = len1 + len2;
+        
+        if(pos >= totalLength)
+            return HBuffer(nullptr, 0, false, false);
+        len = std::min(totalLength - pos, len);
+
+        //Or maybe out of range exception
+        if(len < 1)return HBuffer(nullptr, 0, false, false);
+        size_t newLen1 = std::min(len, len1 - (pos >= len1 ? len1 : pos));
+        size_t newLen2 = std::min(len - newLen1, len2 - (pos >= len1 ? pos - len1 : 0));
+        size_t totalLen = newLen1 + newLen2;
+        HBuffer buffer;
+        buffer.Reserve(totalLen);
+        char* str = buffer.m_Data;
+
+        memcpy(str, str1 + pos, newLen1);
+        memcpy(str + newLen1, str2 + (pos <= len1 ? 0 : pos - len1), newLen2);
+        buffer.m_Size = totalLen;
+        return buffer;
+    }
+public:
+    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{
+        size_t len = strlen(str);
+
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = at, strPos = 0;
+        while(true){
+            if(strPos == len)return true;
+            if(i >= len1)break;
+            if(str[strPos] != str1[i])return false;
+            i++;
+            strPos++;
+        }
+
+        i-=len1;
+        while(true){
+            if(strPos == len)return true;
+            if(i >= len2)return false;
+            if(str[strPos] != str2[i])return false;
+            i++;
+            strPos++;
+        }
+        return true;
+    }
+    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
+        char* str1 = m_Buffer1.GetData();
+        char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t strPos = 0;
+        while(true){
+            if(strPos == len)return true;
+            if(at >= len1)break;
+            if(str[strPos] != str1[at])return false;
+            at++;
+            strPos++;
+        }
+
+        at-=len1;
+        while(true){
+            if(strPos == len)return true;
+            if(at >= len2)return false;
+            if(str[strPos] != str2[at])return false;
+            at++;
+            strPos++;
+        }
+        return true;
+    }
+    bool StartsWith(const char* str) const HBUFF_NOEXCEPT{
+        size_t len = strlen(str);
+
+        char* str1 = m_Buffer1.GetData();
+        char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = 0, strPos = 0;
+        while(true){
+            if(strPos == len)return true;
+            if(i == len1)break;
+            if(str[strPos] != str1[i])return false;
+            i++;
+            strPos++;
+        }
+
+        i=0;
+        while(true){
+            if(strPos == len)return true;
+            if(i == len2)return false;
+            if(str[strPos] != str2[i])return false;
+            i++;
+            strPos++;
+        }
+        return true;
+    }
+    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = 0, strPos = 0;
+        while(true){
+            if(strPos == len)return true;
+            if(i == len1)break;
+            if(str[strPos] != str1[i])return false;
+            i++;
+            strPos++;
+        }
+
+        i=0;
+        while(true){
+            if(strPos == len)return true;
+            if(i == len2)return false;
+            if(str[strPos] != str2[i])return false;
+            i++;
+            strPos++;
+        }
+
+        return true;
+    }
+    
+    /// @brief finds the first param c at or after param from across both buffers
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t Find(char c, size_t from = 0) const HBUFF_NOEXCEPT{
+        size_t len1 = m_Buffer1.GetSize();
+        if(from < len1){
+            size_t found = m_Buffer1.Find(c, from);
+            if(found != HBUFF_NPOS)return found;
+        }
+        size_t found = m_Buffer2.Find(c, from > len1 ? from - len1 : 0);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : len1 + found;
+    }
+    /// @brief finds the first occurrence of param str at or after param from. Matches may span both buffers
+    /// @return returns the index the match starts at in the join or HBUFF_NPOS if not found
+    size_t Find(const char* str, size_t len, size_t from = 0) const HBUFF_NOEXCEPT{
+        size_t len1 = m_Buffer1.GetSize();
+        if(len < 1)return from <= GetSize() ? from : HBUFF_NPOS;
+        if(from < len1){
+            size_t found = m_Buffer1.Find(str, len, from);
+            if(found != HBUFF_NPOS)return found;
+            //Only the starts within len - 1 bytes of the end of buffer 1 can still match across the boundary
+            size_t at = std::max(from, len1 >= len ? len1 - len + 1 : 0);
+            for(; at < len1; at++){
+                at = m_Buffer1.Find(str[0], at);
+                if(at == HBUFF_NPOS)break;
+                if(StartsWith(at, str, len))return at;
+            }
+        }
+        size_t found = m_Buffer2.Find(str, len, from > len1 ? from - len1 : 0);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : len1 + found;
+    }
+    /// @brief finds the first occurrence of the null terminated param str
+    size_t Find(const char* str) const HBUFF_NOEXCEPT{
+        return Find(str, strlen(str));
+    }
+    /// @brief finds the last param c across both buffers
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t FindLast(char c) const HBUFF_NOEXCEPT{
+        size_t found = m_Buffer2.FindLast(c);
+        if(found != HBUFF_NPOS)return m_Buffer1.GetSize() + found;
+        return m_Buffer1.FindLast(c);
+    }
+    /// @brief finds the first byte at or after param from that is any of the bytes in param set
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t FindFirstOf(const char* set, size_t setLen, size_t from = 0) const HBUFF_NOEXCEPT{
+        size_t len1 = m_Buffer1.GetSize();
+        if(from < len1){
+            size_t found = m_Buffer1.FindFirstOf(set, setLen, from);
+            if(found != HBUFF_NPOS)return found;
+        }
+        size_t found = m_Buffer2.FindFirstOf(set, setLen, from > len1 ? from - len1 : 0);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : len1 + found;
+    }
+    
+    ///@brief opies from buffers into dest.
+    ///@return returns 0 if success
+    int Memcpy(void* src, size_t len) const HBUFF_NOEXCEPT{
+        char* str1 = m_Buffer1.GetData();
+        char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = 0, strPos = 0;
+        while(true){
+            if(strPos == len)return 0;
+            if(i == len1)break;
+            str1[i] = static_cast<const char*>(src)[i];
+            i++;
+            strPos++;
+        }
+
+        i=0;
+        while(true){
+            if(strPos == len)break;
+            if(i == len2)return 1;
+            str1[i] = static_cast<const char*>(src)[i];
+            i++;
+            strPos++;
+        }
+        return 0;
+    }
+    int Memcpy(void* src, size_t offset, size_t len) const HBUFF_NOEXCEPT{
+        char* str1 = m_Buffer1.GetData();
+        char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = offset, strPos = 0;
+        while(true){
+            if(strPos == len)return 0;
+            if(i >= len1)break;
+            str1[i] = static_cast<const char*>(src)[i];
+            i++;
+            strPos++;
+        }
+
+        i-= len1;
+        while(true){
+            if(strPos == len)break;
+            if(i >= len2)return 1;
+            str1[i] = static_cast<const char*>(src)[i];
+            i++;
+            strPos++;
+        }
+        return 0;
+    }
+     ///@brief opies from buffers into dest.
+    ///@return returns 0 if success
+    int MemcpyTo(void* dest, size_t len) const HBUFF_NOEXCEPT{
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = 0, strPos = 0;
+        while(true){
+            if(strPos == len)return 0;
+            if(i == len1)break;
+            static_cast<char*>(dest)[i] = str1[i];
+            i++;
+            strPos++;
+        }
+
+        i=0;
+        while(true){
+            if(strPos == len)break;
+            if(i == len2)return 1;
+            static_cast<char*>(dest)[i] = str2[i];
+            i++;
+            strPos++;
+        }
+        return 0;
+    }
+    int MemcpyTo(void* dest, size_t offset, size_t len) const HBUFF_NOEXCEPT{
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = offset, strPos = 0;
+        while(true){
+            if(strPos == len)return 0;
+            if(i >= len1)break;
+            static_cast<char*>(dest)[strPos] = str1[i];
+            i++;
+            strPos++;
+        }
+
+        i-= len1;
+        while(true){
+            if(strPos == len)break;
+            if(i >= len2)return 1;
+            static_cast<char*>(dest)[strPos] = str2[i];
+            i++;
+            strPos++;
+        }
+        return 0;
+    }
+    /// @brief Compares param str with buffers combined as one to act as string
+    int StrCmp(const char* str) const HBUFF_NOEXCEPT{
+        size_t len = strlen(str);
+
+        const char* str1 = m_Buffer1.GetData();
+        const char* str2 = m_Buffer2.GetData();
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+        size_t i = 0, strPos = 0;
+
+        while(true){
+            if(strPos == len)return 0;
+            if(i == len1)break;
+            if(str[strPos] != str1[i]){
+                return str1[i] - str[strPos];
+            }
+            i++;
+            strPos++;
+        }
+
+        i=0;
+        while(true){
+            if(strPos == len)return 0;
+            if(i == len2 || str[strPos] != str2[i]){
+                return str2[i] - str[strPos];
+            }
+            i++;
+            strPos++;
+        }
+        return 0;
+    }
+    
+    /// @return returns 0 if success return -1 if buffer is out of data and 1 if data doesnt match
+    int StrXCmp(const char* str) const HBUFF_NOEXCEPT{
+        return StrXCmp(0, str);
+    }
+    int StrXCmp(size_t at, const char* str) const HBUFF_NOEXCEPT{
+        size_t len = strlen(str);
+        size_t len1 = m_Buffer1.GetSize();
+        size_t len2 = m_Buffer2.GetSize();
+
+        ///Use first buffer
+        if(at < len1){
+            size_t count = std::min(len, len1 - at);
+            if(!HBufferSimd::Equals(m_Buffer1.GetData() + at, str, count))return 1;
+            str += count;
+            len -= count;
+            at = 0;
+        }
+        else at -= len1;
+        if(len == 0)return 0;
+
+        if(at >= len2)return -1;
+        size_t count = std::min(len, len2 - at);
+        if(!HBufferSimd::Equals(m_Buffer2.GetData() + at, str, count))return 1;
+        return count == len ? 0 : -1;
+    }
+    /// @brief makes both buffers safe to write into without changing any other buffer. See HBuffer::Detach
+    void Detach() HBUFF_NOEXCEPT{
+        m_Buffer1.Detach();
+        m_Buffer2.Detach();
+    }
+    /// @brief drops the first param len bytes. See HBuffer::RemovePrefix
+    void RemovePrefix(size_t len) HBUFF_NOEXCEPT{
+        size_t first = std::min(len, m_Buffer1.GetSize());
+        m_Buffer1.RemovePrefix(first);
+        m_Buffer2.RemovePrefix(len - first);
+    }
+#if !defined(_WIN32)
+    /// @brief points up to param max iovecs at the bytes starting at param at, one per non empty buffer
+    /// @return returns the amount of iovecs filled
+    size_t GetIOVecs(iovec* vecs, size_t max, size_t at = 0) const HBUFF_NOEXCEPT{
+        size_t count = 0;
+        size_t len1 = m_Buffer1.GetSize();
+        if(at < len1 && count < max)vecs[count++] = iovec{m_Buffer1.GetData() + at, len1 - at};
+        size_t at2 = at > len1 ? at - len1 : 0;
+        if(at2 < m_Buffer2.GetSize() && count < max)vecs[count++] = iovec{m_Buffer2.GetData() + at2, m_Buffer2.GetSize() - at2};
+        return count;
+    }
+    /// @brief writes the join to param fd with writev and removes what was written from the front. See HBufferScatter::WriteTo
+    ssize_t WriteTo(int fd) HBUFF_NOEXCEPT{
+        return HBufferScatter::WriteTo(fd, *this);
+    }
+    /// @brief reads from param fd into the join's bytes with readv, first buffer first. See HBufferScatter::ReadFrom
+    ssize_t ReadFrom(int fd) HBUFF_NOEXCEPT{
+        return HBufferScatter::ReadFrom(fd, *this);
+    }
+#endif
+public:
+    HBufferJoin& operator=(const HBufferJoin& right)noexcept{
+        m_Buffer1 = right.m_Buffer1;
+        m_Buffer2 = right.m_Buffer2;
+        return *this;
+    }
+    HBufferJoin& operator=(HBufferJoin&& right)noexcept{
+        m_Buffer1 = std::move(right.m_Buffer1);
+        m_Buffer2 = std::move(right.m_Buffer2);
+        return *this;
+    }
+public:
+    /// @brief attempts to get the byte from the join at index i. Does not do safety checks so there is segfault potential.
+    /// @return returns the character at i.
+    char At(size_t i) const HBUFF_NOEXCEPT{
+        if(i < m_Buffer1.m_Size)return m_Buffer1.m_Data[i];
+        return m_Buffer2.m_Data[i - m_Buffer1.m_Size];
+    }
+    /// @brief same as function At(size_t i) except we have safety checks where if out of range we return '\0'
+    /// @return returns the character at i. returns '\0' if out of range of buffers
+    char Get(size_t i) const HBUFF_NOEXCEPT{
+        if(i < m_Buffer1.m_Size)return m_Buffer1.m_Data[i];
+        if(i >= m_Buffer1.m_Size + m_Buffer2.m_Size)return '\0';
+        return m_Buffer2.m_Data[i - m_Buffer1.m_Size];
+    }
+public:
+    HBUFF_CONSTEXPR HBuffer& GetBuffer1() const HBUFF_NOEXCEPT{return (HBuffer&)m_Buffer1;}
+    HBUFF_CONSTEXPR HBuffer& GetBuffer2() const HBUFF_NOEXCEPT{return (HBuffer&)m_Buffer2;}
+    HBUFF_CONSTEXPR size_t GetSize() const HBUFF_NOEXCEPT{return m_Buffer1.GetSize() + m_Buffer2.GetSize();}
+private:
+    HBuffer m_Buffer1;
+    HBuffer m_Buffer2;
 };
\ No newline at end of file
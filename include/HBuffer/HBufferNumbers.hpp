@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Core.h"
+#include <charconv>
+#include <limits>
+#include <type_traits>
+
+/// Base 10 conversion between numbers and ascii used by HBuffer. Everything works on raw pointers so it can write straight into a buffer's storage.
+/// Integers are formatted two digits per step from a table and parsed eight digits per step with SWAR (SIMD within a register) when the host is little endian.
+/// Floating point goes through std::to_chars/std::from_chars which give the shortest string that round trips and correctly rounded parsing.
+struct HBufferNumbers{
+public:
+    /// @brief the most characters Format can write for a T. Includes the sign but not a null terminator
+    template<typename T>
+    static constexpr size_t GetMaxChars() HBUFF_NOEXCEPT{
+        return std::is_floating_point<T>::value ? 32 : std::numeric_limits<T>::digits10 + 2;
+    }
+
+    /// @brief writes param value to param out. out must have room for GetMaxChars<T>() characters
+    /// @return returns the amount of characters written
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    static size_t Format(char* out, T value) HBUFF_NOEXCEPT{
+        if(std::is_signed<T>::value && value < 0){
+            *out = '-';
+            //Negating as unsigned keeps the smallest value from overflowing
+            return 1 + FormatUnsigned(out + 1, 0 - static_cast<uint64_t>(value));
+        }
+        return FormatUnsigned(out, static_cast<uint64_t>(value));
+    }
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    static size_t Format(char* out, T value) HBUFF_NOEXCEPT{
+        return std::to_chars(out, out + GetMaxChars<T>(), value).ptr - out;
+    }
+
+    /// @brief parses all param len characters of param str as a base 10 number. Signed types accept a leading '-'
+    /// @return returns false if str is empty, has anything that is not part of the number or does not fit in a T. output is left untouched in that case
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    static bool Parse(const char* str, size_t len, T& output) HBUFF_NOEXCEPT{
+        bool negative = std::is_signed<T>::value && len > 0 && str[0] == '-';
+        uint64_t value;
+        if(!ParseUnsigned(str + negative, len - negative, value))return false;
+        uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative;
+        if(value > limit)return false;
+        output = negative ? static_cast<T>(0 - value) : static_cast<T>(value);
+        return true;
+    }
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    static bool Parse(const char* str, size_t len, T& output) HBUFF_NOEXCEPT{
+        T value;
+        std::from_chars_result result = std::from_chars(str, str + len, value);
+        if(result.ec != std::errc() || result.ptr != str + len || len < 1)return false;
+        output = value;
+        return true;
+    }
+
+    /// @return returns the amount of base 10 digits in param value
+    static size_t CountDigits(uint64_t value) HBUFF_NOEXCEPT{
+        size_t count = 1;
+        while(true){
+            if(value < 10)return count;
+            if(value < 100)return count + 1;
+            if(value < 1000)return count + 2;
+            if(value < 10000)return count + 3;
+            value /= 10000;
+            count += 4;
+        }
+    }
+    /// @brief writes param value to param out two digits at a time starting from the end
+    /// @return returns the amount of characters written
+    static size_t FormatUnsigned(char* out, uint64_t value) HBUFF_NOEXCEPT{
+        size_t count = CountDigits(value);
+        char* at = out + count;
+        while(value >= 100){
+            at -= 2;
+            memcpy(at, GetDigitPairs() + (value % 100) * 2, 2);
+            value /= 100;
+        }
+        if(value >= 10){
+            at -= 2;
+            memcpy(at, GetDigitPairs() + value * 2, 2);
+        }
+        else *--at = static_cast<char>('0' + value);
+        return count;
+    }
+    /// @brief parses exactly param len digits
+    /// @return returns false if len is 0, a character is not a digit or the value does not fit in 64 bits
+    static bool ParseUnsigned(const char* str, size_t len, uint64_t& output) HBUFF_NOEXCEPT{
+        if(len < 1)return false;
+        uint64_t value = 0;
+        size_t i = 0;
+    #if defined(HBUFF_HOST_LITTLE_ENDIAN)
+        //16 digits always fit so only the last few need overflow checks
+        while(i + 8 <= len && i < 16){
+            uint64_t chunk;
+            memcpy(&chunk, str + i, 8);
+            if(!IsEightDigits(chunk))return false;
+            value = value * 100000000 + ParseEightDigits(chunk);
+            i += 8;
+        }
+    #endif
+        for(; i < len; i++){
+            uint64_t digit = static_cast<unsigned char>(str[i] - '0');
+            if(digit > 9)return false;
+            if(value > (std::numeric_limits<uint64_t>::max() - digit) / 10)return false;
+            value = value * 10 + digit;
+        }
+        output = value;
+        return true;
+    }
+private:
+    static const char* GetDigitPairs() HBUFF_NOEXCEPT{
+        static const char pairs[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+        return pairs;
+    }
+    /// @brief every byte is in '0'-'9' when its high nibble is 3 and adding 6 does not carry out of the low nibble
+    static bool IsEightDigits(uint64_t chunk) HBUFF_NOEXCEPT{
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+    /// @brief combines 8 digits into pairs, then fours, then the full value with three multiplies
+    static uint64_t ParseEightDigits(uint64_t chunk) HBUFF_NOEXCEPT{
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+        chunk = (chunk & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+        return (chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32;
+    }
+};
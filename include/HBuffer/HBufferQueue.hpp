@@ -0,0 +1,116 @@
+#pragma once
+
+#include "HBuffer.hpp"
+
+/// @brief Bounded lock free queue with one producer thread and one consumer thread.
+/// @brief Buffers are moved into preallocated slots so pushing never allocates and ownership goes with the buffer.
+/// @brief Each side keeps a cached copy of the other side's counter and only reloads it when the queue looks full or empty.
+/// @brief A buffer's data goes back to its allocator on the consumer thread, so buffers from an allocator that is not thread safe (see HBufferAllocator::IsThreadSafe) must be made shared before they are pushed
+class HBufferSpscQueue{
+public:
+    /// @param capacity rounded up to a power of two
+    explicit HBufferSpscQueue(size_t capacity) HBUFF_NOEXCEPT
+        : m_Capacity(HBufferRoundUpPowerOfTwo(std::max<size_t>(capacity, 2))), m_Slots(new HBuffer[m_Capacity]){}
+    HBufferSpscQueue(const HBufferSpscQueue&) = delete;
+    HBufferSpscQueue& operator=(const HBufferSpscQueue&) = delete;
+
+    /// @brief moves param buffer into the queue. Producer thread only
+    /// @return returns false if the queue is full. param buffer is left untouched in that case
+    bool TryPush(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if(tail - m_HeadCache >= m_Capacity){
+            m_HeadCache = m_Head.load(std::memory_order_acquire);
+            if(tail - m_HeadCache >= m_Capacity)return false;
+        }
+        m_Slots[tail & (m_Capacity - 1)] = std::move(buffer);
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /// @brief moves the oldest buffer into param buffer. Consumer thread only
+    /// @return returns false if the queue is empty. param buffer is left untouched in that case
+    bool TryPop(HBuffer& buffer) HBUFF_NOEXCEPT{
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        if(head == m_TailCache){
+            m_TailCache = m_Tail.load(std::memory_order_acquire);
+            if(head == m_TailCache)return false;
+        }
+        buffer = std::move(m_Slots[head & (m_Capacity - 1)]);
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+public:
+    size_t GetCapacity() const HBUFF_NOEXCEPT{return m_Capacity;}
+    /// @brief returns how many buffers are queued. Only a snapshot while the other thread is running
+    size_t GetSize() const HBUFF_NOEXCEPT{
+        return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+    }
+private:
+    const size_t m_Capacity;
+    std::unique_ptr<HBuffer[]> m_Slots;
+    /// @brief consumer side. The next slot to pop and the last m_Tail it saw
+    alignas(HBUFF_CACHE_LINE_SIZE) std::atomic<size_t> m_Head{0};
+    size_t m_TailCache = 0;
+    /// @brief producer side. The next slot to push and the last m_Head it saw
+    alignas(HBUFF_CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{0};
+    size_t m_HeadCache = 0;
+};
+
+/// @brief Bounded lock free queue with any amount of producer threads and one consumer thread.
+/// @brief Every slot carries a sequence number that says whose turn it is. Producers claim a slot with a compare exchange and the consumer needs no atomic read modify writes.
+/// @brief Like HBufferSpscQueue buffers are moved into preallocated slots so pushing never allocates, and buffers from an allocator that is not thread safe must be made shared before they are pushed.
+class HBufferMpscQueue{
+public:
+    /// @param capacity rounded up to a power of two
+    explicit HBufferMpscQueue(size_t capacity) HBUFF_NOEXCEPT
+        : m_Capacity(HBufferRoundUpPowerOfTwo(std::max<size_t>(capacity, 2))), m_Slots(new Slot[m_Capacity]){
+        for(size_t i = 0; i < m_Capacity; i++)m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+    }
+    HBufferMpscQueue(const HBufferMpscQueue&) = delete;
+    HBufferMpscQueue& operator=(const HBufferMpscQueue&) = delete;
+
+    /// @brief moves param buffer into the queue. Any thread
+    /// @return returns false if the queue is full. param buffer is left untouched in that case
+    bool TryPush(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while(true){
+            slot = &m_Slots[tail & (m_Capacity - 1)];
+            size_t sequence = slot->m_Sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(tail);
+            if(difference == 0){
+                if(m_Tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))break;
+            }
+            //The consumer has not emptied this slot since the last lap so the queue is full
+            else if(difference < 0)return false;
+            else tail = m_Tail.load(std::memory_order_relaxed);
+        }
+        slot->m_Buffer = std::move(buffer);
+        slot->m_Sequence.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /// @brief moves the oldest buffer into param buffer. Consumer thread only
+    /// @return returns false if the queue is empty or the oldest push has claimed its slot but not finished writing it
+    bool TryPop(HBuffer& buffer) HBUFF_NOEXCEPT{
+        Slot& slot = m_Slots[m_Head & (m_Capacity - 1)];
+        if(slot.m_Sequence.load(std::memory_order_acquire) != m_Head + 1)return false;
+        buffer = std::move(slot.m_Buffer);
+        //Hands the slot to the producer that pushes one lap from now
+        slot.m_Sequence.store(m_Head + m_Capacity, std::memory_order_release);
+        m_Head++;
+        return true;
+    }
+public:
+    size_t GetCapacity() const HBUFF_NOEXCEPT{return m_Capacity;}
+private:
+    struct Slot{
+        std::atomic<size_t> m_Sequence;
+        HBuffer m_Buffer;
+    };
+private:
+    const size_t m_Capacity;
+    std::unique_ptr<Slot[]> m_Slots;
+    /// @brief next slot a producer claims
+    alignas(HBUFF_CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{0};
+    /// @brief next slot the consumer pops. Only the consumer touches it
+    alignas(HBUFF_CACHE_LINE_SIZE) size_t m_Head = 0;
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "HBuffer.hpp"
+#include "HBufferJoin.hpp"
+
+/// @brief Fixed capacity ring of bytes for streaming. Writers fill the free spans and Commit, readers look at the readable spans and Consume. Neither copies.
+/// @brief The capacity is a power of two so wrapping is a mask. Data that wraps shows up as two spans in an HBufferJoin.
+/// @brief In double mapped mode the memory is mapped twice back to back so readable and free data are always one contiguous span. Linux only, falls back to the normal mode elsewhere.
+/// @brief Spans are views into the ring and are invalidated by Commit/Consume. Not thread safe.
+class HBufferRing{
+public:
+    /// @param capacity rounded up to a power of two, and to the page size when double mapped
+    /// @param doubleMapped tries to map the memory twice. See IsDoubleMapped for whether it worked
+    /// @param allocator where the memory comes from when not double mapped. nullptr uses the thread default allocator or the heap
+    explicit HBufferRing(size_t capacity, bool doubleMapped = false, HBufferAllocator* allocator = nullptr) HBUFF_NOEXCEPT : m_Storage(allocator){
+        m_Capacity = HBufferRoundUpPowerOfTwo(std::max<size_t>(capacity, 1));
+    #if defined(__linux__)
+        if(doubleMapped){
+            size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t mapped = std::max(m_Capacity, page);
+            char* data = MapTwice(mapped);
+            if(data){
+                m_Capacity = mapped;
+                m_Storage = HBuffer::Adopt(data, mapped * 2, &UnmapTwice, nullptr, true, allocator);
+                m_DoubleMapped = true;
+            }
+        }
+    #else
+        (void)doubleMapped;
+    #endif
+        if(!m_DoubleMapped)m_Storage.Reserve(m_Capacity);
+        m_Data = m_Storage.GetData();
+    }
+    HBufferRing(const HBufferRing&) = delete;
+    HBufferRing& operator=(const HBufferRing&) = delete;
+
+#pragma region Write
+    /// @brief returns the free space as up to two writable spans. Fill them front to back then Commit
+    HBufferJoin GetWriteSpans() HBUFF_NOEXCEPT{
+        size_t at = m_Write & (m_Capacity - 1);
+        size_t free = GetFree();
+        size_t first = m_DoubleMapped ? free : std::min(free, m_Capacity - at);
+        return HBufferJoin(View(at, first, true), View(0, free - first, true));
+    }
+    /// @brief returns the free space up to the end of the memory, or all of it when double mapped
+    HBuffer GetWriteSpan() HBUFF_NOEXCEPT{
+        size_t at = m_Write & (m_Capacity - 1);
+        return View(at, m_DoubleMapped ? GetFree() : std::min(GetFree(), m_Capacity - at), true);
+    }
+    /// @brief marks param len bytes written into the write spans as readable
+    void Commit(size_t len) HBUFF_NOEXCEPT{
+        m_Write += std::min(len, GetFree());
+    }
+    /// @brief copies as much of param data as fits and commits it
+    /// @return returns the amount of bytes written
+    size_t Write(const char* data, size_t len) HBUFF_NOEXCEPT{
+        len = std::min(len, GetFree());
+        CopyIn(m_Write & (m_Capacity - 1), data, len);
+        m_Write += len;
+        return len;
+    }
+    size_t Write(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        return Write(buffer.GetData(), buffer.GetSize());
+    }
+#pragma endregion
+#pragma region Read
+    /// @brief returns the readable data as up to two spans
+    HBufferJoin GetReadSpans() const HBUFF_NOEXCEPT{
+        size_t at = m_Read & (m_Capacity - 1);
+        size_t size = GetSize();
+        size_t first = m_DoubleMapped ? size : std::min(size, m_Capacity - at);
+        return HBufferJoin(View(at, first, false), View(0, size - first, false));
+    }
+    /// @brief returns the readable data up to the end of the memory, or all of it when double mapped
+    HBuffer GetReadSpan() const HBUFF_NOEXCEPT{
+        size_t at = m_Read & (m_Capacity - 1);
+        return View(at, m_DoubleMapped ? GetSize() : std::min(GetSize(), m_Capacity - at), false);
+    }
+    /// @brief drops the first param len readable bytes
+    void Consume(size_t len) HBUFF_NOEXCEPT{
+        m_Read += std::min(len, GetSize());
+    }
+    /// @brief copies up to param len readable bytes into param dest without consuming them
+    /// @return returns the amount of bytes copied
+    size_t Peek(char* dest, size_t len) const HBUFF_NOEXCEPT{
+        len = std::min(len, GetSize());
+        CopyOut(dest, m_Read & (m_Capacity - 1), len);
+        return len;
+    }
+    /// @brief copies up to param len readable bytes into param dest and consumes them
+    size_t Read(char* dest, size_t len) HBUFF_NOEXCEPT{
+        len = Peek(dest, len);
+        m_Read += len;
+        return len;
+    }
+    /// @brief returns the readable byte at param at or \0 if out of range
+    char Get(size_t at) const HBUFF_NOEXCEPT{
+        if(at >= GetSize())return '\0';
+        return m_Data[(m_Read + at) & (m_Capacity - 1)];
+    }
+    /// @brief finds param c in the readable data
+    /// @return returns the offset from the read position or HBUFF_NPOS
+    size_t Find(char c, size_t from = 0) const HBUFF_NOEXCEPT{
+        return GetReadSpans().Find(c, from);
+    }
+    /// @brief finds param str in the readable data. Matches may wrap around the end of the memory
+    size_t Find(const char* str, size_t len, size_t from = 0) const HBUFF_NOEXCEPT{
+        return GetReadSpans().Find(str, len, from);
+    }
+    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return len <= GetSize() && GetReadSpans().StartsWith(0, str, len);
+    }
+#pragma endregion
+#if !defined(_WIN32)
+    /// @brief reads from param fd straight into the free space with readv and commits what arrived
+    /// @return same as HBufferScatter::Read
+    ssize_t ReadFrom(int fd) HBUFF_NOEXCEPT{
+        ssize_t read = GetWriteSpans().ReadFrom(fd);
+        if(read > 0)Commit(read);
+        return read;
+    }
+    /// @brief writes the readable data to param fd with writev and consumes what went out
+    /// @return same as HBufferScatter::Write
+    ssize_t WriteTo(int fd) HBUFF_NOEXCEPT{
+        HBufferJoin spans = GetReadSpans();
+        ssize_t written = spans.WriteTo(fd);
+        if(written > 0)Consume(written);
+        return written;
+    }
+#endif
+public:
+    /// @brief drops everything readable
+    void Clear() HBUFF_NOEXCEPT{
+        m_Read = 0;
+        m_Write = 0;
+    }
+    /// @brief returns the amount of readable bytes
+    size_t GetSize() const HBUFF_NOEXCEPT{return m_Write - m_Read;}
+    size_t GetFree() const HBUFF_NOEXCEPT{return m_Capacity - GetSize();}
+    size_t GetCapacity() const HBUFF_NOEXCEPT{return m_Capacity;}
+    bool IsEmpty() const HBUFF_NOEXCEPT{return m_Write == m_Read;}
+    bool IsFull() const HBUFF_NOEXCEPT{return GetSize() == m_Capacity;}
+    bool IsDoubleMapped() const HBUFF_NOEXCEPT{return m_DoubleMapped;}
+private:
+    HBuffer View(size_t at, size_t len, bool canModify) const HBUFF_NOEXCEPT{
+        return HBuffer(m_Data + at, len, len, false, canModify);
+    }
+    /// @brief copies param len bytes to ring offset param at, wrapping if needed
+    void CopyIn(size_t at, const char* data, size_t len) HBUFF_NOEXCEPT{
+        size_t first = m_DoubleMapped ? len : std::min(len, m_Capacity - at);
+        if(first > 0)memcpy(m_Data + at, data, first);
+        if(len > first)memcpy(m_Data, data + first, len - first);
+    }
+    void CopyOut(char* dest, size_t at, size_t len) const HBUFF_NOEXCEPT{
+        size_t first = m_DoubleMapped ? len : std::min(len, m_Capacity - at);
+        if(first > 0)memcpy(dest, m_Data + at, first);
+        if(len > first)memcpy(dest + first, m_Data, len - first);
+    }
+#if defined(__linux__)
+    /// @brief maps param capacity bytes of anonymous shared memory twice in a row
+    /// @return returns the start of the first mapping or nullptr if the kernel does not allow it
+    static char* MapTwice(size_t capacity) HBUFF_NOEXCEPT{
+        int fd = memfd_create("HBufferRing", MFD_CLOEXEC);
+        if(fd < 0)return nullptr;
+        if(ftruncate(fd, static_cast<off_t>(capacity)) != 0){
+            close(fd);
+            return nullptr;
+        }
+        //Reserving both halves first makes sure nothing else lands in the second one
+        char* base = static_cast<char*>(mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if(base == MAP_FAILED){
+            close(fd);
+            return nullptr;
+        }
+        void* first = mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        void* second = mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        close(fd);
+        if(first == MAP_FAILED || second == MAP_FAILED){
+            munmap(base, capacity * 2);
+            return nullptr;
+        }
+        return base;
+    }
+    static void UnmapTwice(char* data, size_t size, void*) HBUFF_NOEXCEPT{
+        munmap(data, size);
+    }
+#endif
+private:
+    /// @brief owns the memory. Twice the capacity when double mapped
+    HBuffer m_Storage;
+    char* m_Data = nullptr;
+    size_t m_Capacity = 0;
+    /// @brief total bytes ever consumed and committed. Only their difference and their low bits matter so they may wrap
+    size_t m_Read = 0;
+    size_t m_Write = 0;
+    bool m_DoubleMapped = false;
+};
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "HBuffer.hpp"
+#include "HBufferJoin.hpp"
+#include "HBufferScatter.hpp"
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
+/// @brief A chain of any amount of buffers read as one string. Appending or prepending a buffer is O(1) and nothing is ever flattened.
+/// @brief Finding the buffer that holds a byte is a binary search over the buffers' start offsets. Get with a Cursor checks the last hit first so walking forward is O(1).
+/// @brief Const functions keep no state in the rope so many threads may read one at once.
+/// @brief Buffers are kept as given so the data of views must outlive the rope. Empty buffers are dropped.
+class HBufferRope{
+public:
+    /// @brief remembers the buffer the last lookup landed in. Each reader keeps its own. A cursor left over from before the rope changed is still safe to pass, it just misses
+    struct Cursor{
+        size_t m_Segment = 0;
+    };
+
+    HBufferRope() HBUFF_NOEXCEPT{}
+    explicit HBufferRope(const HBufferJoin& join) HBUFF_NOEXCEPT{
+        Append(join.GetBuffer1());
+        Append(join.GetBuffer2());
+    }
+
+    /// @brief adds param buffer to the end. Copying a buffer makes a view of it, see HBuffer's copy constructor
+    void Append(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        if(buffer.GetSize() < 1)return;
+        m_Starts.push_back(GetEnd());
+        m_Segments.push_back(buffer);
+    }
+    void Append(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        if(buffer.GetSize() < 1)return;
+        m_Starts.push_back(GetEnd());
+        m_Segments.push_back(std::move(buffer));
+    }
+    /// @brief adds every buffer of param rope to the end
+    void Append(const HBufferRope& rope) HBUFF_NOEXCEPT{
+        for(const HBuffer& buffer : rope.m_Segments)Append(buffer);
+    }
+    void Append(HBufferRope&& rope) HBUFF_NOEXCEPT{
+        for(HBuffer& buffer : rope.m_Segments)Append(std::move(buffer));
+        rope.Clear();
+    }
+    /// @brief adds param buffer to the front. Offsets are relative to the first buffer so nothing else moves
+    void Prepend(const HBuffer& buffer) HBUFF_NOEXCEPT{
+        if(buffer.GetSize() < 1)return;
+        m_Starts.push_front(GetOrigin() - static_cast<int64_t>(buffer.GetSize()));
+        m_Segments.push_front(buffer);
+    }
+    void Prepend(HBuffer&& buffer) HBUFF_NOEXCEPT{
+        if(buffer.GetSize() < 1)return;
+        m_Starts.push_front(GetOrigin() - static_cast<int64_t>(buffer.GetSize()));
+        m_Segments.push_front(std::move(buffer));
+    }
+    void Clear() HBUFF_NOEXCEPT{
+        m_Segments.clear();
+        m_Starts.clear();
+    }
+    /// @brief makes every buffer safe to write into without changing any other buffer. See HBuffer::Detach
+    void Detach() HBUFF_NOEXCEPT{
+        for(HBuffer& buffer : m_Segments)buffer.Detach();
+    }
+    /// @brief drops the first param len bytes. Buffers that are used up are popped and the one cut in half keeps its second part, see HBuffer::RemovePrefix
+    void RemovePrefix(size_t len) HBUFF_NOEXCEPT{
+        while(!m_Segments.empty() && len >= m_Segments.front().GetSize()){
+            len -= m_Segments.front().GetSize();
+            m_Segments.pop_front();
+            m_Starts.pop_front();
+        }
+        if(!m_Segments.empty() && len > 0){
+            m_Segments.front().RemovePrefix(len);
+            m_Starts.front() += static_cast<int64_t>(len);
+        }
+    }
+
+    /// @brief cuts the rope at param at. This keeps the bytes before it and the rest is returned. No bytes are copied
+    /// @brief A buffer that is cut keeps its data in this rope and the returned rope gets a view of the second half, so this rope must outlive that view
+    HBufferRope Split(size_t at) HBUFF_NOEXCEPT{
+        HBufferRope tail;
+        size_t segment = FindSegment(at);
+        if(segment >= m_Segments.size())return tail;
+        size_t offset = at - GetSegmentStart(segment);
+        size_t first = segment;
+        if(offset > 0){
+            HBuffer& buffer = m_Segments[segment];
+            tail.Append(buffer.SubPointer(offset, -1, false));
+            buffer.AssignSize(offset);
+            first++;
+        }
+        for(size_t i = first; i < m_Segments.size(); i++)tail.Append(std::move(m_Segments[i]));
+        m_Segments.erase(m_Segments.begin() + first, m_Segments.end());
+        m_Starts.erase(m_Starts.begin() + first, m_Starts.end());
+        return tail;
+    }
+    /// @brief creates a rope of param len bytes starting at param at out of sub pointers to the buffers they span. No bytes are copied
+    /// @param allowModify passed on to every SubPointer
+    HBufferRope SubRope(size_t at, size_t len = -1, bool allowModify = false) const HBUFF_NOEXCEPT{
+        HBufferRope rope;
+        size_t segment = FindSegment(at);
+        if(segment >= m_Segments.size())return rope;
+        size_t offset = at - GetSegmentStart(segment);
+        size_t taken = 0;
+        for(; segment < m_Segments.size() && taken < len; segment++){
+            const HBuffer& buffer = m_Segments[segment];
+            size_t count = std::min(buffer.GetSize() - offset, len - taken);
+            rope.Append(buffer.SubPointer(offset, count, allowModify));
+            taken += count;
+            offset = 0;
+        }
+        return rope;
+    }
+public:
+    /// @brief copies param len bytes starting at param at into param dest with one memcpy per buffer they span
+    /// @return returns the amount of bytes copied
+    size_t CopyTo(char* dest, size_t at = 0, size_t len = -1) const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at);
+        if(segment >= m_Segments.size())return 0;
+        size_t offset = at - GetSegmentStart(segment);
+        size_t copied = 0;
+        for(; segment < m_Segments.size() && copied < len; segment++){
+            const HBuffer& buffer = m_Segments[segment];
+            size_t count = std::min(buffer.GetSize() - offset, len - copied);
+            memcpy(dest + copied, buffer.GetData() + offset, count);
+            copied += count;
+            offset = 0;
+        }
+        return copied;
+    }
+    /// @brief appends param len bytes starting at param at to the end of param dest
+    /// @return returns the amount of bytes copied
+    size_t CopyTo(HBuffer& dest, size_t at = 0, size_t len = -1) const HBUFF_NOEXCEPT{
+        size_t size = GetSize();
+        if(at >= size)return 0;
+        len = std::min(size - at, len);
+        return CopyTo(dest.Extend(len), at, len);
+    }
+    /// @brief copies param len bytes starting at param at into a new null terminated buffer
+    HBuffer SubString(size_t at, size_t len = -1) const HBUFF_NOEXCEPT{
+        HBuffer string;
+        size_t size = GetSize();
+        size_t totalLen = at < size ? std::min(size - at, len) : 0;
+        string.ReserveString(totalLen);
+        CopyTo(string.GetData(), at, totalLen);
+        string.GetData()[totalLen] = '\0';
+        string.AssignSize(totalLen);
+        return string;
+    }
+#if !defined(_WIN32)
+    /// @brief points up to param max iovecs at the bytes starting at param at, one per buffer
+    /// @return returns the amount of iovecs filled
+    size_t GetIOVecs(iovec* vecs, size_t max, size_t at = 0) const HBUFF_NOEXCEPT{
+        size_t count = 0;
+        size_t segment = FindSegment(at);
+        size_t offset = segment < m_Segments.size() ? at - GetSegmentStart(segment) : 0;
+        for(; segment < m_Segments.size() && count < max; segment++){
+            const HBuffer& buffer = m_Segments[segment];
+            vecs[count++] = iovec{buffer.GetData() + offset, buffer.GetSize() - offset};
+            offset = 0;
+        }
+        return count;
+    }
+    /// @brief writes the rope to param fd with writev and removes what was written from the front. See HBufferScatter::WriteTo
+    ssize_t WriteTo(int fd) HBUFF_NOEXCEPT{
+        return HBufferScatter::WriteTo(fd, *this);
+    }
+    /// @brief reads from param fd into the rope's bytes with readv, first buffer first. See HBufferScatter::ReadFrom
+    ssize_t ReadFrom(int fd) HBUFF_NOEXCEPT{
+        return HBufferScatter::ReadFrom(fd, *this);
+    }
+#endif
+    /// @brief returns the character at param at if inside the rope else \0
+    char Get(size_t at) const HBUFF_NOEXCEPT{
+        Cursor cursor;
+        return Get(at, cursor);
+    }
+    /// @brief same as Get(size_t at) but starts looking where param cursor last landed and moves it to where this lands
+    char Get(size_t at, Cursor& cursor) const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at, cursor);
+        if(segment >= m_Segments.size())return '\0';
+        return m_Segments[segment].At(at - GetSegmentStart(segment));
+    }
+#pragma region Search
+    /// @brief finds the first param c at or after param from
+    /// @return returns the index of the byte in the rope or HBUFF_NPOS if not found
+    size_t Find(char c, size_t from = 0) const HBUFF_NOEXCEPT{
+        for(size_t i = FindSegment(from); i < m_Segments.size(); i++){
+            size_t start = GetSegmentStart(i);
+            size_t found = m_Segments[i].Find(c, from > start ? from - start : 0);
+            if(found != HBUFF_NPOS)return start + found;
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first occurrence of param str at or after param from. Matches may span any amount of buffers
+    /// @return returns the index the match starts at in the rope or HBUFF_NPOS if not found
+    size_t Find(const char* str, size_t len, size_t from = 0) const HBUFF_NOEXCEPT{
+        if(len < 1)return from <= GetSize() ? from : HBUFF_NPOS;
+        for(size_t i = FindSegment(from); i < m_Segments.size(); i++){
+            const HBuffer& buffer = m_Segments[i];
+            size_t start = GetSegmentStart(i);
+            size_t size = buffer.GetSize();
+            size_t local = from > start ? from - start : 0;
+            //Any match that fits inside this buffer starts before any match that crosses into the next one
+            size_t found = buffer.Find(str, len, local);
+            if(found != HBUFF_NPOS)return start + found;
+            for(size_t at = std::max(local, size >= len ? size - len + 1 : 0); at < size; at++){
+                at = buffer.Find(str[0], at);
+                if(at == HBUFF_NPOS)break;
+                if(MatchesAt(start + at, str, len))return start + at;
+            }
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first occurrence of the null terminated param str
+    size_t Find(const char* str) const HBUFF_NOEXCEPT{
+        return Find(str, strlen(str));
+    }
+    /// @brief finds the last param c
+    /// @return returns the index of the byte in the rope or HBUFF_NPOS if not found
+    size_t FindLast(char c) const HBUFF_NOEXCEPT{
+        for(size_t i = m_Segments.size(); i > 0; i--){
+            size_t found = m_Segments[i - 1].FindLast(c);
+            if(found != HBUFF_NPOS)return GetSegmentStart(i - 1) + found;
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first byte at or after param from that is any of the bytes in param set
+    /// @return returns the index of the byte in the rope or HBUFF_NPOS if not found
+    size_t FindFirstOf(const char* set, size_t setLen, size_t from = 0) const HBUFF_NOEXCEPT{
+        for(size_t i = FindSegment(from); i < m_Segments.size(); i++){
+            size_t start = GetSegmentStart(i);
+            size_t found = m_Segments[i].FindFirstOf(set, setLen, from > start ? from - start : 0);
+            if(found != HBUFF_NPOS)return start + found;
+        }
+        return HBUFF_NPOS;
+    }
+    bool Contains(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return Find(str, len) != HBUFF_NPOS;
+    }
+    bool Contains(char c) const HBUFF_NOEXCEPT{
+        return Find(c) != HBUFF_NPOS;
+    }
+#pragma endregion
+#pragma region Compare
+    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return MatchesAt(0, str, len);
+    }
+    bool StartsWith(const char* str) const HBUFF_NOEXCEPT{
+        return MatchesAt(0, str, strlen(str));
+    }
+    /// @brief returns if the bytes starting at param at match param str
+    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return MatchesAt(at, str, len);
+    }
+    bool EndsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        size_t size = GetSize();
+        return len <= size && MatchesAt(size - len, str, len);
+    }
+    bool EndsWith(const char* str) const HBUFF_NOEXCEPT{
+        return EndsWith(str, strlen(str));
+    }
+    /// @brief compares byte wise like memcmp and then by size
+    /// @return returns less than 0 if the rope sorts before param str, 0 if they are equal and more than 0 if it sorts after
+    int Compare(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        size_t compared = 0;
+        for(size_t i = 0; i < m_Segments.size() && compared < len; i++){
+            const HBuffer& buffer = m_Segments[i];
+            size_t count = std::min(buffer.GetSize(), len - compared);
+            int result = memcmp(buffer.GetData(), str + compared, count);
+            if(result != 0)return result;
+            compared += count;
+        }
+        size_t size = GetSize();
+        return size < len ? -1 : (size > len ? 1 : 0);
+    }
+    int Compare(const HBuffer& buffer) const HBUFF_NOEXCEPT{
+        return Compare(buffer.GetData(), buffer.GetSize());
+    }
+    /// @brief compares two ropes one overlapping run of their buffers at a time. How the bytes are split up does not matter
+    int Compare(const HBufferRope& rope) const HBUFF_NOEXCEPT{
+        size_t leftSegment = 0, leftOffset = 0;
+        size_t rightSegment = 0, rightOffset = 0;
+        while(leftSegment < m_Segments.size() && rightSegment < rope.m_Segments.size()){
+            const HBuffer& left = m_Segments[leftSegment];
+            const HBuffer& right = rope.m_Segments[rightSegment];
+            size_t count = std::min(left.GetSize() - leftOffset, right.GetSize() - rightOffset);
+            int result = memcmp(left.GetData() + leftOffset, right.GetData() + rightOffset, count);
+            if(result != 0)return result;
+            leftOffset += count;
+            rightOffset += count;
+            if(leftOffset == left.GetSize()){
+                leftSegment++;
+                leftOffset = 0;
+            }
+            if(rightOffset == right.GetSize()){
+                rightSegment++;
+                rightOffset = 0;
+            }
+        }
+        size_t leftSize = GetSize();
+        size_t rightSize = rope.GetSize();
+        return leftSize < rightSize ? -1 : (leftSize > rightSize ? 1 : 0);
+    }
+    bool Equals(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return len == GetSize() && MatchesAt(0, str, len);
+    }
+    bool Equals(const HBufferRope& rope) const HBUFF_NOEXCEPT{
+        return GetSize() == rope.GetSize() && Compare(rope) == 0;
+    }
+    bool operator==(const HBufferRope& right) const HBUFF_NOEXCEPT{return Equals(right);}
+    bool operator!=(const HBufferRope& right) const HBUFF_NOEXCEPT{return !Equals(right);}
+    bool operator<(const HBufferRope& right) const HBUFF_NOEXCEPT{return Compare(right) < 0;}
+    bool operator<=(const HBufferRope& right) const HBUFF_NOEXCEPT{return Compare(right) <= 0;}
+    bool operator>(const HBufferRope& right) const HBUFF_NOEXCEPT{return Compare(right) > 0;}
+    bool operator>=(const HBufferRope& right) const HBUFF_NOEXCEPT{return Compare(right) >= 0;}
+#pragma endregion
+    /// @brief hashes the bytes without flattening them. Equal to HBufferHash::Hash and std::hash<HBuffer> of the same bytes in one buffer
+    uint64_t Hash(uint64_t seed = 0) const HBUFF_NOEXCEPT{
+        if(m_Segments.size() == 1)return HBufferHash::Hash(m_Segments[0].GetData(), m_Segments[0].GetSize(), seed);
+        return HBufferHash::HashFrom(HashSource{this, Cursor()}, GetSize(), seed);
+    }
+public:
+    /// @brief Walks the rope byte by byte. Steps inside a buffer are a pointer bump and moving to the next buffer is O(1)
+    /// @brief Any change to the rope invalidates it
+    class Iterator{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        Iterator() HBUFF_NOEXCEPT{}
+        Iterator(const HBufferRope* rope, size_t segment, size_t offset) HBUFF_NOEXCEPT : m_Rope(rope), m_Segment(segment), m_Offset(offset){}
+
+        const char& operator*() const HBUFF_NOEXCEPT{return m_Rope->m_Segments[m_Segment].GetData()[m_Offset];}
+        Iterator& operator++() HBUFF_NOEXCEPT{
+            //Buffers are never empty so the next one always has a first byte
+            if(++m_Offset >= m_Rope->m_Segments[m_Segment].GetSize()){
+                m_Segment++;
+                m_Offset = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) HBUFF_NOEXCEPT{
+            Iterator copy = *this;
+            ++(*this);
+            return copy;
+        }
+        /// @brief returns the offset of the current byte in the rope
+        size_t GetPosition() const HBUFF_NOEXCEPT{
+            if(m_Segment >= m_Rope->m_Segments.size())return m_Rope->GetSize();
+            return m_Rope->GetSegmentStart(m_Segment) + m_Offset;
+        }
+        bool operator==(const Iterator& right) const HBUFF_NOEXCEPT{return m_Segment == right.m_Segment && m_Offset == right.m_Offset;}
+        bool operator!=(const Iterator& right) const HBUFF_NOEXCEPT{return !(*this == right);}
+    private:
+        const HBufferRope* m_Rope = nullptr;
+        size_t m_Segment = 0;
+        size_t m_Offset = 0;
+    };
+
+    Iterator begin() const HBUFF_NOEXCEPT{return Iterator(this, 0, 0);}
+    Iterator end() const HBUFF_NOEXCEPT{return Iterator(this, m_Segments.size(), 0);}
+    /// @brief returns an iterator at byte param at or end() if out of range
+    Iterator IteratorAt(size_t at) const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at);
+        if(segment >= m_Segments.size())return end();
+        return Iterator(this, segment, at - GetSegmentStart(segment));
+    }
+public:
+    size_t GetSize() const HBUFF_NOEXCEPT{return static_cast<size_t>(GetEnd() - GetOrigin());}
+    size_t GetSegmentCount() const HBUFF_NOEXCEPT{return m_Segments.size();}
+    const HBuffer& GetSegment(size_t index) const HBUFF_NOEXCEPT{return m_Segments[index];}
+    /// @brief returns the offset in the rope of the first byte of buffer param index
+    size_t GetSegmentStart(size_t index) const HBUFF_NOEXCEPT{return static_cast<size_t>(m_Starts[index] - GetOrigin());}
+private:
+    /// @brief the Source HBufferHash::HashFrom reads through
+    struct HashSource{
+        const HBufferRope* m_Rope;
+        /// @brief the hash reads front to back so this lives as long as one Hash call
+        mutable Cursor m_Cursor;
+        void Read(size_t at, void* out, size_t count) const HBUFF_NOEXCEPT{
+            size_t segment = m_Rope->FindSegment(at, m_Cursor);
+            const HBuffer& buffer = m_Rope->m_Segments[segment];
+            size_t offset = at - m_Rope->GetSegmentStart(segment);
+            if(offset + count <= buffer.GetSize())memcpy(out, buffer.GetData() + offset, count);
+            else m_Rope->CopyTo(static_cast<char*>(out), at, count);
+        }
+    };
+
+    int64_t GetOrigin() const HBUFF_NOEXCEPT{return m_Starts.empty() ? 0 : m_Starts.front();}
+    int64_t GetEnd() const HBUFF_NOEXCEPT{return m_Starts.empty() ? 0 : m_Starts.back() + static_cast<int64_t>(m_Segments.back().GetSize());}
+    /// @brief returns if byte param at lives in buffer param segment
+    bool SegmentHolds(size_t segment, size_t at) const HBUFF_NOEXCEPT{
+        if(segment >= m_Segments.size())return false;
+        size_t start = GetSegmentStart(segment);
+        return at >= start && at < start + m_Segments[segment].GetSize();
+    }
+    /// @brief returns the index of the buffer holding byte param at or the amount of buffers if at is out of range. Binary searches the start offsets
+    size_t FindSegment(size_t at) const HBUFF_NOEXCEPT{
+        if(at >= GetSize())return m_Segments.size();
+        int64_t target = GetOrigin() + static_cast<int64_t>(at);
+        return std::upper_bound(m_Starts.begin(), m_Starts.end(), target) - m_Starts.begin() - 1;
+    }
+    /// @brief checks the buffer param cursor is on and the one after it first so walking forward is O(1), then falls back to FindSegment(size_t at)
+    size_t FindSegment(size_t at, Cursor& cursor) const HBUFF_NOEXCEPT{
+        if(SegmentHolds(cursor.m_Segment, at))return cursor.m_Segment;
+        if(SegmentHolds(cursor.m_Segment + 1, at))return ++cursor.m_Segment;
+        size_t segment = FindSegment(at);
+        if(segment < m_Segments.size())cursor.m_Segment = segment;
+        return segment;
+    }
+    /// @brief returns if the rope holds param str starting at param at, comparing one buffer at a time
+    bool MatchesAt(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
+        if(at > GetSize())return false;
+        size_t segment = FindSegment(at);
+        size_t offset = segment < m_Segments.size() ? at - GetSegmentStart(segment) : 0;
+        while(len > 0){
+            if(segment >= m_Segments.size())return false;
+            const HBuffer& buffer = m_Segments[segment];
+            size_t count = std::min(len, buffer.GetSize() - offset);
+            if(!HBufferSimd::Equals(buffer.GetData() + offset, str, count))return false;
+            str += count;
+            len -= count;
+            offset = 0;
+            segment++;
+        }
+        return true;
+    }
+private:
+    std::deque<HBuffer> m_Segments;
+    /// @brief where each buffer starts, counted from an origin that only moves when buffers are prepended
+    /// Example: append size 15, append size 20, prepend size 2
+    /// Values: -2, 0, 15
+    std::deque<int64_t> m_Starts;
+};
+
+namespace std {
+    template<>
+    struct hash<HBufferRope> {
+        std::size_t operator()(const HBufferRope& rope) const HBUFF_NOEXCEPT{
+            return static_cast<std::size_t>(rope.Hash());
+        }
+    };
+}
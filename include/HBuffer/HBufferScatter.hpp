@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Core.h"
+
+/// Scatter/gather IO with writev/readv so joins can go to and from a file descriptor without being flattened.
+/// POSIX only. Nothing here is defined on Windows.
+#if !defined(_WIN32)
+#include <algorithm>
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef HBUFF_IOV_MAX
+#if defined(IOV_MAX)
+#define HBUFF_IOV_MAX IOV_MAX
+#else
+/// The smallest IOV_MAX POSIX allows
+#define HBUFF_IOV_MAX 16
+#endif
+#endif
+
+struct HBufferScatter{
+public:
+    /// @brief the most iovecs handed to a single writev/readv
+    static constexpr size_t s_MaxIOVecs = HBUFF_IOV_MAX;
+
+    /// @brief writes every byte of param count iovecs to param fd, looping on writev and retrying on EINTR
+    /// @brief param vecs and param count are advanced in place so on a partial write they describe what is left
+    /// @return returns the amount of bytes written. Stops early if the fd would block or errors after some bytes went out. -1 if it errors before any did, see errno
+    static ssize_t Write(int fd, iovec*& vecs, size_t& count) HBUFF_NOEXCEPT{
+        size_t total = 0;
+        SkipEmpty(vecs, count);
+        while(count > 0){
+            ssize_t written = writev(fd, vecs, static_cast<int>(std::min(count, s_MaxIOVecs)));
+            if(written < 0){
+                if(errno == EINTR)continue;
+                return total > 0 ? static_cast<ssize_t>(total) : -1;
+            }
+            total += written;
+            Advance(vecs, count, written);
+        }
+        return static_cast<ssize_t>(total);
+    }
+    /// @brief reads from param fd into param count iovecs with readv, retrying on EINTR
+    /// @brief Only keeps reading while every read fills what it was given so a blocking fd never waits for bytes that may not come
+    /// @brief param vecs and param count are advanced in place past every read that filled them
+    /// @return returns the amount of bytes read, 0 at the end of the file and -1 if it errors before reading anything, see errno
+    static ssize_t Read(int fd, iovec*& vecs, size_t& count) HBUFF_NOEXCEPT{
+        size_t total = 0;
+        SkipEmpty(vecs, count);
+        while(count > 0){
+            size_t batch = std::min(count, s_MaxIOVecs);
+            ssize_t read = readv(fd, vecs, static_cast<int>(batch));
+            if(read < 0){
+                if(errno == EINTR)continue;
+                return total > 0 ? static_cast<ssize_t>(total) : -1;
+            }
+            total += read;
+            if(read == 0 || static_cast<size_t>(read) < GetSize(vecs, batch))break;
+            Advance(vecs, count, read);
+        }
+        return static_cast<ssize_t>(total);
+    }
+
+    /// @brief writes param join to param fd and removes whatever was written from its front
+    /// @brief Join needs GetIOVecs(iovec*, size_t max, size_t at) const, GetSize() and RemovePrefix(size_t)
+    /// @return same as Write
+    template<typename Join>
+    static ssize_t WriteTo(int fd, Join& join) HBUFF_NOEXCEPT{
+        iovec vecs[s_MaxIOVecs];
+        size_t total = 0;
+        while(join.GetSize() > 0){
+            iovec* cursor = vecs;
+            size_t count = join.GetIOVecs(vecs, s_MaxIOVecs, 0);
+            size_t batch = GetSize(vecs, count);
+            ssize_t written = Write(fd, cursor, count);
+            if(written > 0){
+                join.RemovePrefix(written);
+                total += written;
+            }
+            if(written < 0 || static_cast<size_t>(written) < batch)return total > 0 ? static_cast<ssize_t>(total) : written;
+        }
+        return static_cast<ssize_t>(total);
+    }
+    /// @brief reads from param fd straight into the bytes of param join, front to back.
+    /// @brief The join is detached first so buffers that are shared or can not be modified, like a read only mapping, get their own copy instead of being written through
+    /// @brief Join needs GetIOVecs(iovec*, size_t max, size_t at) const, GetSize() and Detach()
+    /// @return same as Read
+    template<typename Join>
+    static ssize_t ReadFrom(int fd, Join& join) HBUFF_NOEXCEPT{
+        iovec vecs[s_MaxIOVecs];
+        size_t total = 0;
+        size_t size = join.GetSize();
+        join.Detach();
+        while(total < size){
+            iovec* cursor = vecs;
+            size_t count = join.GetIOVecs(vecs, s_MaxIOVecs, total);
+            size_t batch = GetSize(vecs, count);
+            ssize_t read = Read(fd, cursor, count);
+            if(read > 0)total += read;
+            if(read <= 0 || static_cast<size_t>(read) < batch)return total > 0 ? static_cast<ssize_t>(total) : read;
+        }
+        return static_cast<ssize_t>(total);
+    }
+
+    /// @brief moves param vecs past param len bytes. Fully used iovecs are dropped and a partly used one is shrunk in place
+    static void Advance(iovec*& vecs, size_t& count, size_t len) HBUFF_NOEXCEPT{
+        while(count > 0 && len >= vecs->iov_len){
+            len -= vecs->iov_len;
+            vecs++;
+            count--;
+        }
+        if(count > 0){
+            vecs->iov_base = static_cast<char*>(vecs->iov_base) + len;
+            vecs->iov_len -= len;
+        }
+        SkipEmpty(vecs, count);
+    }
+    /// @brief returns the total amount of bytes in param count iovecs
+    static size_t GetSize(const iovec* vecs, size_t count) HBUFF_NOEXCEPT{
+        size_t size = 0;
+        for(size_t i = 0; i < count; i++)size += vecs[i].iov_len;
+        return size;
+    }
+private:
+    static void SkipEmpty(iovec*& vecs, size_t& count) HBUFF_NOEXCEPT{
+        while(count > 0 && vecs->iov_len == 0){
+            vecs++;
+            count--;
+        }
+    }
+};
+#endif
@@ -0,0 +1,593 @@
+#pragma once
+
+#include "Core.h"
+
+/// Byte search and ASCII case kernels used by HBuffer, HBufferJoin and HBufferVectorJoin.
+/// Every kernel has a scalar version plus SSE2/AVX2 on x86 and NEON on arm. AVX2 is picked at runtime if the cpu supports it.
+/// Define HBUFF_NO_SIMD to only build the scalar versions.
+
+#if !defined(HBUFF_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HBUFF_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif !defined(HBUFF_NO_SIMD) && (defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64))
+#define HBUFF_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(HBUFF_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HBUFF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HBUFF_TARGET_AVX2
+#endif
+
+/// HBUFF_SIMD_LEVEL_SCALAR. Plain byte loops / libc
+/// HBUFF_SIMD_LEVEL_SSE2. 16 bytes per step on x86
+/// HBUFF_SIMD_LEVEL_AVX2. 32 bytes per step on x86
+/// HBUFF_SIMD_LEVEL_NEON. 16 bytes per step on arm
+#define HBUFF_SIMD_LEVEL_SCALAR 0
+#define HBUFF_SIMD_LEVEL_SSE2 1
+#define HBUFF_SIMD_LEVEL_AVX2 2
+#define HBUFF_SIMD_LEVEL_NEON 3
+
+struct HBufferSimd{
+public:
+    /// @return returns the index of the first param c in data or HBUFF_NPOS
+    static size_t FindByte(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+    #if defined(HBUFF_SIMD_X86)
+        if(len >= 32 && GetLevel() == HBUFF_SIMD_LEVEL_AVX2)return FindByteAVX2(data, len, c);
+    #endif
+        //libc memchr is already vectorized everywhere we care about
+        if(len < 1)return HBUFF_NPOS;
+        const void* found = memchr(data, c, len);
+        return found ? static_cast<const char*>(found) - data : HBUFF_NPOS;
+    }
+
+    /// @return returns the index of the last param c in data or HBUFF_NPOS
+    static size_t FindLastByte(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        if(len >= 16){
+            switch(GetLevel()){
+        #if defined(HBUFF_SIMD_X86)
+            case HBUFF_SIMD_LEVEL_AVX2: return FindLastByteAVX2(data, len, c);
+            case HBUFF_SIMD_LEVEL_SSE2: return FindLastByteSSE2(data, len, c);
+        #elif defined(HBUFF_SIMD_NEON)
+            case HBUFF_SIMD_LEVEL_NEON: return FindLastByteNEON(data, len, c);
+        #endif
+            default: break;
+            }
+        }
+        return FindLastByteScalar(data, len, c);
+    }
+
+    /// @return returns the index of the first byte in data that is any of the bytes in param set or HBUFF_NPOS
+    static size_t FindAnyOf(const char* data, size_t len, const char* set, size_t setLen) HBUFF_NOEXCEPT{
+        if(setLen < 1)return HBUFF_NPOS;
+        if(setLen == 1)return FindByte(data, len, set[0]);
+        //Every set byte costs a compare per block so big sets are better off with the lookup table
+        if(len >= 16 && setLen <= s_MaxVectorSet){
+            switch(GetLevel()){
+        #if defined(HBUFF_SIMD_X86)
+            case HBUFF_SIMD_LEVEL_AVX2: return FindAnyOfAVX2(data, len, set, setLen);
+            case HBUFF_SIMD_LEVEL_SSE2: return FindAnyOfSSE2(data, len, set, setLen);
+        #elif defined(HBUFF_SIMD_NEON)
+            case HBUFF_SIMD_LEVEL_NEON: return FindAnyOfNEON(data, len, set, setLen);
+        #endif
+            default: break;
+            }
+        }
+        return FindAnyOfScalar(data, len, set, setLen);
+    }
+
+    /// @return returns the index of the first occurrence of param needle in data or HBUFF_NPOS. An empty needle is found at 0
+    static size_t Find(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        if(needleLen < 1)return 0;
+        if(needleLen > len)return HBUFF_NPOS;
+        if(needleLen == 1)return FindByte(data, len, needle[0]);
+        switch(GetLevel()){
+    #if defined(HBUFF_SIMD_X86)
+        case HBUFF_SIMD_LEVEL_AVX2: return FindAVX2(data, len, needle, needleLen);
+        case HBUFF_SIMD_LEVEL_SSE2: return FindSSE2(data, len, needle, needleLen);
+    #elif defined(HBUFF_SIMD_NEON)
+        case HBUFF_SIMD_LEVEL_NEON: return FindNEON(data, len, needle, needleLen);
+    #endif
+        default: break;
+        }
+        return FindScalar(data, len, needle, needleLen);
+    }
+
+    /// @return returns the index of the last occurrence of param needle in data or HBUFF_NPOS. An empty needle is found at len
+    static size_t FindLast(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        if(needleLen < 1)return len;
+        if(needleLen > len)return HBUFF_NPOS;
+        size_t end = len - needleLen + 1;
+        while(end > 0){
+            size_t at = FindLastByte(data, end, needle[0]);
+            if(at == HBUFF_NPOS)return HBUFF_NPOS;
+            if(memcmp(data + at + 1, needle + 1, needleLen - 1) == 0)return at;
+            end = at;
+        }
+        return HBUFF_NPOS;
+    }
+
+    /// @return returns if the first param len bytes of left and right match. Keys up to 16 bytes compare two overlapping words instead of calling memcmp
+    static bool Equals(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        if(len >= 8){
+            if(len > 16)return memcmp(left, right, len) == 0;
+            return ((Load<uint64_t>(left) ^ Load<uint64_t>(right)) | (Load<uint64_t>(left + len - 8) ^ Load<uint64_t>(right + len - 8))) == 0;
+        }
+        if(len >= 4)return ((Load<uint32_t>(left) ^ Load<uint32_t>(right)) | (Load<uint32_t>(left + len - 4) ^ Load<uint32_t>(right + len - 4))) == 0;
+        for(size_t i = 0; i < len; i++)
+            if(left[i] != right[i])return false;
+        return true;
+    }
+    /// @brief unaligned load of a T from param data
+    template<typename T>
+    static T Load(const char* data) HBUFF_NOEXCEPT{
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+    /// @brief writes param len bytes of src to dst with every ASCII upper case letter made lower case. dst may be the same as src
+    static void ToLower(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        ChangeCase<false>(dst, src, len);
+    }
+    /// @brief writes param len bytes of src to dst with every ASCII lower case letter made upper case. dst may be the same as src
+    static void ToUpper(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        ChangeCase<true>(dst, src, len);
+    }
+    /// @return returns if the first param len bytes of left and right match when ASCII case is ignored
+    static bool EqualsIgnoreCase(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        if(len >= 16){
+            switch(GetLevel()){
+        #if defined(HBUFF_SIMD_X86)
+            case HBUFF_SIMD_LEVEL_AVX2: return EqualsIgnoreCaseAVX2(left, right, len);
+            case HBUFF_SIMD_LEVEL_SSE2: return EqualsIgnoreCaseSSE2(left, right, len);
+        #elif defined(HBUFF_SIMD_NEON)
+            case HBUFF_SIMD_LEVEL_NEON: return EqualsIgnoreCaseNEON(left, right, len);
+        #endif
+            default: break;
+            }
+        }
+        return EqualsIgnoreCaseScalar(left, right, len);
+    }
+    /// @return returns the index of the first occurrence of param needle in data ignoring ASCII case or HBUFF_NPOS. An empty needle is found at 0
+    static size_t FindIgnoreCase(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        if(needleLen < 1)return 0;
+        if(needleLen > len)return HBUFF_NPOS;
+        if(needleLen == 1){
+            char both[2] = {ToLowerByte(needle[0]), ToUpperByte(needle[0])};
+            return both[0] == both[1] ? FindByte(data, len, both[0]) : FindAnyOf(data, len, both, 2);
+        }
+        switch(GetLevel()){
+    #if defined(HBUFF_SIMD_X86)
+        case HBUFF_SIMD_LEVEL_AVX2: return FindIgnoreCaseAVX2(data, len, needle, needleLen);
+        case HBUFF_SIMD_LEVEL_SSE2: return FindIgnoreCaseSSE2(data, len, needle, needleLen);
+    #elif defined(HBUFF_SIMD_NEON)
+        case HBUFF_SIMD_LEVEL_NEON: return FindIgnoreCaseNEON(data, len, needle, needleLen);
+    #endif
+        default: break;
+        }
+        return FindIgnoreCaseScalar(data, len, needle, needleLen);
+    }
+    /// @brief lower cases a single ASCII letter without branching. Every other byte is returned as is
+    static char ToLowerByte(char c) HBUFF_NOEXCEPT{
+        return static_cast<char>(c ^ ((static_cast<unsigned char>(c - 'A') < 26) << 5));
+    }
+    /// @brief upper cases a single ASCII letter without branching. Every other byte is returned as is
+    static char ToUpperByte(char c) HBUFF_NOEXCEPT{
+        return static_cast<char>(c ^ ((static_cast<unsigned char>(c - 'a') < 26) << 5));
+    }
+public:
+    /// @brief returns which kernels are in use. One of HBUFF_SIMD_LEVEL_*
+    static int GetLevel() HBUFF_NOEXCEPT{return Level();}
+    /// @brief forces the kernels down to param level, for example HBUFF_SIMD_LEVEL_SCALAR to compare against. Can not go above what the cpu supports.
+    /// @brief Not thread safe. Call before other threads start searching
+    static void SetLevel(int level) HBUFF_NOEXCEPT{Level() = std::min(level, DetectLevel());}
+private:
+    template<bool Upper>
+    static void ChangeCase(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        size_t done = 0;
+        switch(GetLevel()){
+    #if defined(HBUFF_SIMD_X86)
+        case HBUFF_SIMD_LEVEL_AVX2: done = ChangeCaseAVX2<Upper>(dst, src, len); break;
+        case HBUFF_SIMD_LEVEL_SSE2: done = ChangeCaseSSE2<Upper>(dst, src, len); break;
+    #elif defined(HBUFF_SIMD_NEON)
+        case HBUFF_SIMD_LEVEL_NEON: done = ChangeCaseNEON<Upper>(dst, src, len); break;
+    #endif
+        default: break;
+        }
+        ChangeCaseScalar<Upper>(dst + done, src + done, len - done);
+    }
+private:
+    static int& Level() HBUFF_NOEXCEPT{
+        static int level = DetectLevel();
+        return level;
+    }
+    static int DetectLevel() HBUFF_NOEXCEPT{
+    #if defined(HBUFF_SIMD_X86)
+        #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)return HBUFF_SIMD_LEVEL_SSE2;
+        __cpuid(info, 1);
+        //AVX needs both the cpu and the os saving the ymm registers
+        if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))return HBUFF_SIMD_LEVEL_SSE2;
+        if((_xgetbv(0) & 6) != 6)return HBUFF_SIMD_LEVEL_SSE2;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) ? HBUFF_SIMD_LEVEL_AVX2 : HBUFF_SIMD_LEVEL_SSE2;
+        #else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? HBUFF_SIMD_LEVEL_AVX2 : HBUFF_SIMD_LEVEL_SSE2;
+        #endif
+    #elif defined(HBUFF_SIMD_NEON)
+        return HBUFF_SIMD_LEVEL_NEON;
+    #else
+        return HBUFF_SIMD_LEVEL_SCALAR;
+    #endif
+    }
+public:
+    /// @brief bit scans used to turn compare masks back into byte indices. value must not be 0
+    static unsigned CountTrailingZeros(uint32_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<unsigned>(index);
+    #else
+        return static_cast<unsigned>(__builtin_ctz(value));
+    #endif
+    }
+    static unsigned CountLeadingZeros(uint32_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse(&index, value);
+        return 31 - static_cast<unsigned>(index);
+    #else
+        return static_cast<unsigned>(__builtin_clz(value));
+    #endif
+    }
+    static unsigned CountTrailingZeros64(uint64_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+    #else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+    #endif
+    }
+    static unsigned CountLeadingZeros64(uint64_t value) HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - static_cast<unsigned>(index);
+    #else
+        return static_cast<unsigned>(__builtin_clzll(value));
+    #endif
+    }
+private:
+#pragma region Scalar
+    static size_t FindLastByteScalar(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        while(len > 0){
+            len--;
+            if(data[len] == c)return len;
+        }
+        return HBUFF_NPOS;
+    }
+    static size_t FindAnyOfScalar(const char* data, size_t len, const char* set, size_t setLen) HBUFF_NOEXCEPT{
+        bool table[256] = {};
+        for(size_t i = 0; i < setLen; i++)table[static_cast<unsigned char>(set[i])] = true;
+        for(size_t i = 0; i < len; i++)
+            if(table[static_cast<unsigned char>(data[i])])return i;
+        return HBUFF_NPOS;
+    }
+    static size_t FindScalar(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        if(needleLen > len)return HBUFF_NPOS;
+        size_t last = len - needleLen;
+        size_t i = 0;
+        while(i <= last){
+            const void* found = memchr(data + i, needle[0], last - i + 1);
+            if(!found)return HBUFF_NPOS;
+            size_t at = static_cast<const char*>(found) - data;
+            if(memcmp(data + at + 1, needle + 1, needleLen - 1) == 0)return at;
+            i = at + 1;
+        }
+        return HBUFF_NPOS;
+    }
+    template<bool Upper>
+    static void ChangeCaseScalar(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        for(size_t i = 0; i < len; i++)dst[i] = Upper ? ToUpperByte(src[i]) : ToLowerByte(src[i]);
+    }
+    static bool EqualsIgnoreCaseScalar(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        for(size_t i = 0; i < len; i++)
+            if(ToLowerByte(left[i]) != ToLowerByte(right[i]))return false;
+        return true;
+    }
+    static size_t FindIgnoreCaseScalar(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        if(needleLen > len)return HBUFF_NPOS;
+        char first = ToLowerByte(needle[0]);
+        for(size_t i = 0; i + needleLen <= len; i++)
+            if(ToLowerByte(data[i]) == first && EqualsIgnoreCaseScalar(data + i + 1, needle + 1, needleLen - 1))return i;
+        return HBUFF_NPOS;
+    }
+#pragma endregion
+#if defined(HBUFF_SIMD_X86)
+#pragma region SSE2
+    static size_t FindLastByteSSE2(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        const __m128i needle = _mm_set1_epi8(c);
+        while(len >= 16){
+            len -= 16;
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + len));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            if(mask)return len + 31 - CountLeadingZeros(mask);
+        }
+        return FindLastByteScalar(data, len, c);
+    }
+    static size_t FindAnyOfSSE2(const char* data, size_t len, const char* set, size_t setLen) HBUFF_NOEXCEPT{
+        __m128i sets[s_MaxVectorSet];
+        for(size_t i = 0; i < setLen; i++)sets[i] = _mm_set1_epi8(set[i]);
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i matches = _mm_cmpeq_epi8(block, sets[0]);
+            for(size_t j = 1; j < setLen; j++)matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, sets[j]));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+            if(mask)return i + CountTrailingZeros(mask);
+        }
+        size_t found = FindAnyOfScalar(data + i, len - i, set, setLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    /// @brief compares the first and last needle byte at 16 positions at once and only memcmps the positions where both match
+    static size_t FindSSE2(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[needleLen - 1]);
+        size_t i = 0;
+        for(; i + needleLen - 1 + 16 <= len; i += 16){
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needleLen - 1));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+            while(mask){
+                unsigned bit = CountTrailingZeros(mask);
+                if(memcmp(data + i + bit + 1, needle + 1, needleLen - 2) == 0)return i + bit;
+                mask &= mask - 1;
+            }
+        }
+        size_t found = FindScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    /// @brief flips the case bit of every byte in the range 'A'-'Z' or 'a'-'z' when param Upper. Biasing by 0x80 lets a signed compare do the unsigned range check
+    template<bool Upper>
+    static __m128i ChangeCaseSSE2(__m128i block) HBUFF_NOEXCEPT{
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - (Upper ? 'a' : 'A')));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        __m128i letters = _mm_cmplt_epi8(_mm_add_epi8(block, bias), limit);
+        return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+    }
+    /// @return returns the amount of bytes converted. The rest is left to the scalar version
+    template<bool Upper>
+    static size_t ChangeCaseSSE2(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), ChangeCaseSSE2<Upper>(block));
+        }
+        return i;
+    }
+    static bool EqualsIgnoreCaseSSE2(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            __m128i blockLeft = ChangeCaseSSE2<false>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i)));
+            __m128i blockRight = ChangeCaseSSE2<false>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i)));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(blockLeft, blockRight)) != 0xFFFF)return false;
+        }
+        return EqualsIgnoreCaseScalar(left + i, right + i, len - i);
+    }
+    static size_t FindIgnoreCaseSSE2(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const __m128i first = _mm_set1_epi8(ToLowerByte(needle[0]));
+        const __m128i last = _mm_set1_epi8(ToLowerByte(needle[needleLen - 1]));
+        size_t i = 0;
+        for(; i + needleLen - 1 + 16 <= len; i += 16){
+            __m128i blockFirst = ChangeCaseSSE2<false>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            __m128i blockLast = ChangeCaseSSE2<false>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needleLen - 1)));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+            while(mask){
+                unsigned bit = CountTrailingZeros(mask);
+                if(EqualsIgnoreCase(data + i + bit + 1, needle + 1, needleLen - 2))return i + bit;
+                mask &= mask - 1;
+            }
+        }
+        size_t found = FindIgnoreCaseScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+#pragma endregion
+#pragma region AVX2
+    HBUFF_TARGET_AVX2 static size_t FindByteAVX2(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+        for(; i + 32 <= len; i += 32){
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            if(mask)return i + CountTrailingZeros(mask);
+        }
+        for(; i < len; i++)
+            if(data[i] == c)return i;
+        return HBUFF_NPOS;
+    }
+    HBUFF_TARGET_AVX2 static size_t FindLastByteAVX2(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        const __m256i needle = _mm256_set1_epi8(c);
+        while(len >= 32){
+            len -= 32;
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + len));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            if(mask)return len + 31 - CountLeadingZeros(mask);
+        }
+        return FindLastByteScalar(data, len, c);
+    }
+    HBUFF_TARGET_AVX2 static size_t FindAnyOfAVX2(const char* data, size_t len, const char* set, size_t setLen) HBUFF_NOEXCEPT{
+        __m256i sets[s_MaxVectorSet];
+        for(size_t i = 0; i < setLen; i++)sets[i] = _mm256_set1_epi8(set[i]);
+        size_t i = 0;
+        for(; i + 32 <= len; i += 32){
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i matches = _mm256_cmpeq_epi8(block, sets[0]);
+            for(size_t j = 1; j < setLen; j++)matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, sets[j]));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+            if(mask)return i + CountTrailingZeros(mask);
+        }
+        size_t found = FindAnyOfScalar(data + i, len - i, set, setLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    HBUFF_TARGET_AVX2 static size_t FindAVX2(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[needleLen - 1]);
+        size_t i = 0;
+        for(; i + needleLen - 1 + 32 <= len; i += 32){
+            __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needleLen - 1));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+            while(mask){
+                unsigned bit = CountTrailingZeros(mask);
+                if(memcmp(data + i + bit + 1, needle + 1, needleLen - 2) == 0)return i + bit;
+                mask &= mask - 1;
+            }
+        }
+        size_t found = FindScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    template<bool Upper>
+    HBUFF_TARGET_AVX2 static __m256i ChangeCaseAVX2(__m256i block) HBUFF_NOEXCEPT{
+        const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - (Upper ? 'a' : 'A')));
+        const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+        __m256i letters = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, bias));
+        return _mm256_xor_si256(block, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+    }
+    template<bool Upper>
+    HBUFF_TARGET_AVX2 static size_t ChangeCaseAVX2(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 32 <= len; i += 32){
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), ChangeCaseAVX2<Upper>(block));
+        }
+        return i + ChangeCaseSSE2<Upper>(dst + i, src + i, len - i);
+    }
+    HBUFF_TARGET_AVX2 static bool EqualsIgnoreCaseAVX2(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 32 <= len; i += 32){
+            __m256i blockLeft = ChangeCaseAVX2<false>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i)));
+            __m256i blockRight = ChangeCaseAVX2<false>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i)));
+            if(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockLeft, blockRight))) != 0xFFFFFFFF)return false;
+        }
+        return EqualsIgnoreCaseSSE2(left + i, right + i, len - i);
+    }
+    HBUFF_TARGET_AVX2 static size_t FindIgnoreCaseAVX2(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const __m256i first = _mm256_set1_epi8(ToLowerByte(needle[0]));
+        const __m256i last = _mm256_set1_epi8(ToLowerByte(needle[needleLen - 1]));
+        size_t i = 0;
+        for(; i + needleLen - 1 + 32 <= len; i += 32){
+            __m256i blockFirst = ChangeCaseAVX2<false>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            __m256i blockLast = ChangeCaseAVX2<false>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needleLen - 1)));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+            while(mask){
+                unsigned bit = CountTrailingZeros(mask);
+                if(EqualsIgnoreCase(data + i + bit + 1, needle + 1, needleLen - 2))return i + bit;
+                mask &= mask - 1;
+            }
+        }
+        size_t found = FindIgnoreCaseScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+#pragma endregion
+#elif defined(HBUFF_SIMD_NEON)
+#pragma region NEON
+    /// @brief NEON has no movemask so narrow the compare result to 4 bits per byte inside a 64 bit value
+    static uint64_t MaskNEON(uint8x16_t matches) HBUFF_NOEXCEPT{
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+    }
+    static size_t FindLastByteNEON(const char* data, size_t len, char c) HBUFF_NOEXCEPT{
+        const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(c));
+        while(len >= 16){
+            len -= 16;
+            uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + len));
+            uint64_t mask = MaskNEON(vceqq_u8(block, needle));
+            if(mask)return len + 15 - (CountLeadingZeros64(mask) >> 2);
+        }
+        return FindLastByteScalar(data, len, c);
+    }
+    static size_t FindAnyOfNEON(const char* data, size_t len, const char* set, size_t setLen) HBUFF_NOEXCEPT{
+        uint8x16_t sets[s_MaxVectorSet];
+        for(size_t i = 0; i < setLen; i++)sets[i] = vdupq_n_u8(static_cast<uint8_t>(set[i]));
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            uint8x16_t matches = vceqq_u8(block, sets[0]);
+            for(size_t j = 1; j < setLen; j++)matches = vorrq_u8(matches, vceqq_u8(block, sets[j]));
+            uint64_t mask = MaskNEON(matches);
+            if(mask)return i + (CountTrailingZeros64(mask) >> 2);
+        }
+        size_t found = FindAnyOfScalar(data + i, len - i, set, setLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    static size_t FindNEON(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+        const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[needleLen - 1]));
+        size_t i = 0;
+        for(; i + needleLen - 1 + 16 <= len; i += 16){
+            uint8x16_t blockFirst = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            uint8x16_t blockLast = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i + needleLen - 1));
+            uint64_t mask = MaskNEON(vandq_u8(vceqq_u8(blockFirst, first), vceqq_u8(blockLast, last)));
+            while(mask){
+                unsigned bit = CountTrailingZeros64(mask) >> 2;
+                if(memcmp(data + i + bit + 1, needle + 1, needleLen - 2) == 0)return i + bit;
+                //Clear all 4 bits that belong to this byte
+                mask &= ~(static_cast<uint64_t>(0xF) << (bit * 4));
+            }
+        }
+        size_t found = FindScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+    template<bool Upper>
+    static uint8x16_t ChangeCaseNEON(uint8x16_t block) HBUFF_NOEXCEPT{
+        uint8x16_t letters = vcltq_u8(vsubq_u8(block, vdupq_n_u8(Upper ? 'a' : 'A')), vdupq_n_u8(26));
+        return veorq_u8(block, vandq_u8(letters, vdupq_n_u8(0x20)));
+    }
+    template<bool Upper>
+    static size_t ChangeCaseNEON(char* dst, const char* src, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+            vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), ChangeCaseNEON<Upper>(block));
+        }
+        return i;
+    }
+    static bool EqualsIgnoreCaseNEON(const char* left, const char* right, size_t len) HBUFF_NOEXCEPT{
+        size_t i = 0;
+        for(; i + 16 <= len; i += 16){
+            uint8x16_t blockLeft = ChangeCaseNEON<false>(vld1q_u8(reinterpret_cast<const uint8_t*>(left + i)));
+            uint8x16_t blockRight = ChangeCaseNEON<false>(vld1q_u8(reinterpret_cast<const uint8_t*>(right + i)));
+            if(MaskNEON(vceqq_u8(blockLeft, blockRight)) != ~static_cast<uint64_t>(0))return false;
+        }
+        return EqualsIgnoreCaseScalar(left + i, right + i, len - i);
+    }
+    static size_t FindIgnoreCaseNEON(const char* data, size_t len, const char* needle, size_t needleLen) HBUFF_NOEXCEPT{
+        const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(ToLowerByte(needle[0])));
+        const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(ToLowerByte(needle[needleLen - 1])));
+        size_t i = 0;
+        for(; i + needleLen - 1 + 16 <= len; i += 16){
+            uint8x16_t blockFirst = ChangeCaseNEON<false>(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i)));
+            uint8x16_t blockLast = ChangeCaseNEON<false>(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i + needleLen - 1)));
+            uint64_t mask = MaskNEON(vandq_u8(vceqq_u8(blockFirst, first), vceqq_u8(blockLast, last)));
+            while(mask){
+                unsigned bit = CountTrailingZeros64(mask) >> 2;
+                if(EqualsIgnoreCase(data + i + bit + 1, needle + 1, needleLen - 2))return i + bit;
+                mask &= ~(static_cast<uint64_t>(0xF) << (bit * 4));
+            }
+        }
+        size_t found = FindIgnoreCaseScalar(data + i, len - i, needle, needleLen);
+        return found == HBUFF_NPOS ? HBUFF_NPOS : i + found;
+    }
+#pragma endregion
+#endif
+private:
+    /// @brief byte sets bigger than this use the scalar lookup table instead of one compare per set byte
+    static constexpr size_t s_MaxVectorSet = 16;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "HBuffer.hpp"
+#include <iterator>
+
+/// @brief Lazily splits a buffer by a delimiter and hands out sub pointers one at a time without allocating.
+/// @brief for(HBuffer& line : HBufferSplitter(buffer, "\r\n")){...}
+/// @brief The parts point into the split buffer so its data must outlive them. The delimiter is not copied and must outlive the splitter.
+/// @brief Like SubPointerSplitByDelimiter a delimiter at the very end does not produce an empty last part.
+class HBufferSplitter{
+public:
+    /// @param max the max amount of times to split by delimiter. Whatever is left after that is the last part
+    /// @param skipEmpty when true parts between two delimiters that touch are skipped and do not count towards max
+    HBufferSplitter(const HBuffer& buffer, char delim, size_t max = -1, bool skipEmpty = false) HBUFF_NOEXCEPT
+        : m_Buffer(buffer), m_Delim(nullptr), m_DelimLen(1), m_DelimChar(delim), m_SplitsLeft(max), m_SkipEmpty(skipEmpty){}
+    /// @param delim the delimiter of param delimLen bytes. Must not be empty
+    HBufferSplitter(const HBuffer& buffer, const char* delim, size_t delimLen, size_t max = -1, bool skipEmpty = false) HBUFF_NOEXCEPT
+        : m_Buffer(buffer), m_Delim(delim), m_DelimLen(std::max<size_t>(delimLen, 1)), m_DelimChar(delimLen > 0 ? delim[0] : '\0'), m_SplitsLeft(max), m_SkipEmpty(skipEmpty){
+        if(delimLen < 2)m_Delim = nullptr;
+    }
+    /// @param delim a null terminated delimiter
+    HBufferSplitter(const HBuffer& buffer, const char* delim) HBUFF_NOEXCEPT
+        : HBufferSplitter(buffer, delim, strlen(delim)){}
+
+    /// @brief moves onto the next part
+    /// @return returns false once there are no parts left. param part is left untouched in that case
+    bool Next(HBuffer& part) HBUFF_NOEXCEPT{
+        size_t size = m_Buffer.GetSize();
+        while(m_At < size){
+            size_t found = m_SplitsLeft > 0 ? FindDelim(m_At) : HBUFF_NPOS;
+            size_t start = m_At;
+            if(found == HBUFF_NPOS){
+                m_At = size;
+                part = m_Buffer.SubPointer(start, -1);
+                return true;
+            }
+            m_At = found + m_DelimLen;
+            if(m_SkipEmpty && found == start)continue;
+            m_SplitsLeft--;
+            part = m_Buffer.SubPointer(start, found - start);
+            return true;
+        }
+        return false;
+    }
+    /// @brief returns the offset in the split buffer the next part starts at
+    size_t GetPosition() const HBUFF_NOEXCEPT{return m_At;}
+    /// @brief returns the buffer being split
+    const HBuffer& GetBuffer() const HBUFF_NOEXCEPT{return m_Buffer;}
+public:
+    /// @brief Single pass iterator. Advancing it advances the splitter it came from
+    class Iterator{
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = HBuffer;
+        using difference_type = std::ptrdiff_t;
+        using pointer = HBuffer*;
+        using reference = HBuffer&;
+
+        Iterator() HBUFF_NOEXCEPT{}
+        explicit Iterator(HBufferSplitter* splitter) HBUFF_NOEXCEPT : m_Splitter(splitter){
+            ++(*this);
+        }
+
+        HBuffer& operator*() HBUFF_NOEXCEPT{return m_Part;}
+        HBuffer* operator->() HBUFF_NOEXCEPT{return &m_Part;}
+        Iterator& operator++() HBUFF_NOEXCEPT{
+            if(m_Splitter && !m_Splitter->Next(m_Part))m_Splitter = nullptr;
+            return *this;
+        }
+        bool operator==(const Iterator& right) const HBUFF_NOEXCEPT{return m_Splitter == right.m_Splitter;}
+        bool operator!=(const Iterator& right) const HBUFF_NOEXCEPT{return m_Splitter != right.m_Splitter;}
+    private:
+        HBufferSplitter* m_Splitter = nullptr;
+        HBuffer m_Part;
+    };
+
+    Iterator begin() HBUFF_NOEXCEPT{return Iterator(this);}
+    Iterator end() HBUFF_NOEXCEPT{return Iterator();}
+private:
+    size_t FindDelim(size_t from) const HBUFF_NOEXCEPT{
+        if(!m_Delim)return m_Buffer.Find(m_DelimChar, from);
+        return m_Buffer.Find(m_Delim, m_DelimLen, from);
+    }
+private:
+    HBuffer m_Buffer;
+    const char* m_Delim;
+    size_t m_DelimLen;
+    char m_DelimChar;
+    size_t m_SplitsLeft;
+    size_t m_At = 0;
+    bool m_SkipEmpty;
+};
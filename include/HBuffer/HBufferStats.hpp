@@ -0,0 +1,230 @@
+#pragma once
+#include "Core.h"
+
+/// Define HBUFFER_TRACK_ALLOCATIONS to count what HBuffers allocate. Without it every Record function is empty and snapshots are all zero.
+#ifdef HBUFFER_TRACK_ALLOCATIONS
+#include <mutex>
+#endif
+
+#ifndef HBUFF_STATS_FLUSH_BYTES
+/// Each thread adds up its allocated minus freed bytes and only moves them into the process wide count once they pass this many either way.
+/// The peak is updated on those moves so it can be off by this much per thread. 0 makes it exact at the cost of an atomic add per allocation
+#define HBUFF_STATS_FLUSH_BYTES 65536
+#endif
+
+/// Slack histogram bucket 0 counts 0 bytes of slack and bucket i counts [2^(i-1), 2^i). The last bucket also takes everything bigger
+#define HBUFF_STATS_SLACK_BUCKETS 24
+
+/// @brief Counters at one point in time. Bytes are capacities, so what was asked of the allocator, including shared block headers
+struct HBufferStatsSnapshot{
+    uint64_t m_Allocations = 0;
+    uint64_t m_Frees = 0;
+    /// @brief allocations that replaced data a buffer already had, mostly growing or copy on write
+    uint64_t m_Reallocations = 0;
+    /// @brief can be negative in a thread snapshot when the thread frees more than it allocated
+    int64_t m_BytesLive = 0;
+    int64_t m_PeakBytesLive = 0;
+    /// @brief capacity minus size of owned data at the moment it is freed or replaced
+    uint64_t m_SlackHistogram[HBUFF_STATS_SLACK_BUCKETS] = {};
+
+    /// @brief returns the histogram bucket param slack bytes fall into
+    static size_t GetSlackBucket(size_t slack) HBUFF_NOEXCEPT{
+        size_t bucket = 0;
+        while(slack > 0 && bucket < HBUFF_STATS_SLACK_BUCKETS - 1){
+            slack >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+};
+
+/// @brief Allocation counters for every HBuffer in the process, gated by HBUFFER_TRACK_ALLOCATIONS.
+/// @brief Every thread counts into its own shard so recording never contends. Only bytes live leave the shard, in batches, see HBUFF_STATS_FLUSH_BYTES
+class HBufferStats{
+public:
+#ifdef HBUFFER_TRACK_ALLOCATIONS
+    static constexpr bool s_Enabled = true;
+
+    static void RecordAllocate(size_t bytes) HBUFF_NOEXCEPT{
+        Shard* shard = GetShard();
+        if(!shard)return RecordRetired(static_cast<int64_t>(bytes), &Totals::m_Allocations);
+        Increment(shard->m_Allocations);
+        AddBytes(*shard, static_cast<int64_t>(bytes));
+    }
+    static void RecordFree(size_t bytes) HBUFF_NOEXCEPT{
+        Shard* shard = GetShard();
+        if(!shard)return RecordRetired(-static_cast<int64_t>(bytes), &Totals::m_Frees);
+        Increment(shard->m_Frees);
+        AddBytes(*shard, -static_cast<int64_t>(bytes));
+    }
+    static void RecordReallocate() HBUFF_NOEXCEPT{
+        Shard* shard = GetShard();
+        if(!shard)return RecordRetired(0, &Totals::m_Reallocations);
+        Increment(shard->m_Reallocations);
+    }
+    static void RecordSlack(size_t slack) HBUFF_NOEXCEPT{
+        Shard* shard = GetShard();
+        if(!shard)return;
+        Increment(shard->m_Slack[HBufferStatsSnapshot::GetSlackBucket(slack)]);
+    }
+
+    /// @brief returns the counters summed over every thread that ever recorded. Safe to call from any thread while others keep recording
+    static HBufferStatsSnapshot GetSnapshot() HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        HBufferStatsSnapshot snapshot;
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        registry.m_Retired.AddTo(snapshot);
+        for(Shard* shard : registry.m_Shards)shard->AddTo(snapshot);
+        snapshot.m_BytesLive += registry.m_BytesLive.load(std::memory_order_relaxed);
+        snapshot.m_PeakBytesLive = std::max(registry.m_PeakBytesLive.load(std::memory_order_relaxed), snapshot.m_BytesLive);
+        return snapshot;
+    }
+    /// @brief returns only what the calling thread recorded. Bytes live is what it allocated minus what it freed and the peak is the highest that got
+    static HBufferStatsSnapshot GetThreadSnapshot() HBUFF_NOEXCEPT{
+        HBufferStatsSnapshot snapshot;
+        Shard* shard = GetShard();
+        if(!shard)return snapshot;
+        shard->AddTo(snapshot);
+        snapshot.m_BytesLive = shard->m_ThreadBytesLive.load(std::memory_order_relaxed);
+        snapshot.m_PeakBytesLive = shard->m_ThreadPeakBytesLive.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+    /// @brief creates the calling thread's shard now. Otherwise the first record on a thread allocates it, in the middle of whatever allocation is being recorded
+    static void RegisterThread() HBUFF_NOEXCEPT{
+        GetShard();
+    }
+    /// @brief restarts the process wide peak from the bytes live right now, to measure the peak of one phase
+    static void ResetPeak() HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        registry.m_PeakBytesLive.store(registry.m_BytesLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+private:
+    typedef std::atomic<uint64_t> Counter;
+    /// @brief counts that survive the thread that made them
+    struct Totals{
+        uint64_t m_Allocations = 0;
+        uint64_t m_Frees = 0;
+        uint64_t m_Reallocations = 0;
+        uint64_t m_Slack[HBUFF_STATS_SLACK_BUCKETS] = {};
+
+        void AddTo(HBufferStatsSnapshot& snapshot) const HBUFF_NOEXCEPT{
+            snapshot.m_Allocations += m_Allocations;
+            snapshot.m_Frees += m_Frees;
+            snapshot.m_Reallocations += m_Reallocations;
+            for(size_t i = 0; i < HBUFF_STATS_SLACK_BUCKETS; i++)snapshot.m_SlackHistogram[i] += m_Slack[i];
+        }
+    };
+    /// @brief one thread's counters. Only the owning thread writes them, snapshots read them from other threads so they are atomics without read modify writes
+    struct Shard{
+        Counter m_Allocations{0};
+        Counter m_Frees{0};
+        Counter m_Reallocations{0};
+        Counter m_Slack[HBUFF_STATS_SLACK_BUCKETS] = {};
+        /// @brief bytes not yet moved into Registry::m_BytesLive
+        std::atomic<int64_t> m_PendingBytes{0};
+        std::atomic<int64_t> m_ThreadBytesLive{0};
+        std::atomic<int64_t> m_ThreadPeakBytesLive{0};
+
+        void AddTo(HBufferStatsSnapshot& snapshot) const HBUFF_NOEXCEPT{
+            snapshot.m_Allocations += m_Allocations.load(std::memory_order_relaxed);
+            snapshot.m_Frees += m_Frees.load(std::memory_order_relaxed);
+            snapshot.m_Reallocations += m_Reallocations.load(std::memory_order_relaxed);
+            snapshot.m_BytesLive += m_PendingBytes.load(std::memory_order_relaxed);
+            for(size_t i = 0; i < HBUFF_STATS_SLACK_BUCKETS; i++)snapshot.m_SlackHistogram[i] += m_Slack[i].load(std::memory_order_relaxed);
+        }
+    };
+    struct Registry{
+        std::mutex m_Mutex;
+        std::vector<Shard*> m_Shards;
+        Totals m_Retired;
+        std::atomic<int64_t> m_BytesLive{0};
+        std::atomic<int64_t> m_PeakBytesLive{0};
+    };
+    /// @brief registers a shard for the thread it lives on and folds it into the retired totals when the thread exits
+    struct ShardOwner{
+        Shard m_Shard;
+
+        ShardOwner() HBUFF_NOEXCEPT{
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+            registry.m_Shards.push_back(&m_Shard);
+        }
+        ~ShardOwner(){
+            Registry& registry = GetRegistry();
+            {
+                std::lock_guard<std::mutex> lock(registry.m_Mutex);
+                Totals& retired = registry.m_Retired;
+                retired.m_Allocations += m_Shard.m_Allocations.load(std::memory_order_relaxed);
+                retired.m_Frees += m_Shard.m_Frees.load(std::memory_order_relaxed);
+                retired.m_Reallocations += m_Shard.m_Reallocations.load(std::memory_order_relaxed);
+                for(size_t i = 0; i < HBUFF_STATS_SLACK_BUCKETS; i++)retired.m_Slack[i] += m_Shard.m_Slack[i].load(std::memory_order_relaxed);
+                registry.m_BytesLive.fetch_add(m_Shard.m_PendingBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                registry.m_Shards.erase(std::find(registry.m_Shards.begin(), registry.m_Shards.end(), &m_Shard));
+            }
+            ThreadState() = State::Retired;
+        }
+    };
+    enum class State : uint8_t{None, Live, Retired};
+private:
+    /// @brief returns the calling thread's shard or nullptr once its thread locals are being destroyed
+    static Shard* GetShard() HBUFF_NOEXCEPT{
+        if(ThreadState() == State::Retired)return nullptr;
+        thread_local ShardOwner owner;
+        ThreadState() = State::Live;
+        return &owner.m_Shard;
+    }
+    /// @brief trivially destructible so it can still be read after ShardOwner is gone
+    static State& ThreadState() HBUFF_NOEXCEPT{
+        thread_local State state = State::None;
+        return state;
+    }
+    /// @brief never freed so buffers destroyed during static destruction can still record
+    static Registry& GetRegistry() HBUFF_NOEXCEPT{
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+    static void Increment(Counter& counter) HBUFF_NOEXCEPT{
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    static void AddBytes(Shard& shard, int64_t bytes) HBUFF_NOEXCEPT{
+        int64_t live = shard.m_ThreadBytesLive.load(std::memory_order_relaxed) + bytes;
+        shard.m_ThreadBytesLive.store(live, std::memory_order_relaxed);
+        if(live > shard.m_ThreadPeakBytesLive.load(std::memory_order_relaxed))shard.m_ThreadPeakBytesLive.store(live, std::memory_order_relaxed);
+        int64_t pending = shard.m_PendingBytes.load(std::memory_order_relaxed) + bytes;
+        if(pending < HBUFF_STATS_FLUSH_BYTES && pending > -HBUFF_STATS_FLUSH_BYTES){
+            shard.m_PendingBytes.store(pending, std::memory_order_relaxed);
+            return;
+        }
+        shard.m_PendingBytes.store(0, std::memory_order_relaxed);
+        Flush(pending);
+    }
+    /// @brief moves param bytes into the process wide count and raises the peak if needed
+    static void Flush(int64_t bytes) HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        int64_t live = registry.m_BytesLive.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        int64_t peak = registry.m_PeakBytesLive.load(std::memory_order_relaxed);
+        while(live > peak && !registry.m_PeakBytesLive.compare_exchange_weak(peak, live, std::memory_order_relaxed)){}
+    }
+    /// @brief records straight into the retired totals for a thread whose shard is already gone
+    static void RecordRetired(int64_t bytes, uint64_t Totals::* counter) HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        {
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+            registry.m_Retired.*counter += 1;
+        }
+        if(bytes != 0)Flush(bytes);
+    }
+#else
+    static constexpr bool s_Enabled = false;
+
+    static void RecordAllocate(size_t) HBUFF_NOEXCEPT{}
+    static void RecordFree(size_t) HBUFF_NOEXCEPT{}
+    static void RecordReallocate() HBUFF_NOEXCEPT{}
+    static void RecordSlack(size_t) HBUFF_NOEXCEPT{}
+    static HBufferStatsSnapshot GetSnapshot() HBUFF_NOEXCEPT{return HBufferStatsSnapshot();}
+    static HBufferStatsSnapshot GetThreadSnapshot() HBUFF_NOEXCEPT{return HBufferStatsSnapshot();}
+    static void RegisterThread() HBUFF_NOEXCEPT{}
+    static void ResetPeak() HBUFF_NOEXCEPT{}
+#endif
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "HBuffer.hpp"
+#include "HBufferJoin.hpp"
+
+/// @brief Splits a stream that arrives in chunks, like socket reads, by a delimiter without rescanning or copying what it already looked at.
+/// @brief Append each chunk then call Next until it returns false. Bytes searched without finding the delimiter are remembered so every byte is searched once.
+/// @brief A token inside one chunk is a read only sub pointer into that chunk. Only a token that straddles two chunks is copied.
+/// @brief Tokens are valid until the next Append, Next or NextBytes call unless the chunks are shared (see HBuffer::MakeShared), then tokens keep their chunk alive.
+/// @brief The delimiter is not copied and must outlive the tokenizer. Not thread safe.
+class HBufferTokenizer{
+public:
+    explicit HBufferTokenizer(char delim) HBUFF_NOEXCEPT : m_Delim(nullptr), m_DelimLen(1), m_DelimChar(delim){}
+    /// @param delim the delimiter of param delimLen bytes. Must not be empty
+    HBufferTokenizer(const char* delim, size_t delimLen) HBUFF_NOEXCEPT
+        : m_Delim(delim), m_DelimLen(std::max<size_t>(delimLen, 1)), m_DelimChar(delimLen > 0 ? delim[0] : '\0'){
+        if(delimLen < 2)m_Delim = nullptr;
+    }
+    /// @param delim a null terminated delimiter
+    explicit HBufferTokenizer(const char* delim) HBUFF_NOEXCEPT : HBufferTokenizer(delim, strlen(delim)){}
+    HBufferTokenizer(const HBufferTokenizer&) = delete;
+    HBufferTokenizer& operator=(const HBufferTokenizer&) = delete;
+
+    /// @brief adds param chunk after the bytes not consumed yet. An owned chunk is moved in and freed once everything in it is consumed
+    /// @brief Only two chunks are held at once. If tokens are still left before the newest chunk they are copied together with it, so drain with Next first
+    void Append(HBuffer&& chunk) HBUFF_NOEXCEPT{
+        if(chunk.GetSize() == 0)return;
+        Compact();
+        HBuffer& first = m_Join.GetBuffer1();
+        HBuffer& second = m_Join.GetBuffer2();
+        if(first.GetSize() == 0){
+            first = std::move(chunk);
+            return;
+        }
+        if(second.GetSize() == 0){
+            second = std::move(chunk);
+            return;
+        }
+        Merge();
+        second = std::move(chunk);
+    }
+    /// @brief adds a non owning view of param chunk, or a reference if it is shared. Its data must outlive the tokens unless it is shared
+    void Append(const HBuffer& chunk) HBUFF_NOEXCEPT{
+        Append(HBuffer(chunk));
+    }
+
+    /// @brief moves onto the next token, the bytes before the next delimiter. The delimiter is skipped
+    /// @return returns false if no delimiter has arrived yet. Nothing is consumed and the bytes searched are not searched again
+    bool Next(HBuffer& token) HBUFF_NOEXCEPT{
+        Compact();
+        size_t found = FindDelim(std::max(m_Position, m_Scanned));
+        if(found == HBUFF_NPOS)return false;
+        token = Take(m_Position, found - m_Position);
+        m_Position = found + m_DelimLen;
+        m_Scanned = m_Position;
+        return true;
+    }
+    /// @brief moves onto the next param len bytes, for length prefixed formats
+    /// @return returns false if fewer than param len bytes are buffered. Nothing is consumed in that case
+    bool NextBytes(size_t len, HBuffer& token) HBUFF_NOEXCEPT{
+        Compact();
+        if(GetBufferedSize() < len)return false;
+        token = Take(m_Position, len);
+        m_Position += len;
+        m_Scanned = std::max(m_Scanned, m_Position);
+        return true;
+    }
+    /// @brief takes everything not consumed yet as one token, for the end of the stream where no delimiter follows the last token
+    /// @return returns false if nothing is buffered
+    bool TakeRest(HBuffer& token) HBUFF_NOEXCEPT{
+        return NextBytes(GetBufferedSize(), token) && token.GetSize() > 0;
+    }
+    /// @brief drops every chunk and starts over
+    void Clear() HBUFF_NOEXCEPT{
+        m_Join.GetBuffer1().Free();
+        m_Join.GetBuffer2().Free();
+        m_Position = 0;
+        m_Scanned = 0;
+        m_Merged = false;
+    }
+public:
+    /// @brief returns how many bytes are buffered and not consumed yet
+    size_t GetBufferedSize() const HBUFF_NOEXCEPT{return m_Join.GetSize() - m_Position;}
+    /// @brief returns how many bytes were copied because a token straddled two chunks or chunks had to be merged
+    size_t GetCopiedBytes() const HBUFF_NOEXCEPT{return m_CopiedBytes;}
+    /// @brief returns the chunks the tokenizer holds. Bytes before the position of the next token are already consumed
+    const HBufferJoin& GetJoin() const HBUFF_NOEXCEPT{return m_Join;}
+private:
+    /// @brief finds the first byte of the delimiter then checks the rest, which beats a substring search on the short spans between delimiters
+    /// @return returns HBUFF_NPOS and sets m_Scanned if there is no whole delimiter yet
+    size_t FindDelim(size_t from) HBUFF_NOEXCEPT{
+        size_t size = m_Join.GetSize();
+        while(true){
+            size_t found = m_Join.Find(m_DelimChar, from);
+            if(found == HBUFF_NPOS){
+                m_Scanned = size;
+                return HBUFF_NPOS;
+            }
+            if(!m_Delim)return found;
+            //A delimiter may start in the last few bytes and end in the next chunk so it is searched again from there
+            if(size - found < m_DelimLen){
+                m_Scanned = found;
+                return HBUFF_NPOS;
+            }
+            if(m_Join.StartsWith(found + 1, m_Delim + 1, m_DelimLen - 1))return found;
+            from = found + 1;
+        }
+    }
+    /// @brief returns param len bytes at param at as a sub pointer if they are inside one chunk or as a copy if they straddle both
+    HBuffer Take(size_t at, size_t len) HBUFF_NOEXCEPT{
+        const HBuffer& first = m_Join.GetBuffer1();
+        size_t len1 = first.GetSize();
+        if(len == 0)return HBuffer();
+        if(at + len <= len1)return first.SubPointer(at, len, false);
+        if(at >= len1)return m_Join.GetBuffer2().SubPointer(at - len1, len, false);
+        m_CopiedBytes += len;
+        return m_Join.SubString(at, len);
+    }
+    /// @brief drops the first chunk once every byte of it is consumed
+    void Compact() HBUFF_NOEXCEPT{
+        HBuffer& first = m_Join.GetBuffer1();
+        size_t len1 = first.GetSize();
+        if(len1 == 0 || m_Position < len1)return;
+        first = std::move(m_Join.GetBuffer2());
+        m_Join.GetBuffer2() = HBuffer();
+        m_Position -= len1;
+        m_Scanned -= len1;
+        m_Merged = false;
+    }
+    /// @brief moves the bytes not consumed yet into one owned chunk so a new one fits in the join.
+    /// @brief A token bigger than a chunk keeps landing here so a chunk merged before is grown in place instead of copied again
+    void Merge() HBUFF_NOEXCEPT{
+        HBuffer& first = m_Join.GetBuffer1();
+        HBuffer& second = m_Join.GetBuffer2();
+        m_CopiedBytes += second.GetSize();
+        if(m_Merged && m_Position == 0){
+            first.Append(second);
+        }
+        else{
+            size_t rest = GetBufferedSize();
+            HBuffer merged;
+            merged.Reserve(rest * 2);
+            merged.Append(first.GetData() + m_Position, first.GetSize() - m_Position);
+            merged.Append(second);
+            m_CopiedBytes += first.GetSize() - m_Position;
+            m_Scanned -= m_Position;
+            m_Position = 0;
+            first = std::move(merged);
+            m_Merged = true;
+        }
+        second = HBuffer();
+    }
+private:
+    /// @brief the oldest chunk with bytes left and the newest chunk
+    HBufferJoin m_Join;
+    const char* m_Delim;
+    size_t m_DelimLen;
+    char m_DelimChar;
+    /// @brief where the next token starts in m_Join
+    size_t m_Position = 0;
+    /// @brief bytes before this were searched and hold no delimiter that starts at or after m_Position
+    size_t m_Scanned = 0;
+    size_t m_CopiedBytes = 0;
+    /// @brief the first chunk is a copy made by Merge rather than one that was appended
+    bool m_Merged = false;
+};
@@ -0,0 +1,306 @@
+#pragma once
+#include "Core.h"
+#include "HBufferBinary.hpp"
+
+/// Define HBUFFER_TRACE to record every HBuffer allocation, reallocation, free and copy into a ring owned by the recording thread.
+/// Without it every Record function is empty and HBUFF_TRACE_SCOPE expands to nothing.
+#ifdef HBUFFER_TRACE
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifndef HBUFF_TRACE_RING_SIZE
+/// Events each thread can hold until the next Drain. Must be a power of two. Events past that are dropped and counted, never blocked on
+#define HBUFF_TRACE_RING_SIZE 65536
+#endif
+
+/// @brief what happened to a buffer
+enum class HBufferTraceEvent : uint8_t{
+    /// m_Size is the capacity allocated
+    Allocate = 0,
+    /// m_Size is the capacity asked for and m_OldSize the capacity it replaced. The memory itself also shows up as Allocate and Free
+    Reallocate = 1,
+    /// m_Size is the capacity freed
+    Free = 2,
+    /// a buffer was copy constructed or copy assigned. m_Size is its size
+    Copy = 3
+};
+
+/// @brief one event. m_Tag is 0 outside of any HBUFF_TRACE_SCOPE, see HBufferTrace::GetTag for its name
+struct HBufferTraceRecord{
+    /// @brief ticks of HBufferTrace::GetTimestamp. The cpu's time stamp counter where there is one
+    uint64_t m_Timestamp;
+    uint64_t m_Size;
+    uint64_t m_OldSize;
+    /// @brief the order threads first recorded in, starting at 0
+    uint32_t m_Thread;
+    uint16_t m_Tag;
+    HBufferTraceEvent m_Event;
+};
+
+/// @brief Event tracing for HBuffer memory traffic, gated by HBUFFER_TRACE.
+/// @brief Recording writes into the calling thread's own single producer ring without locks and never blocks. Drain collects every ring from any thread.
+/// @brief Put HBUFF_TRACE_SCOPE("name") at the top of a scope to tag everything recorded on that thread inside it, then look for tags with many Reallocate events.
+class HBufferTrace{
+public:
+    /// @brief file format written by WriteFile, every number little endian:
+    /// @brief "HBTRACE1", uint32 tag count, uint64 record count, uint64 dropped events, uint64 start ticks, uint64 start steady clock nanoseconds, uint64 end ticks, uint64 end steady clock nanoseconds.
+    /// @brief Then per tag a uint16 length and that many bytes, tag 0 first. Then per record uint64 timestamp, uint64 size, uint64 old size, uint32 thread, uint16 tag, uint8 event.
+    /// @brief The two tick and nanosecond pairs convert timestamps to time
+    static constexpr char s_FileMagic[8] = {'H', 'B', 'T', 'R', 'A', 'C', 'E', '1'};
+    static constexpr size_t s_RecordFileSize = 31;
+#ifdef HBUFFER_TRACE
+    static constexpr bool s_Enabled = true;
+
+    static void Record(HBufferTraceEvent event, size_t size, size_t oldSize = 0) HBUFF_NOEXCEPT{
+        Ring* ring = GetRing();
+        if(!ring)return;
+        size_t head = ring->m_Head.load(std::memory_order_relaxed);
+        if(head - ring->m_TailCache >= s_RingSize){
+            ring->m_TailCache = ring->m_Tail.load(std::memory_order_acquire);
+            if(head - ring->m_TailCache >= s_RingSize){
+                ring->m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        HBufferTraceRecord& record = ring->m_Records[head & (s_RingSize - 1)];
+        record.m_Timestamp = GetTimestamp();
+        record.m_Size = size;
+        record.m_OldSize = oldSize;
+        record.m_Thread = ring->m_Thread;
+        record.m_Tag = CurrentTag();
+        record.m_Event = event;
+        ring->m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    /// @brief creates the calling thread's ring now. Otherwise the first event a thread records allocates it, in the middle of whatever allocation is being recorded
+    static void RegisterThread() HBUFF_NOEXCEPT{
+        GetRing();
+    }
+
+    /// @brief returns the id of a new tag called param name, with param file and param line after it when given. Takes a lock, HBUFF_TRACE_SCOPE only calls it once per call site
+    static uint16_t RegisterTag(const char* name, const char* file = nullptr, int line = 0) HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        std::string tag = name;
+        if(file)tag += std::string("@") + file + ":" + std::to_string(line);
+        if(registry.m_Tags.size() > UINT16_MAX)return 0;
+        registry.m_Tags.push_back(tag);
+        return static_cast<uint16_t>(registry.m_Tags.size() - 1);
+    }
+    /// @brief returns the name param tag was registered with. Tag 0 is "untagged"
+    static std::string GetTag(uint16_t tag) HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        return tag < registry.m_Tags.size() ? registry.m_Tags[tag] : std::string();
+    }
+    /// @brief returns the tag events on this thread get right now. Changed by HBufferTraceScope
+    static uint16_t& CurrentTag() HBUFF_NOEXCEPT{
+        thread_local uint16_t tag = 0;
+        return tag;
+    }
+
+    /// @brief moves every event recorded so far by every thread into param records, oldest first per thread. Any thread, one drain at a time
+    /// @return returns the amount of events added
+    static size_t Drain(std::vector<HBufferTraceRecord>& records) HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        size_t start = records.size();
+        for(size_t i = 0; i < registry.m_Rings.size();){
+            Ring* ring = registry.m_Rings[i];
+            size_t tail = ring->m_Tail.load(std::memory_order_relaxed);
+            size_t head = ring->m_Head.load(std::memory_order_acquire);
+            for(; tail != head; tail++)records.push_back(ring->m_Records[tail & (s_RingSize - 1)]);
+            ring->m_Tail.store(tail, std::memory_order_release);
+            registry.m_Dropped += ring->m_Dropped.exchange(0, std::memory_order_relaxed);
+            //The thread is gone and everything it recorded has been read
+            if(ring->m_Retired.load(std::memory_order_acquire) && ring->m_Head.load(std::memory_order_acquire) == tail){
+                delete ring;
+                registry.m_Rings.erase(registry.m_Rings.begin() + i);
+            }
+            else i++;
+        }
+        return records.size() - start;
+    }
+    /// @brief returns how many events were dropped because a ring was full, up to the last Drain
+    static uint64_t GetDropped() HBUFF_NOEXCEPT{
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.m_Mutex);
+        return registry.m_Dropped;
+    }
+    /// @brief drains every ring and writes the events to param path, see s_FileMagic for the format
+    /// @return returns false if the file could not be written
+    static bool DumpToFile(const char* path) HBUFF_NOEXCEPT{
+        std::vector<HBufferTraceRecord> records;
+        //Growing records allocates through new, not HBuffer, so draining records nothing itself
+        Drain(records);
+        return WriteFile(path, records);
+    }
+    /// @brief writes param records to param path, see s_FileMagic for the format
+    static bool WriteFile(const char* path, const std::vector<HBufferTraceRecord>& records) HBUFF_NOEXCEPT{
+        FILE* file = fopen(path, "wb");
+        if(!file)return false;
+        Registry& registry = GetRegistry();
+        std::vector<std::string> tags;
+        uint64_t dropped;
+        {
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+            tags = registry.m_Tags;
+            dropped = registry.m_Dropped;
+        }
+        char header[sizeof(s_FileMagic) + 4 + 8 * 6];
+        char* at = header;
+        memcpy(at, s_FileMagic, sizeof(s_FileMagic));
+        at += sizeof(s_FileMagic);
+        at = Store(at, static_cast<uint32_t>(tags.size()));
+        at = Store(at, static_cast<uint64_t>(records.size()));
+        at = Store(at, dropped);
+        at = Store(at, registry.m_StartTicks);
+        at = Store(at, registry.m_StartNanoseconds);
+        at = Store(at, GetTimestamp());
+        at = Store(at, GetNanoseconds());
+        bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+        for(size_t i = 0; i < tags.size() && written; i++){
+            char length[2];
+            size_t len = std::min<size_t>(tags[i].size(), UINT16_MAX);
+            Store(length, static_cast<uint16_t>(len));
+            written = fwrite(length, 1, 2, file) == 2 && fwrite(tags[i].data(), 1, len, file) == len;
+        }
+        for(size_t i = 0; i < records.size() && written; i++){
+            const HBufferTraceRecord& record = records[i];
+            char out[s_RecordFileSize];
+            at = Store(out, record.m_Timestamp);
+            at = Store(at, record.m_Size);
+            at = Store(at, record.m_OldSize);
+            at = Store(at, record.m_Thread);
+            at = Store(at, record.m_Tag);
+            *at = static_cast<char>(record.m_Event);
+            written = fwrite(out, 1, sizeof(out), file) == sizeof(out);
+        }
+        return fclose(file) == 0 && written;
+    }
+
+    /// @brief returns the cpu's time stamp counter on x86 and the virtual counter on arm64. Anything else gets steady clock nanoseconds
+    static uint64_t GetTimestamp() HBUFF_NOEXCEPT{
+    #if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+    #elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+    #elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+    #else
+        return GetNanoseconds();
+    #endif
+    }
+private:
+    static constexpr size_t s_RingSize = HBUFF_TRACE_RING_SIZE;
+    static_assert(s_RingSize > 0 && (s_RingSize & (s_RingSize - 1)) == 0, "HBUFF_TRACE_RING_SIZE must be a power of two");
+    /// @brief one thread's events. The thread is the only producer and Drain the only consumer
+    struct Ring{
+        std::unique_ptr<HBufferTraceRecord[]> m_Records{new HBufferTraceRecord[s_RingSize]};
+        uint32_t m_Thread = 0;
+        std::atomic<bool> m_Retired{false};
+        alignas(HBUFF_CACHE_LINE_SIZE) std::atomic<size_t> m_Head{0};
+        size_t m_TailCache = 0;
+        std::atomic<uint64_t> m_Dropped{0};
+        alignas(HBUFF_CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{0};
+    };
+    struct Registry{
+        std::mutex m_Mutex;
+        std::vector<Ring*> m_Rings;
+        std::vector<std::string> m_Tags{"untagged"};
+        uint32_t m_NextThread = 0;
+        uint64_t m_Dropped = 0;
+        uint64_t m_StartTicks = GetTimestamp();
+        uint64_t m_StartNanoseconds = GetNanoseconds();
+    };
+    /// @brief hands the thread's ring to the registry and marks it retired when the thread exits so Drain can still read and then free it
+    struct RingOwner{
+        Ring* m_Ring = new Ring;
+
+        RingOwner() HBUFF_NOEXCEPT{
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.m_Mutex);
+            m_Ring->m_Thread = registry.m_NextThread++;
+            registry.m_Rings.push_back(m_Ring);
+        }
+        ~RingOwner(){
+            ThreadState() = State::Retired;
+            m_Ring->m_Retired.store(true, std::memory_order_release);
+        }
+    };
+    enum class State : uint8_t{None, Live, Retired};
+private:
+    /// @brief returns the calling thread's ring or nullptr once its thread locals are being destroyed
+    static Ring* GetRing() HBUFF_NOEXCEPT{
+        if(ThreadState() == State::Retired)return nullptr;
+        thread_local RingOwner owner;
+        ThreadState() = State::Live;
+        return owner.m_Ring;
+    }
+    static State& ThreadState() HBUFF_NOEXCEPT{
+        thread_local State state = State::None;
+        return state;
+    }
+    /// @brief never freed so buffers destroyed during static destruction can still record
+    static Registry& GetRegistry() HBUFF_NOEXCEPT{
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+    static uint64_t GetNanoseconds() HBUFF_NOEXCEPT{
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    template<typename T>
+    static char* Store(char* at, T value) HBUFF_NOEXCEPT{
+        HBufferBinary::Store(at, value, HBufferEndian::Little);
+        return at + sizeof(T);
+    }
+#else
+    static constexpr bool s_Enabled = false;
+
+    static void Record(HBufferTraceEvent, size_t, size_t = 0) HBUFF_NOEXCEPT{}
+    static void RegisterThread() HBUFF_NOEXCEPT{}
+    static uint16_t RegisterTag(const char*, const char* = nullptr, int = 0) HBUFF_NOEXCEPT{return 0;}
+    static uint16_t CurrentTag() HBUFF_NOEXCEPT{return 0;}
+    static std::string GetTag(uint16_t) HBUFF_NOEXCEPT{return std::string();}
+    static size_t Drain(std::vector<HBufferTraceRecord>&) HBUFF_NOEXCEPT{return 0;}
+    static uint64_t GetDropped() HBUFF_NOEXCEPT{return 0;}
+    static bool DumpToFile(const char*) HBUFF_NOEXCEPT{return false;}
+    static bool WriteFile(const char*, const std::vector<HBufferTraceRecord>&) HBUFF_NOEXCEPT{return false;}
+    static uint64_t GetTimestamp() HBUFF_NOEXCEPT{return 0;}
+#endif
+};
+
+#ifdef HBUFFER_TRACE
+/// @brief tags every event the thread records while it is alive with param tag and puts the previous tag back after
+class HBufferTraceScope{
+public:
+    explicit HBufferTraceScope(uint16_t tag) HBUFF_NOEXCEPT : m_Previous(HBufferTrace::CurrentTag()){
+        HBufferTrace::CurrentTag() = tag;
+    }
+    ~HBufferTraceScope(){
+        HBufferTrace::CurrentTag() = m_Previous;
+    }
+    HBufferTraceScope(const HBufferTraceScope&) = delete;
+    HBufferTraceScope& operator=(const HBufferTraceScope&) = delete;
+private:
+    uint16_t m_Previous;
+};
+
+#define HBUFF_TRACE_CONCAT_INNER(a, b) a##b
+#define HBUFF_TRACE_CONCAT(a, b) HBUFF_TRACE_CONCAT_INNER(a, b)
+/// Tags the rest of the scope with param name and where it is written. The tag is registered once per call site
+#define HBUFF_TRACE_SCOPE(name) \
+    static const uint16_t HBUFF_TRACE_CONCAT(hbuffTraceTag, __LINE__) = HBufferTrace::RegisterTag(name, __FILE__, __LINE__); \
+    HBufferTraceScope HBUFF_TRACE_CONCAT(hbuffTraceScope, __LINE__)(HBUFF_TRACE_CONCAT(hbuffTraceTag, __LINE__))
+#else
+#define HBUFF_TRACE_SCOPE(name)
+#endif
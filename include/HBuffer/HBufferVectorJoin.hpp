@@ -1,222 +1,419 @@
-#pragma once
-
-#include "Core.h"
-#include "HBuffer.hpp"
-
-/// TODO: finish because this is not ready to publish
-
-struct HBufferVectorJoinIndexInfo{
-    /// @brief the entire buffer of data at the indice.
-    HBuffer m_Vector;
-    /// @brief the indice into the vectors buffer
-    size_t m_Indice = 0;
-    /// @brief the amounf of data before that buffer
-    size_t m_TotalBefore=0;
-    /// @brief the byte offset inside the buffer where that data resides
-    size_t m_ByteOffset = 0;
-    bool m_Valid = false;
-};
-/// @brief A vector of type std::vector<HBuffer>
-template <typename Allocator=std::allocator<HBuffer>>
-class HBufferVectorJoin{
-public:
-    HBufferVectorJoin() HBUFF_NOEXCEPT{}
-    ~HBufferVectorJoin() HBUFF_NOEXCEPT{}
-
-    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
-        size_t at = 0;
-        for(size_t i = 0; i < m_Vectors.size();i++){
-            HBuffer& reference = m_Vectors[i];
-            for(size_t j = 0; j < reference.GetSize(); i++){
-                if(reference.At(j) != str[at])return false;
-                if(at >= len)return true;
-                at++;
-            }
-        }
-
-        return at >= len;
-    }
-    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{return false;}
-    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{return false;}
-
-    void Reserve(size_t size)HBUFF_NOEXCEPT{
-        m_Vectors.reserve(size);
-        m_Indices.reserve(size);
-    }
-
-    void Resize(size_t size)HBUFF_NOEXCEPT{
-        m_Vectors.resize(size);
-        m_Indices.resize(size);
-    }
-    void Clear()HBUFF_NOEXCEPT{
-        m_Vectors.clear();
-        m_Indices.clear();
-    }
-
-    /// @brief returns the character at param at if inside the buffer else \0
-    char Get(size_t at)const HBUFF_NOEXCEPT{
-        if(m_Indices.size() < 1)return '\0';
-        size_t index = -1;
-        size_t totalBefore=0;
-        for(index = 0; index < m_Indices.size(); index++){
-            size_t total = m_Indices[index];
-            if(at >= total){
-                totalBefore = total;
-                break;
-            }
-        }
-        if(index == -1)return '\0';
-        HBuffer& vec = m_Vectors[index];
-        size_t relativeAt = at - totalBefore;
-        /// TODO: think and maybe change to vec.At()
-        return vec.Get(relativeAt);
-    }
-
-    /// @brief returns the character reference at the character at.
-    /// @brief will segfault if at is outside of the buffers ranges. No Safety Checks.
-    char& At(size_t at)const HBUFF_NOEXCEPT{
-        size_t index = -1;
-        size_t totalBefore=0;
-        for(index = 0; index < m_Indices.size(); index++){
-            size_t total = m_Indices[index];
-            if(at >= total){
-                totalBefore = total;
-                break;
-            }
-        }
-        HBuffer& vec = m_Vectors[index];
-        size_t relativeAt = at - totalBefore;
-        /// TODO: think and maybe change to vec.At()
-        return vec[relativeAt];
-    }
-
-    /// @brief creates a single null terminated ascii string starting at at and is size len
-    /// @brief at the position to start copying from
-    /// @param len the length of the ascii bytes in the new string. will be maxed out at the buffers
-    HBuffer SubString(size_t at, size_t len=-1)const HBUFF_NOEXCEPT{
-        HBuffer string;
-        size_t totalLen = 0;
-        size_t startIndex;
-        size_t totalBefore = -1;
-        size_t indicesSize = m_Indices.size();
-        for(startIndex = 0; startIndex < indicesSize; startIndex++){
-            size_t total = m_Indices[startIndex];
-            if(at < total + m_Vectors[startIndex].GetSize()){
-                /// Getting max possible string length
-                totalBefore = total;
-                size_t maxLength = m_Indices[indicesSize - 1] + m_Vectors[indicesSize - 1].GetSize();
-                totalLen = std::min(maxLength - at, len);
-                string.ReserveString(totalLen);
-                break;
-            }
-        }
-
-        if(totalBefore == -1){
-            string.ReserveString(0);
-            return std::move(string);
-        }
-
-        size_t accumulatedLength = 0;
-        for(size_t index = startIndex; index < indicesSize; index++){
-            const HBuffer& referenceBuffer = m_Vectors[index];
-            size_t bufferAt = index == startIndex ? at - totalBefore : 0;
-            size_t bufferLen = std::min(referenceBuffer.GetSize() - bufferAt, totalLen - accumulatedLength);
-            HBuffer data = referenceBuffer.SubBuffer(bufferAt, bufferLen);
-            string.Append(data);
-            accumulatedLength += bufferLen;
-            if(accumulatedLength >= totalLen)break;
-        }
-        return string;
-    }
-
-    /// TODO: Sub join. Kinda like subpointer on Hbuffer except we dont want to allocate any data except for the m_Vectors and m_Indices
-    HBufferVectorJoin SubJoin()const noexcept{
-        HBufferVectorJoin join;
-
-        return join;
-    }
-    
-    size_t GetSize()const noexcept{
-        if(m_Indices.size() < 1)return 0;
-        return m_Indices.back() + m_Vectors.back().GetSize();
-    }
-
-    HBufferVectorJoinIndexInfo GetInfo(size_t at)const HBUFF_NOEXCEPT{
-        for(size_t i = 0; i < m_Indices.size(); i++){
-            size_t totalBefore = m_Indices[i];
-            HBuffer vector = m_Vectors[i];
-            if(totalBefore + vector.GetSize() < at)continue;
-            HBufferVectorJoinIndexInfo info;
-            info.m_Vector = vector;
-            info.m_Indice = i;
-            info.m_Valid = true;
-            info.m_ByteOffset = at - totalBefore;
-            info.m_TotalBefore = totalBefore;
-            return info;
-        }
-        return HBufferVectorJoinIndexInfo{};
-    }
-    template <typename... Args>
-    void EmplaceBack(Args&&... args) HBUFF_NOEXCEPT{
-        size_t lastIndice = 0;
-        size_t vecSize = 0;
-        size_t indicesSize = m_Indices.size();
-        if(indicesSize > 0){
-            size_t indice = indicesSize - 1;
-            lastIndice = m_Indices[indice];
-            vecSize = m_Vectors[indice].GetSize();
-        }
-        m_Vectors.emplace_back(std::forward<Args>(args)...);
-        m_Indices.emplace_back(lastIndice + vecSize);
-    }
-
-    void EmplaceBack(const HBuffer& buffer)HBUFF_NOEXCEPT{
-        size_t lastIndice = 0;
-        size_t vecSize = 0;
-        size_t indicesSize = m_Indices.size();
-        if(indicesSize > 0){
-            size_t indice = indicesSize - 1;
-            lastIndice = m_Indices[indice];
-            vecSize = m_Vectors[indice].GetSize();
-        }
-        m_Vectors.emplace_back(buffer);
-        m_Indices.emplace_back(lastIndice + vecSize);
-    }
-    
-    void EmplaceBack(HBuffer&& buffer)HBUFF_NOEXCEPT{
-        size_t lastIndice = 0;
-        size_t vecSize = 0;
-        size_t indicesSize = m_Indices.size();
-        if(indicesSize > 0){
-            size_t indice = indicesSize - 1;
-            lastIndice = m_Indices[indice];
-            vecSize = m_Vectors[indice].GetSize();
-        }
-        m_Vectors.emplace_back(std::move(buffer));
-        m_Indices.emplace_back(lastIndice + vecSize);
-    }
-
-    void Erase(size_t at)HBUFF_NOEXCEPT{
-        size_t vectorSize = m_Vectors.size();
-        if(vectorSize < 0)return;
-        if(at >= vectorSize)return;
-        for(size_t i = at + 1; i < m_Vectors.size();i++){
-            m_Indices[i] = m_Indices[i - 1];
-        }
-        m_Vectors.erase(m_Vectors.begin() + at);
-        m_Indices.erase(m_Indices.begin() + at);
-    }
-
-    HBuffer& Back()const HBUFF_NOEXCEPT{
-        return (HBuffer&)m_Vectors.back();
-    }
-public:
-    std::vector<HBuffer, Allocator>& GetVectors()const HBUFF_NOEXCEPT{return (std::vector<HBuffer, Allocator>&)m_Vectors;}
-    std::vector<size_t>& GetIndices()const HBUFF_NOEXCEPT{return (std::vector<size_t>&)m_Indices;}
-private:
-    std::vector<HBuffer, Allocator> m_Vectors;
-    /// @brief a vector where each node contains the sizes of all vectors before it
-    /// Example: vec size 15, vec size 20, vec size 2
-    /// Values: 0, 15, 35
-    std::vector<size_t> m_Indices;
+#pragma once
+
+#include "Core.h"
+#include "HBuffer.hpp"
+#include "HBufferScatter.hpp"
+#include <algorithm>
+#include <iterator>
+
+/// TODO: finish because this is not ready to publish
+
+struct HBufferVectorJoinIndexInfo{
+    /// @brief the entire buffer of data at the indice.
+    HBuffer m_Vector;
+    /// @brief the indice into the vectors buffer
+    size_t m_Indice = 0;
+    /// @brief the amounf of data before that buffer
+    size_t m_TotalBefore=0;
+    /// @brief the byte offset inside the buffer where that data resides
+    size_t m_ByteOffset = 0;
+    bool m_Valid = false;
+};
+/// @brief A vector of type std::vector<HBuffer>
+template <typename Allocator=std::allocator<HBuffer>>
+class HBufferVectorJoin{
+public:
+    /// @brief remembers the buffer the last lookup landed in so reading offsets front to back is O(1) per byte instead of a binary search.
+    /// @brief Each reader keeps its own so a const join is safe to read from many threads. A cursor left over from before the join changed is still safe to pass, it just misses
+    struct Cursor{
+        size_t m_Segment = 0;
+    };
+
+    HBufferVectorJoin() HBUFF_NOEXCEPT{}
+    ~HBufferVectorJoin() HBUFF_NOEXCEPT{}
+
+    bool StartsWith(const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return MatchesAt(0, str, len);
+    }
+    bool StartsWith(size_t at, const char* str) const HBUFF_NOEXCEPT{
+        return MatchesAt(at, str, strlen(str));
+    }
+    bool StartsWith(size_t at, const char* str, size_t len) const HBUFF_NOEXCEPT{
+        return MatchesAt(at, str, len);
+    }
+
+    void Reserve(size_t size)HBUFF_NOEXCEPT{
+        m_Vectors.reserve(size);
+        m_Indices.reserve(size);
+    }
+
+    void Resize(size_t size)HBUFF_NOEXCEPT{
+        m_Vectors.resize(size);
+        m_Indices.resize(size);
+    }
+    void Clear()HBUFF_NOEXCEPT{
+        m_Vectors.clear();
+        m_Indices.clear();
+    }
+
+    /// @brief returns the character at param at if inside the buffer else \0
+    char Get(size_t at)const HBUFF_NOEXCEPT{
+        Cursor cursor;
+        return Get(at, cursor);
+    }
+    /// @brief same as Get(size_t at) but starts looking where param cursor last landed and moves it to where this lands
+    char Get(size_t at, Cursor& cursor)const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at, cursor);
+        if(segment >= m_Vectors.size())return '\0';
+        return m_Vectors[segment].At(at - m_Indices[segment]);
+    }
+
+    /// @brief returns the character reference at the character at.
+    /// @brief will segfault if at is outside of the buffers ranges. No Safety Checks.
+    char& At(size_t at)const HBUFF_NOEXCEPT{
+        Cursor cursor;
+        return At(at, cursor);
+    }
+    char& At(size_t at, Cursor& cursor)const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at, cursor);
+        return m_Vectors[segment].GetData()[at - m_Indices[segment]];
+    }
+
+    /// @brief creates a single null terminated ascii string starting at at and is size len
+    /// @brief at the position to start copying from
+    /// @param len the length of the ascii bytes in the new string. will be maxed out at the buffers
+    HBuffer SubString(size_t at, size_t len=-1)const HBUFF_NOEXCEPT{
+        HBuffer string;
+        size_t size = GetSize();
+        size_t totalLen = at < size ? std::min(size - at, len) : 0;
+        string.ReserveString(totalLen);
+        CopyTo(string.GetData(), at, totalLen);
+        string.GetData()[totalLen] = '\0';
+        string.AssignSize(totalLen);
+        return string;
+    }
+
+    /// @brief copies param len bytes starting at param at into param dest with one memcpy per buffer they span
+    /// @param len the amount of bytes to copy. Caps out at the end of the join
+    /// @return returns the amount of bytes copied
+    size_t CopyTo(char* dest, size_t at = 0, size_t len = -1)const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at);
+        if(segment >= m_Vectors.size())return 0;
+        size_t offset = at - m_Indices[segment];
+        size_t copied = 0;
+        for(; segment < m_Vectors.size() && copied < len; segment++){
+            const HBuffer& buffer = m_Vectors[segment];
+            size_t count = std::min(buffer.GetSize() - offset, len - copied);
+            if(count > 0)memcpy(dest + copied, buffer.GetData() + offset, count);
+            copied += count;
+            offset = 0;
+        }
+        return copied;
+    }
+    /// @brief appends param len bytes starting at param at to the end of param dest
+    /// @return returns the amount of bytes copied
+    size_t CopyTo(HBuffer& dest, size_t at = 0, size_t len = -1)const HBUFF_NOEXCEPT{
+        size_t size = GetSize();
+        if(at >= size)return 0;
+        len = std::min(size - at, len);
+        return CopyTo(dest.Extend(len), at, len);
+    }
+
+    /// @brief finds the first param c at or after param from across every buffer
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t Find(char c, size_t from = 0)const HBUFF_NOEXCEPT{
+        for(size_t i = FirstSegment(from); i < m_Vectors.size(); i++){
+            const HBuffer& buffer = m_Vectors[i];
+            size_t start = m_Indices[i];
+            if(start + buffer.GetSize() <= from)continue;
+            size_t found = buffer.Find(c, from > start ? from - start : 0);
+            if(found != HBUFF_NPOS)return start + found;
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first occurrence of param str at or after param from. Matches may span any amount of buffers
+    /// @return returns the index the match starts at in the join or HBUFF_NPOS if not found
+    size_t Find(const char* str, size_t len, size_t from = 0)const HBUFF_NOEXCEPT{
+        if(len < 1)return from <= GetSize() ? from : HBUFF_NPOS;
+        for(size_t i = FirstSegment(from); i < m_Vectors.size(); i++){
+            const HBuffer& buffer = m_Vectors[i];
+            size_t start = m_Indices[i];
+            size_t size = buffer.GetSize();
+            if(start + size <= from)continue;
+            size_t local = from > start ? from - start : 0;
+            //Any match that fits inside this buffer starts before any match that crosses into the next one
+            size_t found = buffer.Find(str, len, local);
+            if(found != HBUFF_NPOS)return start + found;
+            for(size_t at = std::max(local, size >= len ? size - len + 1 : 0); at < size; at++){
+                at = buffer.Find(str[0], at);
+                if(at == HBUFF_NPOS)break;
+                if(MatchesAt(start + at, str, len))return start + at;
+            }
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first occurrence of the null terminated param str
+    size_t Find(const char* str)const HBUFF_NOEXCEPT{
+        return Find(str, strlen(str));
+    }
+    /// @brief finds the last param c across every buffer
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t FindLast(char c)const HBUFF_NOEXCEPT{
+        for(size_t i = m_Vectors.size(); i > 0; i--){
+            size_t found = m_Vectors[i - 1].FindLast(c);
+            if(found != HBUFF_NPOS)return m_Indices[i - 1] + found;
+        }
+        return HBUFF_NPOS;
+    }
+    /// @brief finds the first byte at or after param from that is any of the bytes in param set
+    /// @return returns the index of the byte in the join or HBUFF_NPOS if not found
+    size_t FindFirstOf(const char* set, size_t setLen, size_t from = 0)const HBUFF_NOEXCEPT{
+        for(size_t i = FirstSegment(from); i < m_Vectors.size(); i++){
+            const HBuffer& buffer = m_Vectors[i];
+            size_t start = m_Indices[i];
+            if(start + buffer.GetSize() <= from)continue;
+            size_t found = buffer.FindFirstOf(set, setLen, from > start ? from - start : 0);
+            if(found != HBUFF_NPOS)return start + found;
+        }
+        return HBUFF_NPOS;
+    }
+
+    /// @brief creates a join of param len bytes starting at param at out of sub pointers to the buffers they span. No bytes are copied
+    /// @brief The views point into the buffers of this join so their data must outlive the sub join
+    /// @param len the amount of bytes in the sub join. Caps out at the end of the join
+    /// @param allowModify passed on to every SubPointer
+    HBufferVectorJoin SubJoin(size_t at, size_t len = -1, bool allowModify = true)const HBUFF_NOEXCEPT{
+        HBufferVectorJoin join;
+        size_t segment = FindSegment(at);
+        if(segment >= m_Vectors.size())return join;
+        size_t offset = at - m_Indices[segment];
+        size_t taken = 0;
+        for(; segment < m_Vectors.size() && taken < len; segment++){
+            const HBuffer& buffer = m_Vectors[segment];
+            size_t count = std::min(buffer.GetSize() - offset, len - taken);
+            if(count > 0)join.EmplaceBack(buffer.SubPointer(offset, count, allowModify));
+            taken += count;
+            offset = 0;
+        }
+        return join;
+    }
+
+    size_t GetSize()const noexcept{
+        if(m_Indices.size() < 1)return 0;
+        return m_Indices.back() + m_Vectors.back().GetSize();
+    }
+
+    HBufferVectorJoinIndexInfo GetInfo(size_t at)const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at);
+        if(segment >= m_Vectors.size())return HBufferVectorJoinIndexInfo{};
+        HBufferVectorJoinIndexInfo info;
+        info.m_Vector = m_Vectors[segment];
+        info.m_Indice = segment;
+        info.m_Valid = true;
+        info.m_TotalBefore = m_Indices[segment];
+        info.m_ByteOffset = at - info.m_TotalBefore;
+        return info;
+    }
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) HBUFF_NOEXCEPT{
+        size_t lastIndice = 0;
+        size_t vecSize = 0;
+        size_t indicesSize = m_Indices.size();
+        if(indicesSize > 0){
+            size_t indice = indicesSize - 1;
+            lastIndice = m_Indices[indice];
+            vecSize = m_Vectors[indice].GetSize();
+        }
+        m_Vectors.emplace_back(std::forward<Args>(args)...);
+        m_Indices.emplace_back(lastIndice + vecSize);
+    }
+
+    void EmplaceBack(const HBuffer& buffer)HBUFF_NOEXCEPT{
+        size_t lastIndice = 0;
+        size_t vecSize = 0;
+        size_t indicesSize = m_Indices.size();
+        if(indicesSize > 0){
+            size_t indice = indicesSize - 1;
+            lastIndice = m_Indices[indice];
+            vecSize = m_Vectors[indice].GetSize();
+        }
+        m_Vectors.emplace_back(buffer);
+        m_Indices.emplace_back(lastIndice + vecSize);
+    }
+    
+    void EmplaceBack(HBuffer&& buffer)HBUFF_NOEXCEPT{
+        size_t lastIndice = 0;
+        size_t vecSize = 0;
+        size_t indicesSize = m_Indices.size();
+        if(indicesSize > 0){
+            size_t indice = indicesSize - 1;
+            lastIndice = m_Indices[indice];
+            vecSize = m_Vectors[indice].GetSize();
+        }
+        m_Vectors.emplace_back(std::move(buffer));
+        m_Indices.emplace_back(lastIndice + vecSize);
+    }
+
+    void Erase(size_t at)HBUFF_NOEXCEPT{
+        size_t vectorSize = m_Vectors.size();
+        if(vectorSize < 0)return;
+        if(at >= vectorSize)return;
+        m_Vectors.erase(m_Vectors.begin() + at);
+        m_Indices.erase(m_Indices.begin() + at);
+        //Everything after the erased buffer moves back by its size
+        for(size_t i = at; i < m_Vectors.size();i++){
+            m_Indices[i] = i == 0 ? 0 : m_Indices[i - 1] + m_Vectors[i - 1].GetSize();
+        }
+    }
+
+    HBuffer& Back()const HBUFF_NOEXCEPT{
+        return (HBuffer&)m_Vectors.back();
+    }
+
+    /// @brief makes every buffer safe to write into without changing any other buffer. See HBuffer::Detach
+    void Detach()HBUFF_NOEXCEPT{
+        for(HBuffer& buffer : m_Vectors)buffer.Detach();
+    }
+    /// @brief drops the first param len bytes. Buffers that are used up are erased and the one cut in half keeps its second part, see HBuffer::RemovePrefix
+    void RemovePrefix(size_t len)HBUFF_NOEXCEPT{
+        len = std::min(len, GetSize());
+        if(len < 1)return;
+        size_t segment = FindSegment(len);
+        size_t offset = segment < m_Vectors.size() ? len - m_Indices[segment] : 0;
+        m_Vectors.erase(m_Vectors.begin(), m_Vectors.begin() + segment);
+        m_Indices.erase(m_Indices.begin(), m_Indices.begin() + segment);
+        if(!m_Vectors.empty())m_Vectors[0].RemovePrefix(offset);
+        for(size_t i = 0; i < m_Indices.size(); i++){
+            m_Indices[i] = i == 0 ? 0 : m_Indices[i - 1] + m_Vectors[i - 1].GetSize();
+        }
+    }
+#if !defined(_WIN32)
+    /// @brief points up to param max iovecs at the bytes starting at param at, one per non empty buffer
+    /// @return returns the amount of iovecs filled
+    size_t GetIOVecs(iovec* vecs, size_t max, size_t at = 0)const HBUFF_NOEXCEPT{
+        size_t count = 0;
+        size_t segment = FindSegment(at);
+        size_t offset = segment < m_Vectors.size() ? at - m_Indices[segment] : 0;
+        for(; segment < m_Vectors.size() && count < max; segment++){
+            const HBuffer& buffer = m_Vectors[segment];
+            if(buffer.GetSize() > offset)vecs[count++] = iovec{buffer.GetData() + offset, buffer.GetSize() - offset};
+            offset = 0;
+        }
+        return count;
+    }
+    /// @brief writes the join to param fd with writev and removes what was written from the front. See HBufferScatter::WriteTo
+    ssize_t WriteTo(int fd)HBUFF_NOEXCEPT{
+        return HBufferScatter::WriteTo(fd, *this);
+    }
+    /// @brief reads from param fd into the join's bytes with readv, first buffer first. See HBufferScatter::ReadFrom
+    ssize_t ReadFrom(int fd)HBUFF_NOEXCEPT{
+        return HBufferScatter::ReadFrom(fd, *this);
+    }
+#endif
+public:
+    /// @brief Walks the join byte by byte. Steps inside a buffer are a pointer bump and moving to the next buffer is O(1)
+    /// @brief Any change to the join invalidates it
+    class Iterator{
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        Iterator() HBUFF_NOEXCEPT{}
+        Iterator(const HBufferVectorJoin* join, size_t segment, size_t offset) HBUFF_NOEXCEPT : m_Join(join), m_Segment(segment), m_Offset(offset){
+            SkipEmpty();
+        }
+
+        const char& operator*() const HBUFF_NOEXCEPT{return m_Join->m_Vectors[m_Segment].GetData()[m_Offset];}
+        Iterator& operator++() HBUFF_NOEXCEPT{
+            m_Offset++;
+            SkipEmpty();
+            return *this;
+        }
+        Iterator operator++(int) HBUFF_NOEXCEPT{
+            Iterator copy = *this;
+            ++(*this);
+            return copy;
+        }
+        /// @brief returns the offset of the current byte in the join
+        size_t GetPosition() const HBUFF_NOEXCEPT{
+            if(m_Segment >= m_Join->m_Vectors.size())return m_Join->GetSize();
+            return m_Join->m_Indices[m_Segment] + m_Offset;
+        }
+        bool operator==(const Iterator& right) const HBUFF_NOEXCEPT{return m_Segment == right.m_Segment && m_Offset == right.m_Offset;}
+        bool operator!=(const Iterator& right) const HBUFF_NOEXCEPT{return !(*this == right);}
+    private:
+        /// @brief moves past the end of the current buffer and any empty ones after it
+        void SkipEmpty() HBUFF_NOEXCEPT{
+            size_t count = m_Join->m_Vectors.size();
+            while(m_Segment < count && m_Offset >= m_Join->m_Vectors[m_Segment].GetSize()){
+                m_Segment++;
+                m_Offset = 0;
+            }
+        }
+    private:
+        const HBufferVectorJoin* m_Join = nullptr;
+        size_t m_Segment = 0;
+        size_t m_Offset = 0;
+    };
+
+    Iterator begin() const HBUFF_NOEXCEPT{return Iterator(this, 0, 0);}
+    Iterator end() const HBUFF_NOEXCEPT{return Iterator(this, m_Vectors.size(), 0);}
+    /// @brief returns an iterator at byte param at found with a binary search or end() if out of range
+    Iterator IteratorAt(size_t at) const HBUFF_NOEXCEPT{
+        size_t segment = FindSegment(at);
+        if(segment >= m_Vectors.size())return end();
+        return Iterator(this, segment, at - m_Indices[segment]);
+    }
+private:
+    /// @brief returns the buffer a forward scan starting at param from should begin with
+    size_t FirstSegment(size_t from)const HBUFF_NOEXCEPT{
+        return from > 0 ? FindSegment(from) : 0;
+    }
+    /// @brief returns if byte param at lives in buffer param segment
+    bool SegmentHolds(size_t segment, size_t at)const HBUFF_NOEXCEPT{
+        return segment < m_Indices.size() && at >= m_Indices[segment] && at < m_Indices[segment] + m_Vectors[segment].GetSize();
+    }
+    /// @brief returns the index of the buffer holding byte param at or m_Vectors.size() if at is out of range. Binary searches the offsets
+    size_t FindSegment(size_t at)const HBUFF_NOEXCEPT{
+        if(m_Indices.empty() || at >= GetSize())return m_Vectors.size();
+        //The last buffer starting at or before param at. Empty buffers share their start with the next one so this skips them
+        return std::upper_bound(m_Indices.begin(), m_Indices.end(), at) - m_Indices.begin() - 1;
+    }
+    /// @brief checks the buffer param cursor is on and the one after it first so walking forward is O(1), then falls back to FindSegment(size_t at)
+    size_t FindSegment(size_t at, Cursor& cursor)const HBUFF_NOEXCEPT{
+        if(SegmentHolds(cursor.m_Segment, at))return cursor.m_Segment;
+        if(SegmentHolds(cursor.m_Segment + 1, at))return ++cursor.m_Segment;
+        size_t segment = FindSegment(at);
+        if(segment < m_Vectors.size())cursor.m_Segment = segment;
+        return segment;
+    }
+    /// @brief returns if the join holds param str starting at param at, comparing one buffer at a time
+    bool MatchesAt(size_t at, const char* str, size_t len)const HBUFF_NOEXCEPT{
+        if(at > GetSize())return false;
+        size_t segment = FindSegment(at);
+        size_t offset = segment < m_Vectors.size() ? at - m_Indices[segment] : 0;
+        while(len > 0){
+            if(segment >= m_Vectors.size())return false;
+            const HBuffer& buffer = m_Vectors[segment];
+            size_t count = std::min(len, buffer.GetSize() - offset);
+            if(memcmp(buffer.GetData() + offset, str, count) != 0)return false;
+            str += count;
+            len -= count;
+            offset = 0;
+            segment++;
+        }
+        return true;
+    }
+public:
+    std::vector<HBuffer, Allocator>& GetVectors()const HBUFF_NOEXCEPT{return (std::vector<HBuffer, Allocator>&)m_Vectors;}
+    std::vector<size_t>& GetIndices()const HBUFF_NOEXCEPT{return (std::vector<size_t>&)m_Indices;}
+private:
+    std::vector<HBuffer, Allocator> m_Vectors;
+    /// @brief a vector where each node contains the sizes of all vectors before it
+    /// Example: vec size 15, vec size 20, vec size 2
+    /// Values: 0, 15, 35
+    std::vector<size_t> m_Indices;
 };
\ No newline at end of file
@@ -0,0 +1,657 @@
+//Benchmarks for the HBuffer hot paths. Linux/POSIX only, see the bench target in the Makefile.
+//Prints one CSV row per measurement to stdout: benchmark,variant,size,value,unit
+//Timings are the best of several batches in nanoseconds per operation. Divide size by ns/op for bytes per nanosecond.
+//usage: Benchmark [--quick] [filter]
+//  --quick  shorter batches and smaller queue runs, for smoke testing
+//  filter   only runs benchmarks whose name contains it
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "HBuffer/HBuffer.hpp"
+#include "HBuffer/HBufferBinaryIO.hpp"
+#include "HBuffer/HBufferJoin.hpp"
+#include "HBuffer/HBufferQueue.hpp"
+#include "HBuffer/HBufferRing.hpp"
+#include "HBuffer/HBufferRope.hpp"
+#include "HBuffer/HBufferSplitter.hpp"
+#include "HBuffer/HBufferTokenizer.hpp"
+#include "HBuffer/HBufferVectorJoin.hpp"
+
+static const char* s_Filter = nullptr;
+static double s_MinSeconds = 0.1;
+static size_t s_QueueItems = 1 << 18;
+static const size_t s_Sizes[] = {8, 64, 4096};
+
+/// @brief stops the compiler from optimizing away param value or the work that produced it
+template<typename T>
+static void Keep(const T& value){
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+static bool IsEnabled(const char* name){
+    return !s_Filter || strstr(name, s_Filter);
+}
+
+static void Report(const char* name, const char* variant, size_t size, double value, const char* unit){
+    printf("%s,%s,%zu,%.3f,%s\n", name, variant, size, value, unit);
+    fflush(stdout);
+}
+
+template<typename Func>
+static double Time(Func& func, size_t iterations){
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++)func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief doubles the batch size until a batch takes a tenth of s_MinSeconds then reports the best of 5 batches
+/// @param opsPerCall how many operations one call of param func does, so the row is per operation
+template<typename Func>
+static void Measure(const char* name, const char* variant, size_t size, Func func, size_t opsPerCall = 1){
+    if(!IsEnabled(name))return;
+    size_t iterations = 1;
+    double seconds = Time(func, iterations);
+    while(seconds < s_MinSeconds / 10 && iterations < (size_t(1) << 32)){
+        iterations *= 2;
+        seconds = Time(func, iterations);
+    }
+    for(int i = 0; i < 4; i++)seconds = std::min(seconds, Time(func, iterations));
+    Report(name, variant, size, seconds * 1e9 / (iterations * opsPerCall), "ns/op");
+}
+
+/// @brief returns param len random lowercase letters. Same seed every run so results are comparable
+static std::string RandomText(size_t len, uint32_t seed = 1){
+    std::mt19937 random(seed);
+    std::string text(len, 'a');
+    for(size_t i = 0; i < len; i++)text[i] = static_cast<char>('a' + random() % 26);
+    return text;
+}
+
+/// @brief runs param func once per SIMD level the cpu supports and puts the level back afterwards
+template<typename Func>
+static void ForEachSimdLevel(Func func){
+    static const char* names[] = {"scalar", "sse2", "avx2", "neon"};
+    int detected = HBufferSimd::GetLevel();
+    for(int level = HBUFF_SIMD_LEVEL_SCALAR; level <= detected; level++){
+        if(level != HBUFF_SIMD_LEVEL_SCALAR && level != detected && detected == HBUFF_SIMD_LEVEL_NEON)continue;
+        HBufferSimd::SetLevel(level);
+        func(names[level]);
+    }
+    HBufferSimd::SetLevel(detected);
+}
+
+#pragma region Core
+static void BenchAppend(){
+    //Builds a 64 KiB buffer out of pieces so the cost of growing is part of every append.
+    //The HBuffer variants carry HBUFF_GROWTH_MODE so rows from builds with different modes can be compared side by side
+    const size_t total = 64 * 1024;
+    const std::string growth = "_growth" + std::to_string(HBUFF_GROWTH_MODE);
+    const std::string append = "Append" + growth;
+    const std::string appendString = "AppendString" + growth;
+    for(size_t piece : {size_t(1), size_t(16), size_t(4096)}){
+        std::string text = RandomText(piece);
+        size_t count = total / piece;
+        Measure("append", append.c_str(), piece, [&]{
+            HBuffer buffer;
+            for(size_t i = 0; i < count; i++)buffer.Append(text.data(), piece);
+            Keep(buffer);
+        }, count);
+        Measure("append", appendString.c_str(), piece, [&]{
+            HBuffer buffer;
+            for(size_t i = 0; i < count; i++)buffer.AppendString(text.data(), piece);
+            Keep(buffer);
+        }, count);
+        Measure("append", "std::string", piece, [&]{
+            std::string string;
+            for(size_t i = 0; i < count; i++)string.append(text.data(), piece);
+            Keep(string);
+        }, count);
+    }
+}
+
+static void BenchCopy(){
+    for(size_t size : s_Sizes){
+        HBuffer source = HBuffer(RandomText(size));
+        HBuffer dest;
+        Measure("copy", "Copy", size, [&]{
+            dest.Copy(source);
+            Keep(dest);
+        });
+        Measure("copy", "CopyString", size, [&]{
+            dest.CopyString(source);
+            Keep(dest);
+        });
+        source.MakeShared();
+        Measure("copy", "shared", size, [&]{
+            HBuffer copy = source;
+            Keep(copy);
+        });
+    }
+}
+
+static void BenchSubString(){
+    for(size_t size : s_Sizes){
+        HBuffer source = HBuffer(RandomText(size * 2));
+        Measure("substring", "SubString", size, [&]{
+            HBuffer sub = source.SubString(size / 2, size);
+            Keep(sub);
+        });
+        Measure("substring", "SubPointer", size, [&]{
+            HBuffer sub = source.SubPointer(size / 2, size);
+            Keep(sub);
+        });
+    }
+}
+
+static void BenchSplit(){
+    //64 KiB of parts that are param size bytes long, separated by ','
+    for(size_t size : s_Sizes){
+        std::string text = RandomText(64 * 1024);
+        size_t count = 0;
+        for(size_t i = size; i < text.size(); i += size + 1, count++)text[i] = ',';
+        HBuffer source = HBuffer(text);
+        Measure("split", "SubPointerSplitByDelimiter", size, [&]{
+            auto parts = source.SubPointerSplitByDelimiter(',');
+            Keep(parts);
+        }, count + 1);
+        Measure("split", "HBufferSplitter", size, [&]{
+            HBufferSplitter splitter(source, ',');
+            HBuffer part;
+            while(splitter.Next(part))Keep(part);
+        }, count + 1);
+    }
+}
+
+static void BenchCompare(){
+    //Equal contents in different memory so every byte has to be compared
+    for(size_t size : s_Sizes){
+        std::string text = RandomText(size);
+        HBuffer left = HBuffer(text);
+        HBuffer right = HBuffer(text);
+        std::string prefix = text.substr(0, size / 2);
+        std::string suffix = text.substr(size - size / 2);
+        Measure("compare", "operator==", size, [&]{
+            bool equal = left == right;
+            Keep(equal);
+        });
+        Measure("compare", "Compare", size, [&]{
+            int order = left.Compare(right);
+            Keep(order);
+        });
+        Measure("compare", "StartsWith", size, [&]{
+            bool starts = left.StartsWith(prefix.data(), prefix.size());
+            Keep(starts);
+        });
+        Measure("compare", "EndsWith", size, [&]{
+            bool ends = left.EndsWith(suffix.data(), suffix.size());
+            Keep(ends);
+        });
+        ForEachSimdLevel([&](const char* level){
+            std::string variant = std::string("EqualsIgnoreCase_") + level;
+            Measure("compare", variant.c_str(), size, [&]{
+                bool equal = left.EqualsIgnoreCase(right);
+                Keep(equal);
+            });
+        });
+    }
+}
+
+static void BenchFind(){
+    //The searched for byte and string are only at the very end so the whole buffer is scanned
+    for(size_t size : {size_t(64), size_t(4096), size_t(64 * 1024)}){
+        std::string text = RandomText(size);
+        text[size - 1] = '#';
+        memcpy(&text[size - 8], "#needle#", 8);
+        HBuffer source = HBuffer(text);
+        Measure("find", "memchr", size, [&]{
+            const void* found = memchr(source.GetData(), '#', source.GetSize());
+            Keep(found);
+        });
+        ForEachSimdLevel([&](const char* level){
+            std::string charVariant = std::string("char_") + level;
+            std::string stringVariant = std::string("string_") + level;
+            Measure("find", charVariant.c_str(), size, [&]{
+                size_t found = source.Find('#');
+                Keep(found);
+            });
+            Measure("find", stringVariant.c_str(), size, [&]{
+                size_t found = source.Find("needle", 6);
+                Keep(found);
+            });
+        });
+    }
+}
+
+static void BenchCase(){
+    for(size_t size : s_Sizes){
+        HBuffer source = HBuffer(RandomText(size));
+        source.ToUpper();
+        HBuffer dest = HBuffer(RandomText(size));
+        ForEachSimdLevel([&](const char* level){
+            Measure("case", level, size, [&]{
+                dest.Copy(source);
+                dest.ToLower();
+                Keep(dest);
+            });
+        });
+    }
+}
+#pragma endregion
+#pragma region Hash
+static void BenchHash(){
+    for(size_t size : s_Sizes){
+        std::string text = RandomText(size);
+        HBuffer source = HBuffer(text);
+        Measure("hash", "std::hash<HBuffer>", size, [&]{
+            size_t hash = std::hash<HBuffer>()(source);
+            Keep(hash);
+        });
+        Measure("hash", "WyHash", size, [&]{
+            uint64_t hash = HBufferHash::WyHash(source.GetData(), source.GetSize());
+            Keep(hash);
+        });
+        Measure("hash", "LegacyHash", size, [&]{
+            uint64_t hash = HBufferHash::LegacyHash(source.GetData(), source.GetSize());
+            Keep(hash);
+        });
+        Measure("hash", "std::hash<string_view>", size, [&]{
+            size_t hash = std::hash<std::string_view>()(std::string_view(text));
+            Keep(hash);
+        });
+    }
+}
+
+/// @brief counts bucket collisions of keys that only differ a little, like ids and sequential integers
+/// @brief Reports observed collisions divided by what a perfectly random hash gives. Around 1 is good
+template<typename Hash>
+static void HashQuality(const char* variant, Hash hash){
+    const size_t bits = 20;
+    const size_t count = size_t(1) << bits;
+    const double expected = count - count * (1 - std::pow(1 - 1.0 / count, static_cast<double>(count)));
+    std::vector<uint8_t> buckets(count);
+    char key[32];
+    auto ratio = [&](auto makeKey){
+        std::fill(buckets.begin(), buckets.end(), 0);
+        size_t collisions = 0;
+        for(size_t i = 0; i < count; i++){
+            size_t len = makeKey(i);
+            uint8_t& bucket = buckets[hash(key, len) & (count - 1)];
+            if(bucket)collisions++;
+            bucket = 1;
+        }
+        return collisions / expected;
+    };
+    Report("hash_quality", (std::string(variant) + "_text").c_str(), count, ratio([&](size_t i){
+        return static_cast<size_t>(snprintf(key, sizeof(key), "key%zu", i));
+    }), "collision_ratio");
+    Report("hash_quality", (std::string(variant) + "_int").c_str(), count, ratio([&](size_t i){
+        uint64_t value = i << 12;
+        memcpy(key, &value, 8);
+        return size_t(8);
+    }), "collision_ratio");
+}
+
+static void BenchHashQuality(){
+    if(!IsEnabled("hash_quality"))return;
+    HashQuality("WyHash", [](const char* key, size_t len){return HBufferHash::WyHash(key, len);});
+    HashQuality("LegacyHash", [](const char* key, size_t len){return HBufferHash::LegacyHash(key, len);});
+}
+#pragma endregion
+#pragma region Numbers
+static void BenchNumbers(){
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> integers(1024);
+    std::vector<double> floats(1024);
+    for(size_t i = 0; i < integers.size(); i++){
+        integers[i] = random() >> (random() % 64);
+        floats[i] = static_cast<double>(random() % 1000000) / 997.0;
+    }
+    std::vector<HBuffer> integerStrings;
+    std::vector<HBuffer> floatStrings;
+    for(size_t i = 0; i < integers.size(); i++){
+        integerStrings.push_back(HBuffer::ToString(integers[i]));
+        floatStrings.push_back(HBuffer::ToString(static_cast<float>(floats[i])));
+    }
+    size_t n = integers.size();
+    Measure("numbers", "ToString_uint64", n, [&]{
+        for(size_t i = 0; i < n; i++)Keep(HBuffer::ToString(integers[i]));
+    }, n);
+    Measure("numbers", "ToString_double", n, [&]{
+        for(size_t i = 0; i < n; i++)Keep(HBuffer::ToString(floats[i]));
+    }, n);
+    Measure("numbers", "snprintf_uint64", n, [&]{
+        char out[32];
+        for(size_t i = 0; i < n; i++){
+            snprintf(out, sizeof(out), "%llu", static_cast<unsigned long long>(integers[i]));
+            Keep(out);
+        }
+    }, n);
+    Measure("numbers", "ToNumber_uint64", n, [&]{
+        uint64_t value = 0;
+        for(size_t i = 0; i < n; i++){
+            integerStrings[i].ToNumber(value);
+            Keep(value);
+        }
+    }, n);
+    Measure("numbers", "ToFloat", n, [&]{
+        float value = 0;
+        for(size_t i = 0; i < n; i++){
+            floatStrings[i].ToFloat(value);
+            Keep(value);
+        }
+    }, n);
+    Measure("numbers", "strtof", n, [&]{
+        for(size_t i = 0; i < n; i++){
+            float value = strtof(floatStrings[i].GetCStr(), nullptr);
+            Keep(value);
+        }
+    }, n);
+}
+
+static void BenchBinary(){
+    const size_t count = 1024;
+    std::vector<uint32_t> values(count);
+    for(size_t i = 0; i < count; i++)values[i] = static_cast<uint32_t>(i * 2654435761u);
+    HBuffer buffer;
+    Measure("binary", "Write_uint32", count, [&]{
+        buffer.SetSize(0);
+        HBufferWriter writer(buffer, HBufferEndian::Big);
+        for(size_t i = 0; i < count; i++)writer.Write(values[i]);
+        Keep(buffer);
+    }, count);
+    Measure("binary", "Read_uint32", count, [&]{
+        HBufferReader reader(buffer, HBufferEndian::Big);
+        uint32_t value;
+        while(reader.Read(value))Keep(value);
+    }, count);
+    Measure("binary", "WriteVarUInt", count, [&]{
+        buffer.SetSize(0);
+        HBufferWriter writer(buffer);
+        for(size_t i = 0; i < count; i++)writer.WriteVarUInt(values[i]);
+        Keep(buffer);
+    }, count);
+    Measure("binary", "ReadVarUInt", count, [&]{
+        HBufferReader reader(buffer);
+        uint64_t value;
+        while(reader.ReadVarUInt(value))Keep(value);
+    }, count);
+}
+#pragma endregion
+#pragma region Joins
+static void BenchJoins(){
+    //4 KiB of text split into segments of param size bytes. Random offsets are the same for every structure
+    const size_t total = 4096;
+    std::string text = RandomText(total);
+    text[total - 1] = '#';
+    std::mt19937 random(1);
+    std::vector<size_t> offsets(1024);
+    for(size_t& offset : offsets)offset = random() % total;
+
+    HBufferJoin join(HBuffer(text.data(), total / 2, false, false), HBuffer(text.data() + total / 2, total - total / 2, false, false));
+    Measure("join", "Get_sequential", total, [&]{
+        for(size_t i = 0; i < total; i++)Keep(join.Get(i));
+    }, total);
+    Measure("join", "Find_char", total, [&]{
+        Keep(join.Find('#'));
+    });
+
+    for(size_t size : {size_t(8), size_t(64), size_t(512)}){
+        HBufferVectorJoin<> vectorJoin;
+        HBufferRope rope;
+        for(size_t at = 0; at < total; at += size){
+            vectorJoin.EmplaceBack(HBuffer(text.data() + at, std::min(size, total - at), false, false));
+            rope.Append(HBuffer(text.data() + at, std::min(size, total - at), false, false));
+        }
+        Measure("vectorjoin", "Get_sequential", size, [&]{
+            HBufferVectorJoin<>::Cursor cursor;
+            for(size_t i = 0; i < total; i++)Keep(vectorJoin.Get(i, cursor));
+        }, total);
+        Measure("vectorjoin", "Get_random", size, [&]{
+            for(size_t offset : offsets)Keep(vectorJoin.Get(offset));
+        }, offsets.size());
+        Measure("vectorjoin", "Iterator", size, [&]{
+            for(char c : vectorJoin)Keep(c);
+        }, total);
+        Measure("vectorjoin", "Find_char", size, [&]{
+            Keep(vectorJoin.Find('#'));
+        });
+        Measure("rope", "Get_sequential", size, [&]{
+            HBufferRope::Cursor cursor;
+            for(size_t i = 0; i < total; i++)Keep(rope.Get(i, cursor));
+        }, total);
+        Measure("rope", "Get_random", size, [&]{
+            for(size_t offset : offsets)Keep(rope.Get(offset));
+        }, offsets.size());
+        Measure("rope", "Find_char", size, [&]{
+            Keep(rope.Find('#'));
+        });
+        Measure("rope", "Hash", size, [&]{
+            Keep(rope.Hash());
+        });
+    }
+}
+
+static void BenchTokenizer(){
+    //"key=value\r\n" lines arriving in reads of param size bytes, like a socket. The baseline appends reads to a std::string and erases consumed lines
+    std::string text;
+    for(size_t i = 0; text.size() < (1 << 20); i++)text += "key" + std::to_string(i) + "=" + RandomText(8 + i % 24, static_cast<uint32_t>(i)) + "\r\n";
+    size_t lines = 0;
+    for(size_t at = 0; (at = text.find("\r\n", at)) != std::string::npos; at += 2)lines++;
+
+    for(size_t size : {size_t(64), size_t(1500), size_t(16384)}){
+        Measure("tokenizer", "HBufferTokenizer", size, [&]{
+            HBufferTokenizer tokenizer("\r\n", 2);
+            HBuffer token;
+            for(size_t at = 0; at < text.size(); at += size){
+                tokenizer.Append(HBuffer(text.data() + at, std::min(size, text.size() - at), false, false));
+                while(tokenizer.Next(token))Keep(token);
+            }
+        }, lines);
+        Measure("tokenizer", "std::string", size, [&]{
+            std::string pending;
+            for(size_t at = 0; at < text.size(); at += size){
+                pending.append(text.data() + at, std::min(size, text.size() - at));
+                size_t start = 0;
+                for(size_t found; (found = pending.find("\r\n", start)) != std::string::npos; start = found + 2)Keep(std::string_view(pending).substr(start, found - start));
+                pending.erase(0, start);
+            }
+        }, lines);
+    }
+}
+#pragma endregion
+#pragma region Memory
+static void BenchAllocators(){
+    HBufferPoolAllocator pool;
+    HBufferArenaAllocator arena;
+    HBufferSizeClassAllocator sizeClass;
+    HBufferRecyclingAllocator recycling;
+    struct Entry{const char* m_Name; HBufferAllocator* m_Allocator;};
+    Entry entries[] = {{"heap", nullptr}, {"pool", &pool}, {"arena", &arena}, {"sizeclass", &sizeClass}, {"recycling", &recycling}};
+    for(size_t size : {size_t(16), size_t(64), size_t(4096)}){
+        std::string text = RandomText(size);
+        for(Entry& entry : entries){
+            HBufferAllocatorScope scope(entry.m_Allocator);
+            Measure("allocator", entry.m_Name, size, [&]{
+                HBuffer buffer;
+                buffer.Append(text.data(), size);
+                Keep(buffer);
+            });
+        }
+    }
+}
+
+static void BenchRing(){
+    for(bool doubleMapped : {false, true}){
+        HBufferRing ring(64 * 1024, doubleMapped);
+        if(doubleMapped && !ring.IsDoubleMapped())continue;
+        const char* variant = doubleMapped ? "double_mapped" : "plain";
+        for(size_t size : s_Sizes){
+            std::string text = RandomText(size);
+            std::vector<char> out(size);
+            //Leaves 3 bytes readable so writes keep crossing the end of the memory
+            ring.Clear();
+            ring.Write(text.data(), 3);
+            Measure("ring", variant, size, [&]{
+                ring.Write(text.data(), size);
+                ring.Read(out.data(), size);
+                Keep(out);
+            });
+        }
+    }
+}
+
+static void BenchScatter(){
+    if(!IsEnabled("scatter"))return;
+    int fd = open("/dev/null", O_WRONLY);
+    if(fd < 0)return;
+    const size_t total = 64 * 1024;
+    std::string text = RandomText(total);
+    for(size_t size : {size_t(64), size_t(4096)}){
+        HBufferVectorJoin<> join;
+        for(size_t at = 0; at < total; at += size)join.EmplaceBack(HBuffer(text.data() + at, size, false, false));
+        HBuffer flat;
+        Measure("scatter", "writev", size, [&]{
+            iovec vecs[HBufferScatter::s_MaxIOVecs];
+            for(size_t at = 0; at < total;){
+                iovec* cursor = vecs;
+                size_t count = join.GetIOVecs(vecs, HBufferScatter::s_MaxIOVecs, at);
+                ssize_t written = HBufferScatter::Write(fd, cursor, count);
+                if(written <= 0)break;
+                at += written;
+            }
+        });
+        Measure("scatter", "flatten_write", size, [&]{
+            flat.SetSize(0);
+            for(size_t i = 0; i < total; i += size)flat.Append(text.data() + i, size);
+            Keep(write(fd, flat.GetData(), flat.GetSize()));
+        });
+    }
+    close(fd);
+}
+
+static void BenchMapFile(){
+    if(!IsEnabled("mapfile"))return;
+    const size_t size = 16 * 1024 * 1024;
+    char path[] = "/tmp/HBufferBenchXXXXXX";
+    int fd = mkstemp(path);
+    if(fd < 0)return;
+    std::string text = RandomText(size);
+    bool wrote = write(fd, text.data(), size) == static_cast<ssize_t>(size);
+    close(fd);
+    if(wrote){
+        Measure("mapfile", "MapFile_hash", size, [&]{
+            HBuffer mapped = HBuffer::MapFile(path, HBufferMapMode::ReadOnly, HBUFF_MAP_ADVICE_SEQUENTIAL);
+            Keep(std::hash<HBuffer>()(mapped));
+        });
+        HBuffer buffer;
+        buffer.Reserve(size);
+        Measure("mapfile", "read_hash", size, [&]{
+            int file = open(path, O_RDONLY);
+            ssize_t read = ::read(file, buffer.GetData(), size);
+            close(file);
+            Keep(HBufferHash::Hash(buffer.GetData(), read > 0 ? read : 0));
+        });
+    }
+    unlink(path);
+}
+#pragma endregion
+#pragma region Queues
+static uint64_t NowNanoseconds(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief reports the mean and 99th percentile of param latencies
+static void ReportLatency(const char* name, const char* variant, size_t size, std::vector<uint64_t>& latencies){
+    if(latencies.empty())return;
+    double sum = 0;
+    for(uint64_t latency : latencies)sum += latency;
+    size_t p99 = latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), latencies.begin() + p99, latencies.end());
+    Report(name, (std::string(variant) + "_latency_mean").c_str(), size, sum / latencies.size(), "ns");
+    Report(name, (std::string(variant) + "_latency_p99").c_str(), size, static_cast<double>(latencies[p99]), "ns");
+}
+
+/// @brief every item is an 8 byte view of the time it was pushed so the consumer can work out the latency without allocating
+template<typename Queue>
+static void RunQueue(const char* name, size_t producers){
+    size_t perProducer = s_QueueItems / producers;
+    Queue queue(1024);
+    std::vector<uint64_t> stamps(perProducer * producers);
+    std::vector<uint64_t> latencies;
+    latencies.reserve(stamps.size());
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    for(size_t p = 0; p < producers; p++){
+        threads.emplace_back([&, p]{
+            while(!start.load(std::memory_order_acquire))std::this_thread::yield();
+            for(size_t i = 0; i < perProducer; i++){
+                uint64_t* stamp = &stamps[p * perProducer + i];
+                *stamp = NowNanoseconds();
+                HBuffer item(reinterpret_cast<const char*>(stamp), sizeof(uint64_t), false, false);
+                while(!queue.TryPush(std::move(item)))std::this_thread::yield();
+            }
+        });
+    }
+    uint64_t begin = NowNanoseconds();
+    start.store(true, std::memory_order_release);
+    HBuffer item;
+    for(size_t received = 0; received < stamps.size();){
+        if(!queue.TryPop(item)){
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t stamp;
+        memcpy(&stamp, item.GetData(), sizeof(stamp));
+        latencies.push_back(NowNanoseconds() - stamp);
+        received++;
+    }
+    uint64_t elapsed = NowNanoseconds() - begin;
+    for(std::thread& thread : threads)thread.join();
+    Report("queue", (std::string(name) + "_throughput").c_str(), producers, static_cast<double>(elapsed) / stamps.size(), "ns/op");
+    ReportLatency("queue", name, producers, latencies);
+}
+
+static void BenchQueues(){
+    if(!IsEnabled("queue"))return;
+    RunQueue<HBufferSpscQueue>("spsc", 1);
+    for(size_t producers : {1, 2, 4, 8, 16})RunQueue<HBufferMpscQueue>("mpsc", producers);
+}
+#pragma endregion
+
+int main(int argc, char** argv){
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "--quick") == 0){
+            s_MinSeconds = 0.01;
+            s_QueueItems = 1 << 14;
+        }
+        else s_Filter = argv[i];
+    }
+    fprintf(stderr, "simd level %d, small buffer size %d, growth mode %d\n", HBufferSimd::GetLevel(), HBUFF_SMALL_BUFFER_SIZE, HBUFF_GROWTH_MODE);
+    printf("benchmark,variant,size,value,unit\n");
+    BenchAppend();
+    BenchCopy();
+    BenchSubString();
+    BenchSplit();
+    BenchCompare();
+    BenchFind();
+    BenchCase();
+    BenchHash();
+    BenchHashQuality();
+    BenchNumbers();
+    BenchBinary();
+    BenchJoins();
+    BenchTokenizer();
+    BenchAllocators();
+    BenchRing();
+    BenchScatter();
+    BenchMapFile();
+    BenchQueues();
+}
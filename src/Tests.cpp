@@ -0,0 +1,2004 @@
+//Tests for HBuffer behaviour that is easy to break without noticing: allocation counts and copy on write. Linux/POSIX only, see the test target in the Makefile.
+//Prints every failed check with its line and exits with 1 if any failed.
+//usage: Tests [filter]
+//  filter   only runs tests whose name contains it
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#include "HBuffer/HBuffer.hpp"
+#include "HBuffer/HBufferBinaryIO.hpp"
+#include "HBuffer/HBufferJoin.hpp"
+#include "HBuffer/HBufferQueue.hpp"
+#include "HBuffer/HBufferRing.hpp"
+#include "HBuffer/HBufferRope.hpp"
+#include "HBuffer/HBufferSplitter.hpp"
+#include "HBuffer/HBufferTokenizer.hpp"
+#include "HBuffer/HBufferVectorJoin.hpp"
+
+static const char* s_Filter = nullptr;
+static int s_Checks = 0;
+static int s_Failures = 0;
+static std::atomic<size_t> s_Allocations{0};
+
+#pragma region Counting allocator
+//Every heap allocation in the process is counted so a test can assert that an operation did not allocate
+void* operator new(size_t size){
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = malloc(size > 0 ? size : 1);
+    if(!memory)throw std::bad_alloc();
+    return memory;
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void operator delete(void* memory) noexcept{
+    free(memory);
+}
+void operator delete[](void* memory) noexcept{
+    free(memory);
+}
+void operator delete(void* memory, size_t) noexcept{
+    free(memory);
+}
+void operator delete[](void* memory, size_t) noexcept{
+    free(memory);
+}
+#pragma endregion
+
+#define TEST_CHECK(condition) Check((condition), #condition, __LINE__)
+
+static void Check(bool passed, const char* condition, int line){
+    s_Checks++;
+    if(passed)return;
+    s_Failures++;
+    printf("  line %d: %s\n", line, condition);
+}
+
+/// @brief returns how many heap allocations param func made
+template<typename Func>
+static size_t CountAllocations(Func func){
+    size_t before = s_Allocations.load(std::memory_order_relaxed);
+    func();
+    return s_Allocations.load(std::memory_order_relaxed) - before;
+}
+
+static bool Holds(const HBuffer& buffer, const char* str){
+    return buffer.Equals(str, strlen(str));
+}
+
+template<typename Func>
+static void Run(const char* name, Func func){
+    if(s_Filter && !strstr(name, s_Filter))return;
+    int failures = s_Failures;
+    func();
+    printf("%s %s\n", s_Failures == failures ? "passed" : "FAILED", name);
+}
+
+#pragma region Small buffer
+#if HBUFF_SMALL_BUFFER_SIZE > 0
+static void TestSmallStringsStayInline(){
+    std::string text("short string");
+    size_t allocations = CountAllocations([&]{
+        HBuffer number = HBuffer::ToString(uint64_t(18446744073709551615ull));
+        HBuffer negative = HBuffer::ToString(int32_t(-2147483647));
+        TEST_CHECK(Holds(number, "18446744073709551615"));
+        TEST_CHECK(Holds(negative, "-2147483647"));
+        TEST_CHECK(number.IsInline() && negative.IsInline());
+
+        HBuffer copy = number.CreateCopy();
+        HBuffer fromString = HBuffer::CreateCopy(text);
+        TEST_CHECK(Holds(copy, "18446744073709551615") && copy.IsInline());
+        TEST_CHECK(Holds(fromString, "short string") && fromString.IsInline());
+
+        HBuffer moved(std::move(copy));
+        TEST_CHECK(Holds(moved, "18446744073709551615") && moved.IsInline());
+        HBuffer assigned;
+        assigned = std::move(moved);
+        TEST_CHECK(Holds(assigned, "18446744073709551615") && assigned.IsInline());
+
+        assigned.Swap(fromString);
+        TEST_CHECK(Holds(assigned, "short string") && assigned.IsInline());
+        TEST_CHECK(Holds(fromString, "18446744073709551615") && fromString.IsInline());
+        HBuffer literal("a literal that is a view");
+        literal.Swap(assigned);
+        TEST_CHECK(Holds(literal, "short string") && literal.IsInline());
+        TEST_CHECK(Holds(assigned, "a literal that is a view") && !assigned.IsInline());
+
+        HBuffer sub = literal.SubString(6, 6);
+        TEST_CHECK(Holds(sub, "string") && sub.IsInline());
+        HBuffer longSub = assigned.SubString(0, 23);
+        TEST_CHECK(longSub.GetSize() == 23 && longSub.IsInline());
+    });
+    TEST_CHECK(allocations == 0);
+    //Anything past the inline storage still goes to the heap
+    size_t large = CountAllocations([]{
+        HBuffer buffer;
+        buffer.Append("more than twenty four chars...", 30);
+        TEST_CHECK(!buffer.IsInline());
+    });
+    TEST_CHECK(large == 1);
+}
+#endif
+#pragma endregion
+
+#pragma region Copy on write
+static void TestSharedReadsDoNotCopy(){
+    HBuffer shared = HBuffer::CreateShared("hello shared world", 18);
+    size_t allocations = CountAllocations([&]{
+        HBuffer copy(shared);
+        HBuffer assigned;
+        assigned = shared;
+        HBuffer sub = shared.SubPointer(6, 6);
+        TEST_CHECK(copy.GetData() == shared.GetData());
+        TEST_CHECK(assigned.GetData() == shared.GetData());
+        TEST_CHECK(Holds(sub, "shared"));
+        TEST_CHECK(shared.GetReferenceCount() == 4);
+        TEST_CHECK(shared.Find('w') == 13);
+        TEST_CHECK(shared.Find("world") == 13);
+        TEST_CHECK(sub.Find("red") == 3);
+        TEST_CHECK(shared.Compare(copy) == 0);
+        TEST_CHECK(shared == copy);
+        TEST_CHECK(shared.StartsWith("hello"));
+        TEST_CHECK(sub.Compare("shared") == 0);
+        const HBuffer& constant = copy;
+        TEST_CHECK(constant[1] == 'e');
+        TEST_CHECK(copy.GetData() == shared.GetData());
+    });
+    TEST_CHECK(allocations == 0);
+    TEST_CHECK(shared.GetReferenceCount() == 1);
+}
+
+static void TestIndexingDoesNotCopy(){
+    HBuffer shared = HBuffer::CreateShared("GET / HTTP/1.1", 14);
+    size_t allocations = CountAllocations([&]{
+        //operator[] never copies, not even on a literal view or a non const alias of shared data
+        HBuffer literal("GET / HTTP/1.1");
+        TEST_CHECK(literal[0] == 'G' && literal[13] == '1');
+        HBuffer copy(shared);
+        TEST_CHECK(copy[4] == '/');
+        TEST_CHECK(copy.GetData() == shared.GetData());
+        size_t parts = 0;
+        for(HBuffer& part : HBufferSplitter(shared, ' ')){
+            TEST_CHECK(part[0] == "G/H"[parts]);
+            parts++;
+        }
+        TEST_CHECK(parts == 3);
+    });
+    TEST_CHECK(allocations == 0);
+    //Writing goes through GetWritable which copies data we may not modify first
+    HBuffer literal("GET");
+    const char* data = literal.GetData();
+    literal.GetWritable(0) = 'S';
+    TEST_CHECK(Holds(literal, "SET"));
+    TEST_CHECK(literal.GetData() != data && strcmp(data, "GET") == 0);
+    char* owned = literal.GetData();
+    literal.GetWritable(1) = 'I';
+    TEST_CHECK(Holds(literal, "SIT") && literal.GetData() == owned);
+}
+
+/// @brief shares param text between three buffers, runs param mutate on the middle one and checks only it changed
+template<typename Func>
+static void CheckDetach(const char* expected, Func mutate){
+    HBuffer first = HBuffer::CreateShared("hello", 5);
+    HBuffer second(first);
+    HBuffer third = first.SubPointer(0, 5);
+    mutate(second);
+    TEST_CHECK(Holds(second, expected));
+    TEST_CHECK(second.GetData() != first.GetData());
+    TEST_CHECK(Holds(first, "hello"));
+    TEST_CHECK(Holds(third, "hello"));
+    TEST_CHECK(first.GetReferenceCount() == 2);
+}
+
+static void TestMutationDetachesOneAlias(){
+    CheckDetach("olleh", [](HBuffer& buffer){buffer.Reverse();});
+    CheckDetach("Xello", [](HBuffer& buffer){buffer.GetWritable(0) = 'X';});
+    CheckDetach("zzz", [](HBuffer& buffer){buffer.Memset('z', 3);});
+    CheckDetach("abllo", [](HBuffer& buffer){buffer.Memcpy("ab", 2);});
+    CheckDetach("HELLO", [](HBuffer& buffer){buffer.ToUpper();});
+    CheckDetach("hello!", [](HBuffer& buffer){buffer.Append("!", 1);});
+    CheckDetach("hel", [](HBuffer& buffer){buffer.Detach(); buffer.SetSize(3);});
+}
+
+static void TestLastReferenceWritesInPlace(){
+    HBuffer shared = HBuffer::CreateShared("hello", 5);
+    {
+        HBuffer copy(shared);
+    }
+    char* data = shared.GetData();
+    size_t allocations = CountAllocations([&]{
+        shared.GetWritable(0) = 'j';
+        shared.Reverse();
+    });
+#if HBUFF_COW_UNIQUE_CHECK
+    TEST_CHECK(allocations == 0);
+    TEST_CHECK(shared.GetData() == data);
+    TEST_CHECK(shared.IsShared());
+#else
+    (void)data;
+    (void)allocations;
+#endif
+    TEST_CHECK(Holds(shared, "ollej"));
+}
+#pragma endregion
+
+#pragma region Hash
+/// @brief a HashFrom source over two separate pieces of memory, like a buffer that was received in two reads
+struct SplitSource{
+    const char* m_First;
+    size_t m_FirstSize;
+    const char* m_Second;
+
+    void Read(size_t at, void* out, size_t count) const{
+        char* to = static_cast<char*>(out);
+        for(size_t i = 0; i < count; i++, at++)to[i] = at < m_FirstSize ? m_First[at] : m_Second[at - m_FirstSize];
+    }
+};
+
+static void TestHashCaseFolding(){
+    //Every length up to 64 goes through the 1-3, 4-16, 17-48 and 48 byte block paths
+    const char* mixed = "AbC-dEf_GhI@jKl[MnO`pQr{StU~vWx0YzA1bCd2EfG3hIj4KlM5nOp6QrS7tUv8";
+    const char* lower = "abc-def_ghi@jkl[mno`pqr{stu~vwx0yza1bcd2efg3hij4klm5nop6qrs7tuv8";
+    for(size_t len = 0; len <= 64; len++){
+        uint64_t folded = HBufferHash::HashLowercase(lower, len);
+        TEST_CHECK(HBufferHash::HashLowercase(mixed, len) == folded);
+        TEST_CHECK(HBufferHash::Hash(lower, len) == folded);
+        TEST_CHECK(HBufferHash::WyHashLowercase(mixed, len) == HBufferHash::WyHash(lower, len));
+        TEST_CHECK(HBufferHash::LegacyHashLowercase(mixed, len) == HBufferHash::LegacyHash(lower, len));
+        if(len > 0 && strncmp(mixed, lower, len) != 0)TEST_CHECK(HBufferHash::Hash(mixed, len) != folded);
+    }
+    //Only A-Z fold. The bytes next to them and bytes with the high bit set stay as they are
+    TEST_CHECK(HBufferHash::FoldCase(0x5B5A41403F) == 0x5B7A61403F);
+    TEST_CHECK(HBufferHash::FoldCase(0xC1DAE1FA80FF) == 0xC1DAE1FA80FF);
+    const char* neighbours[] = {"@[\\]^_", "`{|}~\x7f", "\xc1\xc2\xc3\xc4\xc5\xc6"};
+    const char* shifted[] = {"`{|}~\x7f", "@[\\]^_", "\xe1\xe2\xe3\xe4\xe5\xe6"};
+    for(size_t i = 0; i < 3; i++)TEST_CHECK(HBufferHash::HashLowercase(neighbours[i], 6) != HBufferHash::HashLowercase(shifted[i], 6));
+}
+
+static void TestHashFromSplitSources(){
+    std::string text;
+    for(size_t i = 0; text.size() < 130; i++)text += "Key" + std::to_string(i * 7919) + "|";
+    for(size_t len = 0; len <= 130; len++){
+        uint64_t flat = HBufferHash::Hash(text.data(), len, 7);
+        uint64_t flatLower = HBufferHash::HashLowercase(text.data(), len, 7);
+        for(size_t split = 0; split <= len; split++){
+            //The second piece lives in its own memory so reads really cross from one to the other
+            std::string second = text.substr(split, len - split);
+            SplitSource source{text.data(), split, second.data()};
+            TEST_CHECK(HBufferHash::HashFrom(source, len, 7) == flat);
+            TEST_CHECK(HBufferHash::HashLowercaseFrom(source, len, 7) == flatLower);
+        }
+    }
+    HBufferRope rope;
+    rope.Append(HBuffer::CreateShared(text.data(), 50));
+    rope.Append(HBuffer::CreateShared(text.data() + 50, 3));
+    rope.Append(HBuffer::CreateShared(text.data() + 53, 77));
+    HBuffer flat(text.data(), 130, false, false);
+    TEST_CHECK(rope.Hash() == std::hash<HBuffer>()(flat));
+    TEST_CHECK(std::hash<HBuffer>()(flat) == HBufferHash::Hash(text.data(), 130));
+}
+
+static void TestHashSequentialKeysDoNotCollide(){
+    //Numbers as text share long prefixes and differ in one or two bytes, which the old multiplier hash spread badly
+    const size_t keys = 200000;
+    std::vector<uint64_t> hashes;
+    std::vector<uint64_t> lowercase;
+    hashes.reserve(keys * 2);
+    lowercase.reserve(keys);
+    for(size_t i = 0; i < keys; i++){
+        std::string key = std::to_string(i);
+        std::string prefixed = "session-" + std::to_string(1000000000ull + i);
+        hashes.push_back(HBufferHash::Hash(key.data(), key.size()));
+        hashes.push_back(HBufferHash::Hash(prefixed.data(), prefixed.size()));
+        lowercase.push_back(HBufferHash::HashLowercase(prefixed.data(), prefixed.size()));
+    }
+    std::sort(hashes.begin(), hashes.end());
+    std::sort(lowercase.begin(), lowercase.end());
+    TEST_CHECK(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+    TEST_CHECK(std::adjacent_find(lowercase.begin(), lowercase.end()) == lowercase.end());
+    //Buckets come from the low bits, so those alone should not pile up either
+    std::vector<uint32_t> buckets(1 << 16);
+    for(uint64_t hash : hashes)buckets[hash & 0xFFFF]++;
+    uint32_t fullest = *std::max_element(buckets.begin(), buckets.end());
+    TEST_CHECK(fullest < 30);
+}
+#pragma endregion
+
+#pragma region Search
+/// @brief fills param len bytes from a small alphabet so needles match often and partially. 0xE9 checks the kernels compare bytes unsigned
+static std::string RandomText(size_t len, unsigned& seed){
+    static const char alphabet[] = {'a', 'b', '\n', '\xE9'};
+    std::string text(len, '\0');
+    for(char& c : text){
+        seed = seed * 1103515245 + 12345;
+        c = alphabet[(seed >> 16) & 3];
+    }
+    return text;
+}
+
+/// @brief compares every search of param buffer against std::string on the same bytes
+static bool SearchesMatch(const HBuffer& buffer, const std::string& text){
+    static const char bytes[] = {'a', '\n', '\xE9', 'z'};
+    size_t len = text.size();
+    std::string needles[] = {"", "ab", "a\nb", "\xE9" "a", "aab\xE9", "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", text.substr(len / 2, 5), text.substr(len > 17 ? len - 17 : 0)};
+    bool ok = true;
+    for(char c : bytes){
+        for(size_t from : {size_t(0), len / 3, len})ok &= buffer.Find(c, from) == text.find(c, from);
+        ok &= buffer.FindLast(c) == text.rfind(c);
+        ok &= buffer.FindLast(c, len / 2) == (len / 2 > 0 ? text.rfind(c, len / 2 - 1) : HBUFF_NPOS);
+        ok &= buffer.Contains(c) == (text.find(c) != std::string::npos);
+    }
+    for(const std::string& needle : needles){
+        for(size_t from : {size_t(0), len / 3, len})ok &= buffer.Find(needle.data(), needle.size(), from) == text.find(needle, from);
+        ok &= buffer.FindLast(needle.data(), needle.size()) == text.rfind(needle);
+        ok &= buffer.Contains(needle.data(), needle.size()) == (text.find(needle) != std::string::npos);
+    }
+    ok &= buffer.FindFirstOf("\n\xE9", 2) == text.find_first_of("\n\xE9");
+    ok &= buffer.FindFirstOf("zb", 2, len / 3) == text.find_first_of("zb", len / 3);
+    ok &= buffer.FindFirstOf("z", 1) == HBUFF_NPOS;
+    ok &= buffer.Find('a', len + 5) == HBUFF_NPOS && buffer.Find("ab", 2, len + 1) == HBUFF_NPOS;
+    return ok;
+}
+
+static void TestSearchKernels(){
+    //Every kernel must give the scalar answers. Lengths up to 3 avx2 blocks and every start alignment hit the vector loops and the tails
+    int original = HBufferSimd::GetLevel();
+    unsigned seed = 1;
+    for(int level = HBUFF_SIMD_LEVEL_SCALAR; level <= HBUFF_SIMD_LEVEL_NEON; level++){
+        HBufferSimd::SetLevel(level);
+        //Levels above what the cpu supports clamp down to one already tested
+        if(HBufferSimd::GetLevel() != level)continue;
+        bool ok = true;
+        for(size_t len = 0; len <= 96; len++){
+            std::string storage = RandomText(len + 32, seed);
+            for(size_t offset = 0; offset < 32; offset++){
+                ok &= SearchesMatch(HBuffer(storage.data() + offset, len, false, false), storage.substr(offset, len));
+            }
+        }
+        if(!ok)printf("  search level %d\n", level);
+        TEST_CHECK(ok);
+    }
+    HBufferSimd::SetLevel(original);
+    TEST_CHECK(HBufferSimd::GetLevel() == original);
+}
+
+static void TestJoinSearch(){
+    //Split the same text at every point so each match straddles a boundary at least once
+    unsigned seed = 7;
+    std::string text = RandomText(40, seed) + "needle" + RandomText(20, seed);
+    const char* data = text.data();
+    size_t len = text.size();
+    const char* needles[] = {"needle", "ab", "a\nb", "\xE9" "a", "aab\xE9", "zz"};
+    bool joinOk = true;
+    bool vectorOk = true;
+    for(size_t split = 0; split <= len; split++){
+        HBufferJoin join(HBuffer(data, split, false, false), HBuffer(data + split, len - split, false, false));
+        //A second split and an empty buffer in the vector join so matches can span three buffers
+        size_t second = split + (len - split) / 2;
+        HBufferVectorJoin<> vector;
+        vector.EmplaceBack(HBuffer(data, split, false, false));
+        vector.EmplaceBack(HBuffer(data + split, 0, false, false));
+        vector.EmplaceBack(HBuffer(data + split, second - split, false, false));
+        vector.EmplaceBack(HBuffer(data + second, len - second, false, false));
+        for(char c : {'a', '\n', '\xE9', 'z'}){
+            joinOk &= join.FindLast(c) == text.rfind(c);
+            vectorOk &= vector.FindLast(c) == text.rfind(c);
+        }
+        for(size_t from = 0; from <= len; from += 3){
+            for(char c : {'a', '\n', '\xE9', 'z'}){
+                joinOk &= join.Find(c, from) == text.find(c, from);
+                vectorOk &= vector.Find(c, from) == text.find(c, from);
+            }
+            for(const char* needle : needles){
+                size_t needleLen = strlen(needle);
+                joinOk &= join.Find(needle, needleLen, from) == text.find(needle, from, needleLen);
+                vectorOk &= vector.Find(needle, needleLen, from) == text.find(needle, from, needleLen);
+            }
+            //The bytes right around the split only match across it
+            if(split >= 2 && split + 2 <= len){
+                std::string straddling = text.substr(split - 2, 4);
+                joinOk &= join.Find(straddling.data(), 4, from) == text.find(straddling, from);
+                vectorOk &= vector.Find(straddling.data(), 4, from) == text.find(straddling, from);
+            }
+            joinOk &= join.FindFirstOf("\n\xE9", 2, from) == text.find_first_of("\n\xE9", from);
+            vectorOk &= vector.FindFirstOf("\n\xE9", 2, from) == text.find_first_of("\n\xE9", from);
+        }
+        joinOk &= join.Find('a', len + 1) == HBUFF_NPOS && join.Find("ab", 2, len + 1) == HBUFF_NPOS;
+        vectorOk &= vector.Find('a', len + 1) == HBUFF_NPOS && vector.Find("ab", 2, len + 1) == HBUFF_NPOS;
+    }
+    TEST_CHECK(joinOk);
+    TEST_CHECK(vectorOk);
+}
+#pragma endregion
+
+#pragma region Stats
+static void TestAllocationStats(){
+    if(!HBufferStats::s_Enabled)return;
+    HBufferStatsSnapshot before = HBufferStats::GetThreadSnapshot();
+    {
+        HBuffer buffer;
+        buffer.Reserve(100);
+        buffer.Reserve(300);
+        HBufferStatsSnapshot grown = HBufferStats::GetThreadSnapshot();
+        TEST_CHECK(grown.m_Allocations - before.m_Allocations == 2);
+        TEST_CHECK(grown.m_Frees - before.m_Frees == 1);
+        TEST_CHECK(grown.m_Reallocations - before.m_Reallocations == 1);
+        TEST_CHECK(grown.m_BytesLive - before.m_BytesLive == 300);
+        //Both allocations were live while the data moved over
+        TEST_CHECK(grown.m_PeakBytesLive >= before.m_BytesLive + 400);
+        HBuffer shared = HBuffer::CreateShared("shared", 6);
+        HBuffer copy(shared);
+        TEST_CHECK(HBufferStats::GetThreadSnapshot().m_Allocations - before.m_Allocations == 3);
+    }
+    HBufferStatsSnapshot after = HBufferStats::GetThreadSnapshot();
+    TEST_CHECK(after.m_Allocations - before.m_Allocations == 3);
+    TEST_CHECK(after.m_Frees - before.m_Frees == 3);
+    TEST_CHECK(after.m_BytesLive == before.m_BytesLive);
+    //Nothing was written into either allocation so all of it was slack
+    size_t small = HBufferStatsSnapshot::GetSlackBucket(100);
+    size_t large = HBufferStatsSnapshot::GetSlackBucket(300);
+    TEST_CHECK(small == 7 && large == 9);
+    TEST_CHECK(after.m_SlackHistogram[small] - before.m_SlackHistogram[small] == 1);
+    TEST_CHECK(after.m_SlackHistogram[large] - before.m_SlackHistogram[large] == 1);
+    //What a thread recorded is still counted after it exits
+    HBufferStatsSnapshot total = HBufferStats::GetSnapshot();
+    std::thread([]{
+        HBuffer buffer;
+        buffer.Reserve(1000);
+    }).join();
+    HBufferStatsSnapshot joined = HBufferStats::GetSnapshot();
+    TEST_CHECK(joined.m_Allocations - total.m_Allocations == 1);
+    TEST_CHECK(joined.m_Frees - total.m_Frees == 1);
+    TEST_CHECK(joined.m_BytesLive == total.m_BytesLive);
+}
+#pragma endregion
+
+#pragma region Trace
+/// @brief returns the little endian number at param at and moves param at past it
+template<typename T>
+static T Take(const char*& at){
+    T value = HBufferBinary::Load<T>(at, HBufferEndian::Little);
+    at += sizeof(T);
+    return value;
+}
+
+static void TestTraceRoundTrip(){
+    if(!HBufferTrace::s_Enabled)return;
+    std::vector<HBufferTraceRecord> records;
+    HBufferTrace::Drain(records);
+    records.clear();
+    HBufferTrace::Record(HBufferTraceEvent::Allocate, 64);
+    uint16_t tag;
+    {
+        HBUFF_TRACE_SCOPE("resize");
+        tag = HBufferTrace::CurrentTag();
+        HBufferTrace::Record(HBufferTraceEvent::Reallocate, 128, 64);
+    }
+    HBufferTrace::Record(HBufferTraceEvent::Free, 128);
+    TEST_CHECK(HBufferTrace::Drain(records) == 3);
+    TEST_CHECK(records.size() == 3);
+    if(records.size() != 3)return;
+    TEST_CHECK(tag != 0 && HBufferTrace::CurrentTag() == 0);
+    TEST_CHECK(HBufferTrace::GetTag(0) == "untagged");
+    TEST_CHECK(HBufferTrace::GetTag(tag).compare(0, 7, "resize@") == 0);
+    TEST_CHECK(HBufferTrace::GetTag(tag).find("Tests.cpp:") != std::string::npos);
+    TEST_CHECK(records[0].m_Event == HBufferTraceEvent::Allocate && records[0].m_Size == 64 && records[0].m_Tag == 0);
+    TEST_CHECK(records[1].m_Event == HBufferTraceEvent::Reallocate && records[1].m_Size == 128 && records[1].m_OldSize == 64 && records[1].m_Tag == tag);
+    TEST_CHECK(records[2].m_Event == HBufferTraceEvent::Free && records[2].m_Tag == 0);
+    TEST_CHECK(records[0].m_Thread == records[2].m_Thread);
+    TEST_CHECK(records[0].m_Timestamp <= records[1].m_Timestamp && records[1].m_Timestamp <= records[2].m_Timestamp);
+
+    //The file holds the header, every tag and the records in order
+    char path[] = "/tmp/HBufferTraceXXXXXX";
+    int fd = mkstemp(path);
+    TEST_CHECK(fd >= 0);
+    if(fd < 0)return;
+    close(fd);
+    uint64_t dropped = HBufferTrace::GetDropped();
+    TEST_CHECK(HBufferTrace::WriteFile(path, records));
+    HBuffer file = HBuffer::MapFile(path);
+    unlink(path);
+    TEST_CHECK(file.GetSize() > sizeof(HBufferTrace::s_FileMagic));
+    if(file.GetSize() <= sizeof(HBufferTrace::s_FileMagic))return;
+    const char* at = file.GetData();
+    const char* end = at + file.GetSize();
+    TEST_CHECK(memcmp(at, HBufferTrace::s_FileMagic, sizeof(HBufferTrace::s_FileMagic)) == 0);
+    at += sizeof(HBufferTrace::s_FileMagic);
+    uint32_t tags = Take<uint32_t>(at);
+    TEST_CHECK(tags > tag);
+    TEST_CHECK(Take<uint64_t>(at) == 3);
+    TEST_CHECK(Take<uint64_t>(at) == dropped);
+    uint64_t startTicks = Take<uint64_t>(at);
+    Take<uint64_t>(at);
+    uint64_t endTicks = Take<uint64_t>(at);
+    Take<uint64_t>(at);
+    TEST_CHECK(startTicks <= records[0].m_Timestamp && records[2].m_Timestamp <= endTicks);
+    for(uint32_t i = 0; i < tags; i++){
+        uint16_t len = Take<uint16_t>(at);
+        TEST_CHECK(std::string(at, len) == HBufferTrace::GetTag(static_cast<uint16_t>(i)));
+        at += len;
+    }
+    TEST_CHECK(static_cast<size_t>(end - at) == 3 * HBufferTrace::s_RecordFileSize);
+    for(const HBufferTraceRecord& record : records){
+        if(end - at < static_cast<ptrdiff_t>(HBufferTrace::s_RecordFileSize))break;
+        TEST_CHECK(Take<uint64_t>(at) == record.m_Timestamp);
+        TEST_CHECK(Take<uint64_t>(at) == record.m_Size);
+        TEST_CHECK(Take<uint64_t>(at) == record.m_OldSize);
+        TEST_CHECK(Take<uint32_t>(at) == record.m_Thread);
+        TEST_CHECK(Take<uint16_t>(at) == record.m_Tag);
+        TEST_CHECK(static_cast<HBufferTraceEvent>(*at++) == record.m_Event);
+    }
+}
+
+static void TestTraceDropsWhenFull(){
+    if(!HBufferTrace::s_Enabled)return;
+    std::vector<HBufferTraceRecord> records;
+    HBufferTrace::Drain(records);
+    uint64_t dropped = HBufferTrace::GetDropped();
+    //A full ring drops and counts what does not fit instead of blocking
+    for(size_t i = 0; i < HBUFF_TRACE_RING_SIZE + 10; i++)HBufferTrace::Record(HBufferTraceEvent::Copy, i);
+    records.clear();
+    TEST_CHECK(HBufferTrace::Drain(records) == HBUFF_TRACE_RING_SIZE);
+    TEST_CHECK(HBufferTrace::GetDropped() - dropped == 10);
+    TEST_CHECK(!records.empty() && records.back().m_Size == HBUFF_TRACE_RING_SIZE - 1);
+    //Draining made room again
+    HBufferTrace::Record(HBufferTraceEvent::Copy, 1);
+    records.clear();
+    TEST_CHECK(HBufferTrace::Drain(records) == 1);
+    TEST_CHECK(HBufferTrace::GetDropped() - dropped == 10);
+    //A thread that exits keeps its events until they are drained
+    std::thread([]{HBufferTrace::Record(HBufferTraceEvent::Free, 7);}).join();
+    records.clear();
+    TEST_CHECK(HBufferTrace::Drain(records) == 1);
+    TEST_CHECK(records.size() == 1 && records[0].m_Size == 7);
+}
+#pragma endregion
+
+#pragma region Case
+static void TestCaseConversionKeepsCString(){
+    //A literal view and an alias of shared data are copied with room for the terminator before they are converted
+    HBuffer literal("Content-Type");
+    literal.ToLower();
+    TEST_CHECK(strcmp(literal.GetCStr(), "content-type") == 0);
+    HBuffer shared = HBuffer::CreateShared("ABCDEF", 6);
+    HBuffer copy(shared);
+    copy.ToLower();
+    TEST_CHECK(strcmp(copy.GetCStr(), "abcdef") == 0);
+    TEST_CHECK(strcmp(shared.GetCStr(), "ABCDEF") == 0);
+    HBuffer upper = shared.SubPointer(1, 3);
+    upper.ToUpper();
+    upper.ToLower();
+    TEST_CHECK(strcmp(upper.GetCStr(), "bcd") == 0);
+    TEST_CHECK(Holds(shared, "ABCDEF"));
+}
+#pragma endregion
+
+#pragma region Numbers
+/// @brief checks ToString and ToNumber of param T against std::to_string around every power of 10 and at both limits
+template<typename T>
+static bool IntegersRoundTrip(){
+    std::vector<T> values = {0, 1, 9, 10, 99, 100, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    for(T power = 10; power <= std::numeric_limits<T>::max() / 10; power *= 10){
+        values.insert(values.end(), {T(power - 1), T(power), T(power + 1)});
+        if(std::is_signed<T>::value)values.insert(values.end(), {T(0 - power + 1), T(0 - power), T(0 - power - 1)});
+    }
+    bool ok = true;
+    for(T value : values){
+        HBuffer string = HBuffer::ToString(value);
+        ok &= Holds(string, std::to_string(value).c_str());
+        T parsed = 0;
+        ok &= string.ToNumber(parsed) && parsed == value;
+    }
+    return ok;
+}
+
+/// @brief returns if param text parses into a T equal to param expected
+template<typename T>
+static bool Parses(const char* text, T expected){
+    T output = 42;
+    return HBuffer(text).ToNumber(output) && output == expected;
+}
+/// @brief returns if param text fails to parse into a T and left the output alone
+template<typename T>
+static bool Rejects(const char* text){
+    T output = 42;
+    return !HBuffer(text).ToNumber(output) && output == 42;
+}
+
+static void TestIntegerConversion(){
+    TEST_CHECK(IntegersRoundTrip<int8_t>() && IntegersRoundTrip<uint8_t>());
+    TEST_CHECK(IntegersRoundTrip<int16_t>() && IntegersRoundTrip<uint16_t>());
+    TEST_CHECK(IntegersRoundTrip<int32_t>() && IntegersRoundTrip<uint32_t>());
+    TEST_CHECK(IntegersRoundTrip<int64_t>() && IntegersRoundTrip<uint64_t>());
+    TEST_CHECK(Holds(HBuffer::ToString(0), "0") && Holds(HBuffer::ToString(-7), "-7"));
+    TEST_CHECK(Holds(HBuffer::ToString(std::numeric_limits<int64_t>::min()), "-9223372036854775808"));
+
+    //Overflow is caught at the exact limit of each type
+    TEST_CHECK(Parses<uint8_t>("255", 255) && Rejects<uint8_t>("256"));
+    TEST_CHECK(Parses<int8_t>("-128", -128) && Rejects<int8_t>("-129") && Rejects<int8_t>("128"));
+    TEST_CHECK(Parses<uint64_t>("18446744073709551615", UINT64_MAX) && Rejects<uint64_t>("18446744073709551616"));
+    TEST_CHECK(Rejects<uint64_t>("99999999999999999999") && Rejects<uint64_t>("100000000000000000000000"));
+    TEST_CHECK(Parses<int64_t>("-9223372036854775808", INT64_MIN) && Rejects<int64_t>("-9223372036854775809"));
+    TEST_CHECK(Rejects<int64_t>("9223372036854775808"));
+    //Leading zeros do not count towards the limit
+    TEST_CHECK(Parses<uint8_t>("0000000000000000000000255", 255));
+    TEST_CHECK(Rejects<int>("") && Rejects<int>("-") && Rejects<int>("+1") && Rejects<int>(" 1") && Rejects<int>("1 "));
+    TEST_CHECK(Rejects<unsigned>("-1") && Rejects<int>("--1") && Rejects<int>("1-"));
+
+    size_t strict = 7;
+    HBuffer::StrictToNumber(HBuffer("123456789012"), &strict);
+    TEST_CHECK(strict == 123456789012ull);
+    HBuffer::StrictToNumber(HBuffer("12x"), &strict);
+    TEST_CHECK(strict == 0);
+}
+
+static void TestIntegerParsingRejectsEveryBadByte(){
+    //Eight digits at a time are checked in one go, so put a bad byte at every position of every length and make sure it is never taken for a digit
+    const char bad[] = {'/', ':', ' ', '\0', '\x80', 'a', '\xB0', '\x7F'};
+    bool ok = true;
+    for(size_t len = 1; len <= 20; len++){
+        std::string digits;
+        for(size_t i = 0; i < len; i++)digits += static_cast<char>('1' + i % 9);
+        uint64_t value = 0;
+        ok &= HBufferNumbers::ParseUnsigned(digits.data(), len, value) && std::to_string(value) == digits;
+        for(size_t at = 0; at < len; at++){
+            for(char c : bad){
+                std::string broken = digits;
+                broken[at] = c;
+                ok &= !HBufferNumbers::ParseUnsigned(broken.data(), len, value);
+            }
+        }
+    }
+    TEST_CHECK(ok);
+}
+
+/// @brief checks that param value goes through ToString and ToNumber without changing a bit
+template<typename T>
+static bool FloatRoundTrips(T value){
+    HBuffer string = HBuffer::ToString(value);
+    T parsed = 0;
+    return string.ToNumber(parsed) && memcmp(&parsed, &value, sizeof(T)) == 0;
+}
+
+static void TestFloatConversion(){
+    bool ok = true;
+    for(double value : {0.0, -0.0, 0.1, -2.5, 1e300, 5e-324, std::numeric_limits<double>::max(), std::numeric_limits<double>::min()})ok &= FloatRoundTrips(value);
+    for(float value : {0.0f, 0.1f, -3.75f, 1e38f, 1e-45f, std::numeric_limits<float>::max()})ok &= FloatRoundTrips(value);
+    //Random bit patterns, skipping infinities and nans
+    uint64_t seed = 99;
+    for(int i = 0; i < 2000; i++){
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        double d;
+        memcpy(&d, &seed, sizeof(d));
+        if(std::isfinite(d))ok &= FloatRoundTrips(d);
+        uint32_t bits = static_cast<uint32_t>(seed >> 32);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        if(std::isfinite(f))ok &= FloatRoundTrips(f);
+    }
+    TEST_CHECK(ok);
+    //Shortest form that parses back
+    TEST_CHECK(Holds(HBuffer::ToString(0.1), "0.1") && Holds(HBuffer::ToString(0.1f), "0.1"));
+    TEST_CHECK(Holds(HBuffer::ToString(-2.5), "-2.5"));
+
+    float f = 1.0f;
+    HBuffer text("3.25");
+    TEST_CHECK(text.ToFloat(f) && f == 3.25f);
+    HBuffer junk("3.25x");
+    TEST_CHECK(!junk.ToFloat(f) && f == 3.25f);
+    HBuffer empty("");
+    TEST_CHECK(!empty.ToFloat(f) && f == 3.25f);
+    double d = 1.0;
+    TEST_CHECK(!HBuffer("1e400").ToNumber(d) && d == 1.0);
+}
+#pragma endregion
+
+#pragma region Binary
+static bool BytesAre(const char* data, std::initializer_list<unsigned char> bytes){
+    size_t i = 0;
+    for(unsigned char byte : bytes)if(static_cast<unsigned char>(data[i++]) != byte)return false;
+    return true;
+}
+
+static void TestBinaryByteOrder(){
+    //Every store goes to an odd offset so unaligned access is covered too
+    char memory[32] = {};
+    char* at = memory + 3;
+    HBufferBinary::Store<uint32_t>(at, 0x01020304, HBufferEndian::Little);
+    TEST_CHECK(BytesAre(at, {4, 3, 2, 1}));
+    TEST_CHECK(HBufferBinary::Load<uint32_t>(at, HBufferEndian::Little) == 0x01020304);
+    TEST_CHECK(HBufferBinary::Load<uint32_t>(at, HBufferEndian::Big) == 0x04030201);
+    HBufferBinary::Store<uint32_t>(at, 0x01020304, HBufferEndian::Big);
+    TEST_CHECK(BytesAre(at, {1, 2, 3, 4}));
+    HBufferBinary::Store<uint16_t>(at, 0xA1B2, HBufferEndian::Big);
+    TEST_CHECK(BytesAre(at, {0xA1, 0xB2}));
+    HBufferBinary::Store<uint64_t>(at, 0x0102030405060708ull, HBufferEndian::Big);
+    TEST_CHECK(BytesAre(at, {1, 2, 3, 4, 5, 6, 7, 8}));
+    TEST_CHECK(HBufferBinary::Load<uint64_t>(at, HBufferEndian::Big) == 0x0102030405060708ull);
+    HBufferBinary::Store<int16_t>(at, -2, HBufferEndian::Big);
+    TEST_CHECK(BytesAre(at, {0xFF, 0xFE}) && HBufferBinary::Load<int16_t>(at, HBufferEndian::Big) == -2);
+    //Floating point is swapped as its bits. 1.0 is 0x3FF0000000000000
+    HBufferBinary::Store(at, 1.0, HBufferEndian::Big);
+    TEST_CHECK(BytesAre(at, {0x3F, 0xF0, 0, 0, 0, 0, 0, 0}));
+    bool ok = true;
+    for(HBufferEndian endian : {HBufferEndian::Little, HBufferEndian::Big}){
+        for(size_t offset = 0; offset < 8; offset++){
+            HBufferBinary::Store(memory + offset, -1234.5f, endian);
+            ok &= HBufferBinary::Load<float>(memory + offset, endian) == -1234.5f;
+            HBufferBinary::Store(memory + offset, 6.02e23, endian);
+            ok &= HBufferBinary::Load<double>(memory + offset, endian) == 6.02e23;
+        }
+    }
+    TEST_CHECK(ok);
+
+    //Arrays give the same bytes as storing each value on its own, in both orders
+    const uint16_t values[] = {0x0102, 0xFFFE, 0, 0x8000, 0x1234};
+    for(HBufferEndian endian : {HBufferEndian::Little, HBufferEndian::Big}){
+        char one[10];
+        char array[10];
+        for(size_t i = 0; i < 5; i++)HBufferBinary::Store(one + i * 2, values[i], endian);
+        HBufferBinary::StoreArray(array, values, 5, endian);
+        TEST_CHECK(memcmp(one, array, 10) == 0);
+        uint16_t loaded[5] = {};
+        HBufferBinary::LoadArray(loaded, array, 5, endian);
+        TEST_CHECK(memcmp(loaded, values, sizeof(values)) == 0);
+    }
+}
+
+static void TestBinaryVarInts(){
+    char bytes[HBufferBinary::s_MaxVarIntSize + 1];
+    TEST_CHECK(HBufferBinary::StoreVarUInt(bytes, 300) == 2 && BytesAre(bytes, {0xAC, 0x02}));
+    TEST_CHECK(HBufferBinary::StoreVarUInt(bytes, 0) == 1 && BytesAre(bytes, {0}));
+    //Both sides of every 7 bit step and the ends of the range
+    bool ok = true;
+    for(int bits = 0; bits <= 64; bits++){
+        uint64_t power = bits < 64 ? uint64_t(1) << bits : 0;
+        for(uint64_t value : {power, power - 1, power + 1}){
+            size_t size = HBufferBinary::StoreVarUInt(bytes, value);
+            uint64_t loaded = ~value;
+            ok &= size == HBufferBinary::GetVarUIntSize(value);
+            ok &= HBufferBinary::LoadVarUInt(bytes, size, loaded) == size && loaded == value;
+            //Cut off anywhere before the last byte it is not a varint yet
+            for(size_t len = 0; len < size; len++)ok &= HBufferBinary::LoadVarUInt(bytes, len, loaded) == 0;
+        }
+    }
+    TEST_CHECK(ok);
+    TEST_CHECK(HBufferBinary::GetVarUIntSize(UINT64_MAX) == HBufferBinary::s_MaxVarIntSize);
+    //More than 64 bits, either through a big 10th byte or an 11th byte
+    uint64_t loaded = 5;
+    memset(bytes, 0xFF, 9);
+    bytes[9] = 0x02;
+    TEST_CHECK(HBufferBinary::LoadVarUInt(bytes, 10, loaded) == 0 && loaded == 5);
+    memset(bytes, 0x80, 11);
+    TEST_CHECK(HBufferBinary::LoadVarUInt(bytes, 11, loaded) == 0 && loaded == 5);
+
+    TEST_CHECK(HBufferBinary::ZigZagEncode(0) == 0 && HBufferBinary::ZigZagEncode(-1) == 1);
+    TEST_CHECK(HBufferBinary::ZigZagEncode(1) == 2 && HBufferBinary::ZigZagEncode(-2) == 3);
+    TEST_CHECK(HBufferBinary::ZigZagEncode(INT64_MIN) == UINT64_MAX);
+    bool zigzag = true;
+    for(int64_t value : {int64_t(0), int64_t(-1), int64_t(63), int64_t(-64), int64_t(64), INT64_MIN, INT64_MAX})zigzag &= HBufferBinary::ZigZagDecode(HBufferBinary::ZigZagEncode(value)) == value;
+    TEST_CHECK(zigzag);
+}
+
+static void TestBinaryWriterReader(){
+    HBuffer buffer;
+    HBufferWriter writer(buffer, HBufferEndian::Big);
+    writer.Write<uint32_t>(0xDEADBEEF);
+    writer.Write<uint16_t>(0x0102, HBufferEndian::Little);
+    const int32_t array[] = {-1, 2, -3};
+    writer.WriteArray(array, 3);
+    writer.WriteVarUInt(300);
+    writer.WriteVarInt(-65);
+    writer.WriteBytes("tail", 4);
+    TEST_CHECK(buffer.GetSize() == 4 + 2 + 12 + 2 + 2 + 4);
+    TEST_CHECK(BytesAre(buffer.GetData(), {0xDE, 0xAD, 0xBE, 0xEF, 0x02, 0x01, 0xFF, 0xFF, 0xFF, 0xFF}));
+
+    HBufferReader reader(buffer, HBufferEndian::Big);
+    uint32_t u32 = 0;
+    uint16_t u16 = 0;
+    int32_t read[3] = {};
+    uint64_t varUInt = 0;
+    int64_t varInt = 0;
+    HBuffer view;
+    TEST_CHECK(reader.Read(u32) && u32 == 0xDEADBEEF);
+    TEST_CHECK(reader.Read(u16, HBufferEndian::Little) && u16 == 0x0102);
+    TEST_CHECK(reader.ReadArray(read, 3) && read[0] == -1 && read[1] == 2 && read[2] == -3);
+    TEST_CHECK(reader.ReadVarUInt(varUInt) && varUInt == 300);
+    TEST_CHECK(reader.ReadVarInt(varInt) && varInt == -65);
+    TEST_CHECK(reader.ReadView(view, 4) && Holds(view, "tail") && view.GetData() == buffer.GetData() + buffer.GetSize() - 4);
+    TEST_CHECK(reader.GetRemaining() == 0);
+
+    //Reads that run out of data fail and leave the position alone
+    reader.SetPosition(buffer.GetSize() - 3);
+    size_t position = reader.GetPosition();
+    char bytes[8];
+    TEST_CHECK(!reader.Read(u32) && u32 == 0xDEADBEEF);
+    TEST_CHECK(!reader.ReadArray(read, 1));
+    TEST_CHECK(!reader.ReadBytes(bytes, 4));
+    TEST_CHECK(!reader.ReadView(view, 4) && Holds(view, "tail"));
+    TEST_CHECK(!reader.Skip(4));
+    TEST_CHECK(reader.GetPosition() == position);
+    TEST_CHECK(reader.ReadBytes(bytes, 3) && memcmp(bytes, "ail", 3) == 0);
+    //A varint cut off by the end of the buffer
+    HBuffer cut;
+    HBufferWriter(cut).WriteVarUInt(UINT64_MAX);
+    HBufferReader cutReader(cut.SubPointer(0, cut.GetSize() - 1));
+    TEST_CHECK(!cutReader.ReadVarUInt(varUInt) && !cutReader.ReadVarInt(varInt) && cutReader.GetPosition() == 0);
+    reader.SetPosition(1000);
+    TEST_CHECK(reader.GetPosition() == buffer.GetSize());
+}
+
+static void TestBinaryAppendExtract(){
+    HBuffer buffer;
+    buffer.AppendUInt16(0xBEEF);
+    buffer.AppendUInt32(0x01020304);
+    buffer.AppendUInt64(0x1122334455667788ull);
+    buffer.AppendBinary<int16_t>(-300, HBufferEndian::Big);
+    buffer.AppendBinary(2.5);
+    TEST_CHECK(buffer.GetSize() == 2 + 4 + 8 + 2 + 8);
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    int16_t i16 = 0;
+    double d = 0;
+    TEST_CHECK(buffer.ExtractUInt16(0, &u16) && u16 == 0xBEEF);
+    TEST_CHECK(buffer.ExtractUInt32(2, &u32) && u32 == 0x01020304);
+    TEST_CHECK(buffer.ExtractUInt64(6, &u64) && u64 == 0x1122334455667788ull);
+    TEST_CHECK(buffer.Extract(14, &i16, HBufferEndian::Big) && i16 == -300);
+    TEST_CHECK(BytesAre(buffer.GetData() + 14, {0xFE, 0xD4}));
+    TEST_CHECK(buffer.Extract(16, &d) && d == 2.5);
+    int8_t i8 = 0;
+    uint8_t u8 = 0;
+    int32_t i32 = 0;
+    TEST_CHECK(buffer.ExtractInt8(14, &i8) && i8 == -2 && buffer.ExtractUInt8(15, &u8) && u8 == 0xD4);
+    TEST_CHECK(buffer.ExtractInt32(2, &i32) && i32 == 0x01020304);
+    //Reads past the end fail without writing the output
+    u64 = 7;
+    TEST_CHECK(!buffer.ExtractUInt64(buffer.GetSize() - 7, &u64) && u64 == 7);
+    TEST_CHECK(!buffer.ExtractUInt64(buffer.GetSize() + 1, &u64) && u64 == 7);
+    TEST_CHECK(!buffer.ExtractUInt8(buffer.GetSize(), &u8));
+    TEST_CHECK(buffer.ExtractUInt8(buffer.GetSize() - 1, &u8));
+}
+#pragma endregion
+
+#pragma region Mapping
+/// @brief writes param text to a new temporary file and returns its path
+static std::string WriteTempFile(const char* text){
+    char path[] = "/tmp/HBufferTestXXXXXX";
+    int fd = mkstemp(path);
+    if(fd < 0)return std::string();
+    ssize_t written = write(fd, text, strlen(text));
+    close(fd);
+    return written == static_cast<ssize_t>(strlen(text)) ? std::string(path) : std::string();
+}
+
+/// @brief maps a file read only, runs param mutate on it and checks the mapping was copied instead of written
+template<typename Func>
+static void CheckMappedDetach(const std::string& path, const char* expected, Func mutate){
+    HBuffer mapped = HBuffer::MapFile(path.c_str());
+    HBuffer view(mapped);
+    char* data = mapped.GetData();
+    mutate(mapped);
+    TEST_CHECK(Holds(mapped, expected));
+    TEST_CHECK(mapped.GetData() != data);
+    TEST_CHECK(Holds(view, "mapped"));
+}
+
+static void TestReadOnlyMappingCopiesOnWrite(){
+    std::string path = WriteTempFile("mapped");
+    TEST_CHECK(!path.empty());
+    CheckMappedDetach(path, "deppam", [](HBuffer& buffer){buffer.Reverse();});
+    CheckMappedDetach(path, "Mapped", [](HBuffer& buffer){buffer.GetWritable(0) = 'M';});
+    CheckMappedDetach(path, "zz", [](HBuffer& buffer){buffer.Memset('z', 2);});
+    CheckMappedDetach(path, "MApped", [](HBuffer& buffer){buffer.Memcpy("MA", 2);});
+    {
+        //A read only mapping is copied even when nothing else shares it
+        HBuffer mapped = HBuffer::MapFile(path.c_str());
+        char* data = mapped.GetData();
+        mapped.Reverse();
+        TEST_CHECK(Holds(mapped, "deppam"));
+        TEST_CHECK(mapped.GetData() != data);
+    }
+    {
+        //A private mapping nothing else shares is written in place. The file never changes
+        HBuffer mapped = HBuffer::MapFile(path.c_str(), HBufferMapMode::Private);
+        char* data = mapped.GetData();
+        mapped.GetWritable(0) = 'M';
+        TEST_CHECK(Holds(mapped, "Mapped"));
+    #if HBUFF_COW_UNIQUE_CHECK
+        TEST_CHECK(mapped.GetData() == data);
+    #else
+        (void)data;
+    #endif
+    }
+    HBuffer reread = HBuffer::MapFile(path.c_str());
+    TEST_CHECK(Holds(reread, "mapped"));
+    unlink(path.c_str());
+}
+#pragma endregion
+
+#pragma region Allocators
+/// @brief counts what it hands out and says whether it is thread safe as told
+class CountingAllocator : public HBufferAllocator{
+public:
+    explicit CountingAllocator(bool threadSafe) : m_ThreadSafe(threadSafe){}
+    char* Allocate(size_t size) HBUFF_NOEXCEPT override{
+        m_Live++;
+        return new char[size];
+    }
+    void Deallocate(char* data, size_t) HBUFF_NOEXCEPT override{
+        m_Live--;
+        delete[] data;
+    }
+    bool IsThreadSafe() const HBUFF_NOEXCEPT override{return m_ThreadSafe;}
+public:
+    size_t m_Live = 0;
+    bool m_ThreadSafe;
+};
+
+static void TestSharedBlocksNeedThreadSafeAllocators(){
+    CountingAllocator local(false);
+    CountingAllocator anywhere(true);
+    {
+        HBufferAllocatorScope scope(&local);
+        HBuffer owned;
+        owned.Append("more than twenty four chars...", 30);
+        TEST_CHECK(local.m_Live == 1);
+        //The last reference may drop on another thread so neither the block nor its copy of the data comes from the thread's allocator
+        HBuffer shared = HBuffer::CreateShared("shared", 6);
+        owned.MakeShared();
+        TEST_CHECK(local.m_Live == 0);
+        TEST_CHECK(shared.IsShared() && owned.IsShared());
+        HBuffer explicitly = HBuffer::CreateShared("shared", 6, &local);
+        TEST_CHECK(local.m_Live == 0);
+
+        HBufferAllocatorScope inner(&anywhere);
+        HBuffer pooled = HBuffer::CreateShared("shared", 6);
+        TEST_CHECK(anywhere.m_Live == 1);
+    }
+    TEST_CHECK(anywhere.m_Live == 0);
+    //Data that came from new[] is not given to an allocator set later when it is made shared
+    HBuffer heap;
+    heap.Append("more than twenty four chars...", 30);
+    {
+        HBufferAllocatorScope scope(&anywhere);
+        heap.MakeShared();
+        TEST_CHECK(anywhere.m_Live == 1);
+    }
+    heap.Free();
+    TEST_CHECK(anywhere.m_Live == 0);
+    //Dropping a prefix shares owned data. Data from an allocator that is not thread safe is copied out of it once instead of taken over
+    {
+        HBuffer pooled(&local);
+        pooled.Append("more than twenty four chars...", 30);
+        TEST_CHECK(local.m_Live == 1);
+        pooled.RemovePrefix(5);
+        TEST_CHECK(local.m_Live == 0);
+        TEST_CHECK(pooled.IsShared() && Holds(pooled, "than twenty four chars..."));
+        pooled.RemovePrefix(5);
+        TEST_CHECK(Holds(pooled, "twenty four chars..."));
+        std::thread([moved = std::move(pooled)]() mutable{moved.Free();}).join();
+        HBuffer taken(&anywhere);
+        taken.Append("more than twenty four chars...", 30);
+        char* data = taken.GetData();
+        taken.RemovePrefix(5);
+        //The allocation and the block header that took it over
+        TEST_CHECK(anywhere.m_Live == 2 && taken.GetData() == data + 5);
+        taken.MakeShared();
+        TEST_CHECK(taken.GetData() == data + 5);
+    }
+    TEST_CHECK(local.m_Live == 0 && anywhere.m_Live == 0);
+    TEST_CHECK(!HBufferPoolAllocator().IsThreadSafe() && HBufferRecyclingAllocator::Get()->IsThreadSafe());
+}
+
+static void TestRecyclingHitRate(){
+    HBufferRecyclingAllocator pool;
+    for(int i = 0; i < 100; i++){
+        HBuffer buffer(&pool);
+        buffer.Reserve(100);
+        TEST_CHECK(buffer.GetCapacity() == 128);
+    }
+    HBufferRecyclingStats stats = pool.GetStats();
+    TEST_CHECK(stats.m_Misses == 1);
+    TEST_CHECK(stats.m_ThreadHits == 99);
+    TEST_CHECK(stats.m_SharedHits == 0);
+    TEST_CHECK(stats.m_Recycled == 100);
+    TEST_CHECK(stats.GetHitRate() > 0.98 && stats.GetHitRate() < 1.0);
+    //Sizes above HBUFF_SIZE_CLASS_MAX go to the heap and are not counted
+    HBuffer large(&pool);
+    large.Reserve(HBUFF_SIZE_CLASS_MAX + 1);
+    large.Free();
+    TEST_CHECK(pool.GetStats().m_Misses == 1 && pool.GetStats().m_Recycled == 100);
+}
+
+static void TestRecyclingTrim(){
+    const size_t blockSize = HBUFF_SIZE_CLASS_MAX;
+    HBufferRecyclingAllocator pool;
+    std::vector<char*> blocks;
+    for(int i = 0; i < 10; i++)blocks.push_back(pool.Allocate(blockSize));
+    for(char* block : blocks)pool.Deallocate(block, blockSize);
+    //A thread keeps atmost 4 blocks of this class and moved the rest to the shared overflow
+    HBufferRecyclingStats stats = pool.GetStats();
+    TEST_CHECK(stats.m_Recycled == 10 && stats.m_Released == 0);
+    TEST_CHECK(stats.m_SharedBytes >= 6 * blockSize && stats.m_SharedBytes < 10 * blockSize);
+    pool.TrimThreadCache();
+    TEST_CHECK(pool.GetStats().m_SharedBytes == 10 * blockSize);
+    pool.Trim(3 * blockSize);
+    stats = pool.GetStats();
+    TEST_CHECK(stats.m_SharedBytes == 3 * blockSize);
+    TEST_CHECK(stats.m_Released == 7);
+    pool.Trim();
+    TEST_CHECK(pool.GetStats().m_SharedBytes == 0 && pool.GetStats().m_Released == 10);
+    //The limit holds for blocks flushed out of a thread cache too
+    pool.SetMaxSharedBytes(2 * blockSize);
+    blocks.clear();
+    for(int i = 0; i < 6; i++)blocks.push_back(pool.Allocate(blockSize));
+    for(char* block : blocks)pool.Deallocate(block, blockSize);
+    pool.TrimThreadCache();
+    stats = pool.GetStats();
+    TEST_CHECK(stats.m_SharedBytes == 2 * blockSize);
+    TEST_CHECK(stats.m_Released == 14);
+}
+
+static void TestRecyclingAcrossThreads(){
+    HBufferRecyclingAllocator pool;
+    std::vector<HBuffer> buffers;
+    for(int i = 0; i < 4; i++){
+        buffers.emplace_back(&pool);
+        buffers.back().Reserve(1000);
+    }
+    //Freed on another thread, the blocks end up in the shared overflow when that thread exits
+    std::thread([moved = std::move(buffers)]() mutable{moved.clear();}).join();
+    HBufferRecyclingStats stats = pool.GetStats();
+    TEST_CHECK(stats.m_Misses == 4);
+    TEST_CHECK(stats.m_Recycled == 4);
+    TEST_CHECK(stats.m_SharedBytes == 4 * 1024);
+    HBuffer reused(&pool);
+    reused.Reserve(1000);
+    stats = pool.GetStats();
+    TEST_CHECK(stats.m_SharedHits == 1 && stats.m_Misses == 4);
+    //The refill took what the overflow had for this class into our cache
+    TEST_CHECK(stats.m_SharedBytes == 0);
+    reused.Free();
+    pool.TrimThreadCache();
+    TEST_CHECK(pool.GetStats().m_SharedBytes == 4 * 1024);
+}
+
+/// @brief frees buffers from param pool in a thread local destructor that runs after the thread's recycling caches are gone
+static void FreeWhileExiting(HBufferRecyclingAllocator* pool, size_t count){
+    //Constructed before the first allocation constructs the caches, so destroyed after them
+    thread_local std::vector<HBuffer> buffers;
+    for(size_t i = 0; i < count; i++){
+        buffers.emplace_back(pool);
+        buffers.back().Reserve(100);
+    }
+}
+
+static void TestRecyclingExitingThread(){
+    HBufferRecyclingAllocator pool(2 * 128);
+    std::thread(FreeWhileExiting, &pool, 8).join();
+    //Only what fits in the overflow is kept, the rest goes back to the heap and is not counted as recycled
+    HBufferRecyclingStats stats = pool.GetStats();
+    TEST_CHECK(stats.m_Misses == 8);
+    TEST_CHECK(stats.m_SharedBytes == 2 * 128);
+    TEST_CHECK(stats.m_Recycled == 2);
+    TEST_CHECK(stats.m_Released == 6);
+}
+#pragma endregion
+
+#pragma region Joins
+static void TestVectorJoinLookups(){
+    //Empty buffers in between share their start with the next buffer and must never be landed in
+    const char* pieces[] = {"alpha", "", "be", "", "", "gamma-delta", "e"};
+    std::string text;
+    HBufferVectorJoin<> join;
+    for(const char* piece : pieces){
+        text += piece;
+        join.EmplaceBack(HBuffer(piece, strlen(piece), false, false));
+    }
+    TEST_CHECK(join.GetSize() == text.size());
+    HBufferVectorJoin<>::Cursor cursor;
+    bool sequential = true;
+    for(size_t i = 0; i < text.size(); i++)sequential &= join.Get(i, cursor) == text[i] && join.At(i) == text[i];
+    TEST_CHECK(sequential);
+    bool backwards = true;
+    for(size_t i = text.size(); i-- > 0;)backwards &= join.Get(i, cursor) == text[i] && join.Get(i) == text[i];
+    TEST_CHECK(backwards);
+    TEST_CHECK(join.Get(text.size(), cursor) == '\0');
+    std::string iterated(join.begin(), join.end());
+    TEST_CHECK(iterated == text);
+    TEST_CHECK(*join.IteratorAt(5) == 'b' && join.IteratorAt(5).GetPosition() == 5);
+    TEST_CHECK(join.GetInfo(7).m_Indice == 5 && join.GetInfo(7).m_ByteOffset == 0);
+    //A cursor from before the join changed only misses, it never lands in the wrong buffer
+    cursor = HBufferVectorJoin<>::Cursor();
+    TEST_CHECK(join.Get(text.size() - 1, cursor) == 'e');
+    join.Erase(0);
+    text.erase(0, 5);
+    bool afterErase = true;
+    for(size_t i = 0; i < text.size(); i++)afterErase &= join.Get(i, cursor) == text[i];
+    TEST_CHECK(afterErase);
+}
+
+static void TestConstJoinsReadFromThreads(){
+    //Const lookups keep no state in the join so many threads may read one at once. Run under -fsanitize=thread to see races
+    std::string text;
+    HBufferVectorJoin<> join;
+    for(int i = 0; i < 200; i++){
+        std::string piece = std::to_string(i * 31) + ";";
+        text += piece;
+        join.EmplaceBack(HBuffer::CreateShared(piece.data(), piece.size()));
+    }
+    HBufferRope rope;
+    for(const HBuffer& buffer : join.GetVectors())rope.Append(buffer);
+    const HBufferVectorJoin<>& shared = join;
+    const HBufferRope& sharedRope = rope;
+    uint64_t hash = HBufferHash::Hash(text.data(), text.size());
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; t++){
+        readers.emplace_back([&, t]{
+            for(size_t round = 0; round < 20; round++){
+                for(size_t i = t; i < text.size(); i += 7){
+                    if(shared.Get(i) != text[i] || sharedRope.Get(i) != text[i])mismatches++;
+                }
+                if(shared.Find(";6169;") != text.find(";6169;"))mismatches++;
+                if(sharedRope.Find(";6169;") != text.find(";6169;") || sharedRope.Hash() != hash)mismatches++;
+            }
+        });
+    }
+    for(std::thread& reader : readers)reader.join();
+    TEST_CHECK(mismatches == 0);
+}
+
+/// @brief builds a rope of views into param text cut at every offset in param cuts
+static HBufferRope RopeOf(const std::string& text, std::initializer_list<size_t> cuts){
+    HBufferRope rope;
+    size_t at = 0;
+    for(size_t cut : cuts){
+        rope.Append(HBuffer(text.data() + at, cut - at, false, false));
+        at = cut;
+    }
+    rope.Append(HBuffer(text.data() + at, text.size() - at, false, false));
+    return rope;
+}
+
+static std::string RopeText(const HBufferRope& rope){
+    return std::string(rope.begin(), rope.end());
+}
+
+static void TestRopeBuild(){
+    HBufferRope rope;
+    rope.Append(HBuffer("middle", 6, false, false));
+    rope.Append(HBuffer("", 0, false, false));
+    rope.Prepend(HBuffer("front-", 6, false, false));
+    rope.Prepend(HBuffer("", 0, false, false));
+    rope.Append(HBuffer("-back", 5, false, false));
+    //Empty buffers are dropped and prepending moves nothing else
+    TEST_CHECK(rope.GetSegmentCount() == 3);
+    TEST_CHECK(RopeText(rope) == "front-middle-back" && rope.GetSize() == 17);
+    TEST_CHECK(rope.GetSegmentStart(0) == 0 && rope.GetSegmentStart(1) == 6 && rope.GetSegmentStart(2) == 12);
+    TEST_CHECK(rope.Get(6) == 'm' && rope.Get(16) == 'k' && rope.Get(17) == '\0');
+    HBufferRope tail;
+    tail.Append(HBuffer("!", 1, false, false));
+    rope.Append(tail);
+    TEST_CHECK(RopeText(rope) == "front-middle-back!" && rope.GetSegmentCount() == 4);
+    rope.RemovePrefix(8);
+    TEST_CHECK(RopeText(rope) == "ddle-back!" && rope.GetSegmentCount() == 3 && rope.GetSegmentStart(1) == 4);
+    rope.RemovePrefix(4);
+    TEST_CHECK(RopeText(rope) == "-back!" && rope.GetSegmentCount() == 2);
+    rope.RemovePrefix(100);
+    TEST_CHECK(rope.GetSize() == 0 && rope.begin() == rope.end());
+}
+
+static void TestRopeSplitAndCopy(){
+    std::string text = "The quick brown fox jumps over";
+    size_t size = text.size();
+    bool split = true;
+    bool sub = true;
+    bool copies = true;
+    for(size_t at = 0; at <= size; at++){
+        HBufferRope head = RopeOf(text, {4, 10, 16, 17});
+        HBufferRope tail = head.Split(at);
+        split &= RopeText(head) == text.substr(0, at) && RopeText(tail) == text.substr(at);
+        split &= head.GetSize() == at && tail.GetSize() == size - at;
+        //Appending the halves back gives the same rope
+        head.Append(tail);
+        split &= RopeText(head) == text;
+
+        HBufferRope rope = RopeOf(text, {4, 10, 16, 17});
+        for(size_t len : {size_t(0), size_t(1), size_t(7), size_t(-1)}){
+            std::string expected = text.substr(at, len);
+            sub &= RopeText(rope.SubRope(at, len)) == expected;
+            HBuffer string = rope.SubString(at, len);
+            sub &= std::string(string.GetData()) == expected;
+            char out[64];
+            copies &= rope.CopyTo(out, at, len) == expected.size() && memcmp(out, expected.data(), expected.size()) == 0;
+            HBuffer appended("> ");
+            copies &= rope.CopyTo(appended, at, len) == expected.size() && std::string(appended.GetData(), appended.GetSize()) == "> " + expected;
+        }
+        //The iterator starts at any byte and counts its position
+        HBufferRope::Iterator it = rope.IteratorAt(at);
+        copies &= std::string(it, rope.end()) == text.substr(at) && it.GetPosition() == at;
+    }
+    TEST_CHECK(split);
+    TEST_CHECK(sub);
+    TEST_CHECK(copies);
+}
+
+static void TestRopeSearch(){
+    unsigned seed = 3;
+    std::string text = RandomText(30, seed) + "needle" + RandomText(30, seed);
+    size_t size = text.size();
+    const char* needles[] = {"needle", "ab", "a\nb", "\xE9" "a", "aab\xE9", "zz", ""};
+    bool ok = true;
+    for(size_t cut = 1; cut < size; cut++){
+        //A one byte buffer right after the cut so matches span three buffers
+        HBufferRope rope = RopeOf(text, {cut, std::min(cut + 1, size), std::min(cut + 5, size)});
+        for(size_t from = 0; from <= size; from += 5){
+            for(char c : {'a', '\n', '\xE9', 'z'})ok &= rope.Find(c, from) == text.find(c, from);
+            for(const char* needle : needles)ok &= rope.Find(needle, strlen(needle), from) == text.find(needle, from);
+            ok &= rope.FindFirstOf("\n\xE9", 2, from) == text.find_first_of("\n\xE9", from);
+        }
+        for(char c : {'a', '\n', '\xE9', 'z'})ok &= rope.FindLast(c) == text.rfind(c) && rope.Contains(c) == (text.find(c) != std::string::npos);
+        if(cut >= 3 && cut + 3 <= size){
+            std::string straddling = text.substr(cut - 3, 6);
+            ok &= rope.Find(straddling.data(), 6) == text.find(straddling) && rope.Contains(straddling.data(), 6);
+            ok &= rope.StartsWith(cut - 3, straddling.data(), 6) && !rope.StartsWith(cut - 2, straddling.data(), 6);
+        }
+        ok &= rope.StartsWith(text.substr(0, cut + 1).c_str()) && rope.EndsWith(text.substr(cut - 1).c_str());
+        ok &= !rope.EndsWith((text + "x").c_str()) && !rope.StartsWith(size - 1, "ab", 2);
+    }
+    TEST_CHECK(ok);
+}
+
+static void TestRopeCompareAndHash(){
+    std::string text = "hello rope world";
+    HBufferRope one = RopeOf(text, {1, 8});
+    HBufferRope other = RopeOf(text, {5, 6, 15});
+    //How the bytes are cut up never matters
+    TEST_CHECK(one.Equals(other) && one == other && one.Compare(other) == 0);
+    TEST_CHECK(one.Hash() == other.Hash() && one.Hash() == HBufferHash::Hash(text.data(), text.size()));
+    TEST_CHECK(one.Hash(9) == HBufferHash::Hash(text.data(), text.size(), 9));
+    TEST_CHECK(std::hash<HBufferRope>()(one) == std::hash<HBuffer>()(HBuffer(text.data(), text.size(), false, false)));
+    TEST_CHECK(one.Compare(text.data(), text.size()) == 0 && one.Equals(text.data(), text.size()));
+    //Ordering is by bytes first then by size
+    std::string longer = text + "!";
+    std::string bigger = "hello ropeworld";
+    HBufferRope longRope = RopeOf(longer, {3, 12});
+    HBufferRope bigRope = RopeOf(bigger, {10});
+    TEST_CHECK(one < longRope && longRope.Compare(one) > 0 && one <= longRope);
+    TEST_CHECK(bigRope.Compare(one) > 0 && one < bigRope && !(bigRope < one));
+    TEST_CHECK(one.Compare("hello", 5) > 0 && one.Compare("hello z", 7) < 0);
+    TEST_CHECK(one.Compare(HBuffer("hello rope world")) == 0);
+    TEST_CHECK(!one.Equals(longRope) && one.Hash() != longRope.Hash());
+    HBufferRope empty;
+    TEST_CHECK(empty.Compare("", 0) == 0 && empty < one && empty.Hash() == HBufferHash::Hash("", 0));
+}
+
+static void TestRopeStaleCursor(){
+    //A cursor from before a prepend points at the wrong buffer index now, it must only miss
+    std::string text = "abcdefghij";
+    HBufferRope rope = RopeOf(text, {2, 5, 7});
+    HBufferRope::Cursor cursor;
+    bool before = true;
+    for(size_t i = 0; i < text.size(); i++)before &= rope.Get(i, cursor) == text[i];
+    TEST_CHECK(before);
+    rope.Prepend(HBuffer("XY", 2, false, false));
+    rope.Prepend(HBuffer("W", 1, false, false));
+    std::string expected = "WXY" + text;
+    bool after = true;
+    for(size_t i = expected.size(); i-- > 0;)after &= rope.Get(i, cursor) == expected[i];
+    for(size_t i = 0; i < expected.size(); i++)after &= rope.Get(i, cursor) == expected[i];
+    TEST_CHECK(after);
+    rope.RemovePrefix(4);
+    expected.erase(0, 4);
+    bool removed = true;
+    for(size_t i = 0; i < expected.size(); i++)removed &= rope.Get(i, cursor) == expected[i];
+    TEST_CHECK(removed && rope.Get(expected.size(), cursor) == '\0');
+}
+#pragma endregion
+
+#pragma region Scatter gather
+/// @brief returns every byte of param join, gathered through GetIOVecs like writev sees them
+template<typename Join>
+static std::string Flatten(const Join& join){
+    std::string text;
+    iovec vecs[16];
+    while(text.size() < join.GetSize()){
+        size_t count = join.GetIOVecs(vecs, 16, text.size());
+        for(size_t i = 0; i < count; i++)text.append(static_cast<const char*>(vecs[i].iov_base), vecs[i].iov_len);
+    }
+    return text;
+}
+
+/// @brief reads until param len bytes arrived, the other end closed or a non blocking fd has nothing left
+static std::string ReadAvailable(int fd, size_t len){
+    std::string text(len, '\0');
+    size_t got = 0;
+    while(got < len){
+        ssize_t n = read(fd, &text[got], len - got);
+        if(n <= 0)break;
+        got += n;
+    }
+    text.resize(got);
+    return text;
+}
+
+/// @brief runs param func with the read and write end of a pipe or a unix socketpair
+template<typename Func>
+static void WithFds(bool socket, Func func){
+    int fds[2];
+    int result = socket ? socketpair(AF_UNIX, SOCK_STREAM, 0, fds) : pipe(fds);
+    TEST_CHECK(result == 0);
+    if(result != 0)return;
+    func(fds[0], fds[1]);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/// @brief writes param join to one end of a pipe and a socketpair and checks the other end got param expected and the join is empty
+template<typename Join>
+static void CheckWriteTo(Join& join, const std::string& expected){
+    for(bool socket : {false, true}){
+        Join copy = join;
+        WithFds(socket, [&](int readEnd, int writeEnd){
+            ssize_t written = copy.WriteTo(writeEnd);
+            TEST_CHECK(written == static_cast<ssize_t>(expected.size()));
+            TEST_CHECK(copy.GetSize() == 0);
+            TEST_CHECK(ReadAvailable(readEnd, expected.size()) == expected);
+        });
+    }
+}
+
+/// @brief sends param text down a pipe and a socketpair into param join and checks the join holds it after
+template<typename Join>
+static void CheckReadFrom(Join& join, const std::string& text){
+    for(bool socket : {false, true}){
+        Join copy = join;
+        WithFds(socket, [&](int readEnd, int writeEnd){
+            TEST_CHECK(write(writeEnd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+            TEST_CHECK(copy.ReadFrom(readEnd) == static_cast<ssize_t>(text.size()));
+            TEST_CHECK(Flatten(copy) == text);
+        });
+    }
+}
+
+static void TestJoinIO(){
+    HBufferJoin join(HBuffer("hello ", 6, false, false), HBuffer::CreateShared("world", 5));
+    CheckWriteTo(join, "hello world");
+    HBufferJoin target(HBuffer::CreateShared("......", 6), HBuffer("-----", 5, false, false));
+    CheckReadFrom(target, "HELLO WORLD");
+    //ReadFrom detached both buffers instead of writing through them
+    TEST_CHECK(Flatten(target) == "......-----");
+}
+
+static void TestVectorJoinIO(){
+    //More segments than one writev or readv takes
+    const size_t segments = HBUFF_IOV_MAX * 2 + 3;
+    HBufferVectorJoin<> join;
+    std::string expected;
+    for(size_t i = 0; i < segments; i++){
+        std::string piece = std::to_string(i) + ",";
+        expected += piece;
+        if(i % 2)join.EmplaceBack(HBuffer::CreateShared(piece.data(), piece.size()));
+        else{
+            HBuffer owned;
+            owned.Append(piece.data(), piece.size());
+            join.EmplaceBack(std::move(owned));
+        }
+    }
+    TEST_CHECK(Flatten(join) == expected);
+    CheckWriteTo(join, expected);
+
+    std::string text;
+    HBufferVectorJoin<> target;
+    for(size_t i = 0; i < segments; i++){
+        text += "abc";
+        target.EmplaceBack(i % 3 == 0 ? HBuffer("xyz", 3, false, false) : HBuffer::CreateShared("xyz", 3));
+    }
+    for(char& c : text)c = static_cast<char>(c - 32);
+    HBuffer alias = target.GetVectors()[1];
+    CheckReadFrom(target, text);
+    TEST_CHECK(Holds(alias, "xyz"));
+}
+
+static void TestRopeIO(){
+    HBufferRope rope;
+    rope.Append(HBuffer::CreateShared("middle ", 7));
+    rope.Prepend(HBuffer("front ", 6, false, false));
+    rope.Append(HBuffer("back", 4, false, false));
+    CheckWriteTo(rope, "front middle back");
+    HBufferRope target;
+    HBuffer mapped = HBuffer::CreateShared("0123456789", 10);
+    target.Append(mapped.SubPointer(0, 4));
+    target.Append(mapped.SubPointer(4, 6));
+    CheckReadFrom(target, "abcdefghij");
+    TEST_CHECK(Holds(mapped, "0123456789"));
+}
+
+static void TestNonBlockingPartialWrite(){
+    WithFds(true, [](int readEnd, int writeEnd){
+        int buffer = 4096;
+        setsockopt(writeEnd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+        fcntl(writeEnd, F_SETFL, fcntl(writeEnd, F_GETFL) | O_NONBLOCK);
+        fcntl(readEnd, F_SETFL, fcntl(readEnd, F_GETFL) | O_NONBLOCK);
+        const size_t size = 4 << 20;
+        std::string expected;
+        for(size_t i = 0; expected.size() < size; i++)expected += std::to_string(i) + ";";
+        HBuffer payload;
+        payload.Append(expected.data(), expected.size());
+        //A view taken before sending must keep pointing at the same bytes, nothing may move underneath it
+        HBuffer view = payload.SubPointer(size / 2, 10);
+        std::string viewed(view.GetData(), view.GetSize());
+        HBufferJoin join;
+        join.GetBuffer1() = std::move(payload);
+        join.GetBuffer2() = HBuffer("end", 3, false, false);
+        TEST_CHECK(join.GetBuffer1().CanFree());
+        expected += "end";
+
+        std::string received;
+        size_t calls = 0;
+        size_t allocations = 0;
+        while(join.GetSize() > 0 && calls < 100000){
+            calls++;
+            allocations += CountAllocations([&]{
+                ssize_t written = join.WriteTo(writeEnd);
+                TEST_CHECK(written > 0 || errno == EAGAIN);
+            });
+            received += ReadAvailable(readEnd, expected.size() - received.size());
+        }
+        TEST_CHECK(calls > 1);
+        //Only the shared block that takes over the payload's allocation on the first partial write
+        TEST_CHECK(allocations <= 1);
+        TEST_CHECK(received == expected);
+        TEST_CHECK(std::string(view.GetData(), view.GetSize()) == viewed);
+    });
+}
+#pragma endregion
+
+#pragma region Ring
+static void TestRingFullAndEmpty(){
+    HBufferRing ring(10);
+    TEST_CHECK(ring.GetCapacity() == 16 && ring.IsEmpty() && !ring.IsFull() && ring.GetFree() == 16);
+    char out[32] = {};
+    TEST_CHECK(ring.Read(out, 8) == 0 && ring.Get(0) == '\0');
+    TEST_CHECK(ring.GetReadSpans().GetSize() == 0 && ring.Find('a') == HBUFF_NPOS);
+    //Only what fits goes in
+    TEST_CHECK(ring.Write("0123456789abcdefXYZ", 19) == 16);
+    TEST_CHECK(ring.IsFull() && ring.GetFree() == 0 && ring.GetWriteSpans().GetSize() == 0);
+    TEST_CHECK(ring.Write("!", 1) == 0);
+    ring.Commit(5);
+    TEST_CHECK(ring.GetSize() == 16);
+    //Peek leaves the data, Read takes it
+    TEST_CHECK(ring.Peek(out, 4) == 4 && memcmp(out, "0123", 4) == 0 && ring.GetSize() == 16);
+    TEST_CHECK(ring.Read(out, 4) == 4 && memcmp(out, "0123", 4) == 0 && ring.GetSize() == 12);
+    TEST_CHECK(ring.Get(0) == '4' && ring.Get(11) == 'f' && ring.Get(12) == '\0');
+    ring.Consume(100);
+    TEST_CHECK(ring.IsEmpty() && ring.GetFree() == 16);
+    ring.Write("abc", 3);
+    ring.Clear();
+    TEST_CHECK(ring.IsEmpty() && ring.GetReadSpans().GetSize() == 0);
+}
+
+/// @brief writes param len bytes of param text into the free spans of param ring and commits them
+static void FillWriteSpans(HBufferRing& ring, const char* text, size_t len){
+    HBufferJoin spans = ring.GetWriteSpans();
+    size_t first = std::min(len, spans.GetBuffer1().GetSize());
+    memcpy(spans.GetBuffer1().GetData(), text, first);
+    memcpy(spans.GetBuffer2().GetData(), text + first, len - first);
+    ring.Commit(len);
+}
+
+/// @brief streams random text through param ring in random sized steps and checks every view of it against a plain string
+static void CheckRingStream(HBufferRing& ring){
+    unsigned seed = 11;
+    auto random = [&seed](unsigned range){
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % range;
+    };
+    std::string model;
+    std::string written;
+    std::string read;
+    bool ok = true;
+    bool wrapped = false;
+    for(int step = 0; step < 2000; step++){
+        size_t capacity = ring.GetCapacity();
+        ok &= ring.GetWriteSpans().GetSize() == ring.GetFree() && ring.GetFree() == capacity - model.size();
+        size_t len = std::min<size_t>(random(capacity / 2 + 1), ring.GetFree());
+        std::string text = RandomText(len, seed);
+        if(step % 2 == 0)FillWriteSpans(ring, text.data(), len);
+        else ok &= ring.Write(text.data(), text.size()) == len;
+        model += text;
+        written += text;
+
+        HBufferJoin spans = ring.GetReadSpans();
+        ok &= Flatten(spans) == model && ring.GetSize() == model.size();
+        wrapped |= spans.GetBuffer2().GetSize() > 0;
+        //Without double mapping the single span stops at the end of the memory, with it the span is everything
+        HBuffer span = ring.GetReadSpan();
+        ok &= span.GetSize() == (ring.IsDoubleMapped() ? model.size() : spans.GetBuffer1().GetSize());
+        ok &= std::string(span.GetData(), span.GetSize()) == model.substr(0, span.GetSize());
+        for(char c : {'a', '\n', 'z'})ok &= ring.Find(c, model.size() / 3) == model.find(c, model.size() / 3);
+        if(model.size() >= 4){
+            std::string middle = model.substr(model.size() / 2 - 2, 4);
+            ok &= ring.Find(middle.data(), 4) == model.find(middle);
+            ok &= ring.StartsWith(model.data(), model.size()) && ring.StartsWith(model.data(), 3);
+        }
+        ok &= !ring.StartsWith((model + "x").data(), model.size() + 1);
+        for(size_t i = 0; i <= model.size(); i += 7)ok &= ring.Get(i) == (i < model.size() ? model[i] : '\0');
+
+        size_t take = random(static_cast<unsigned>(model.size() + 1));
+        if(step % 3 == 0){
+            read += model.substr(0, take);
+            ring.Consume(take);
+        }
+        else{
+            std::string out(take, '\0');
+            ok &= ring.Read(&out[0], take) == take;
+            read += out;
+        }
+        model.erase(0, take);
+    }
+    TEST_CHECK(ok);
+    TEST_CHECK(wrapped || ring.IsDoubleMapped());
+    TEST_CHECK(read == written.substr(0, read.size()));
+}
+
+static void TestRingWrapAround(){
+    HBufferRing ring(64);
+    CheckRingStream(ring);
+    //Spans are views so streaming through the ring never allocates
+    HBufferRing quiet(64);
+    char out[40];
+    size_t allocations = CountAllocations([&]{
+        for(int i = 0; i < 100; i++){
+            FillWriteSpans(quiet, "the ring buffer wraps around", 28);
+            quiet.GetReadSpans().Find("wraps", 5);
+            quiet.Read(out, 28);
+        }
+    });
+    TEST_CHECK(allocations == 0);
+}
+
+static void TestRingDoubleMapped(){
+    HBufferRing ring(100, true);
+#if defined(__linux__)
+    TEST_CHECK(ring.IsDoubleMapped());
+#endif
+    if(!ring.IsDoubleMapped()){
+        TEST_CHECK(ring.GetCapacity() == 128);
+        return;
+    }
+    size_t capacity = ring.GetCapacity();
+    TEST_CHECK(capacity >= 100 && (capacity & (capacity - 1)) == 0);
+    //Park the read position near the end so the next write wraps. Both mappings see the same memory so the span stays contiguous
+    std::string filler(capacity - 3, '.');
+    ring.Write(filler.data(), filler.size());
+    ring.Consume(filler.size());
+    TEST_CHECK(ring.GetWriteSpan().GetSize() == capacity && ring.GetWriteSpans().GetBuffer2().GetSize() == 0);
+    ring.Write("wrapped", 7);
+    HBuffer span = ring.GetReadSpan();
+    TEST_CHECK(Holds(span, "wrapped") && ring.GetReadSpans().GetBuffer2().GetSize() == 0);
+    TEST_CHECK(ring.Find("pped", 4) == 3);
+    ring.Clear();
+    CheckRingStream(ring);
+}
+
+static void TestRingFds(){
+    //readv and writev go straight into and out of the two spans when the data wraps
+    WithFds(false, [](int in, int out){
+        HBufferRing ring(16);
+        ring.Write("0123456789ab", 12);
+        ring.Consume(10);
+        TEST_CHECK(write(out, "ABCDEFGHIJKLMN", 14) == 14);
+        TEST_CHECK(ring.ReadFrom(in) == 14);
+        TEST_CHECK(ring.IsFull() && ring.GetReadSpans().GetBuffer2().GetSize() > 0);
+        TEST_CHECK(Flatten(ring.GetReadSpans()) == "abABCDEFGHIJKLMN");
+        TEST_CHECK(ring.WriteTo(out) == 16 && ring.IsEmpty());
+        TEST_CHECK(ReadAvailable(in, 16) == "abABCDEFGHIJKLMN");
+    });
+}
+#pragma endregion
+
+#pragma region Queues
+template<typename Queue>
+static void CheckQueueFullAndEmpty(){
+    Queue queue(3);
+    TEST_CHECK(queue.GetCapacity() == 4);
+    HBuffer out("untouched");
+    TEST_CHECK(!queue.TryPop(out) && Holds(out, "untouched"));
+    //Several laps so the slots get reused
+    const char* words[] = {"one", "two", "three", "four"};
+    bool ok = true;
+    for(int lap = 0; lap < 5; lap++){
+        for(const char* word : words)ok &= queue.TryPush(HBuffer(word));
+        HBuffer extra("extra");
+        ok &= !queue.TryPush(std::move(extra)) && Holds(extra, "extra");
+        for(const char* word : words)ok &= queue.TryPop(out) && Holds(out, word);
+        ok &= !queue.TryPop(out) && Holds(out, "four");
+    }
+    TEST_CHECK(ok);
+}
+
+static void TestQueuesFullAndEmpty(){
+    CheckQueueFullAndEmpty<HBufferSpscQueue>();
+    CheckQueueFullAndEmpty<HBufferMpscQueue>();
+    HBufferSpscQueue queue(8);
+    queue.TryPush(HBuffer("a"));
+    queue.TryPush(HBuffer("b"));
+    TEST_CHECK(queue.GetSize() == 2);
+}
+
+template<typename Queue>
+static size_t CountQueueAllocations(){
+    //Owned buffers made up front so only the moves through the queue are counted
+    std::vector<HBuffer> owned;
+    for(int i = 0; i < 64; i++)owned.push_back(HBuffer::ToString(1000000000000ll + i));
+    Queue queue(16);
+    HBuffer out;
+    return CountAllocations([&]{
+        for(size_t i = 0; i < owned.size(); i++){
+            queue.TryPush(std::move(owned[i]));
+            queue.TryPush(HBuffer("a view"));
+            queue.TryPop(out);
+            queue.TryPop(out);
+        }
+    });
+}
+
+static void TestQueuesDoNotAllocate(){
+    TEST_CHECK(CountQueueAllocations<HBufferSpscQueue>() == 0);
+    TEST_CHECK(CountQueueAllocations<HBufferMpscQueue>() == 0);
+}
+
+/// @brief pushes param count numbers starting at param first, waiting whenever the queue is full
+template<typename Queue>
+static void PushNumbers(Queue& queue, uint64_t first, uint64_t count){
+    for(uint64_t i = first; i < first + count; i++){
+        HBuffer buffer = HBuffer::ToString(i);
+        while(!queue.TryPush(std::move(buffer)))std::this_thread::yield();
+    }
+}
+
+static uint64_t PopNumber(HBuffer& buffer){
+    uint64_t number = UINT64_MAX;
+    buffer.ToNumber(number);
+    return number;
+}
+
+static void TestSpscQueueThreads(){
+    //A small queue so both sides keep running into full and empty. Run under -fsanitize=thread to see races
+    const uint64_t count = 200000;
+    HBufferSpscQueue queue(64);
+    std::thread producer([&queue, count]{PushNumbers(queue, 0, count);});
+    bool inOrder = true;
+    HBuffer buffer;
+    for(uint64_t expected = 0; expected < count;){
+        if(!queue.TryPop(buffer)){
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder &= PopNumber(buffer) == expected++;
+    }
+    producer.join();
+    TEST_CHECK(inOrder);
+    TEST_CHECK(queue.GetSize() == 0 && !queue.TryPop(buffer));
+}
+
+static void TestMpscQueueThreads(){
+    //Each producer's numbers arrive in its own order and nothing is lost or popped twice
+    const uint64_t perProducer = 50000;
+    const size_t producers = 4;
+    HBufferMpscQueue queue(64);
+    std::vector<std::thread> threads;
+    for(size_t p = 0; p < producers; p++)threads.emplace_back([&queue, p, perProducer]{PushNumbers(queue, p * perProducer, perProducer);});
+    std::vector<uint64_t> next(producers);
+    for(size_t p = 0; p < producers; p++)next[p] = p * perProducer;
+    bool inOrder = true;
+    uint64_t sum = 0;
+    HBuffer buffer;
+    for(uint64_t popped = 0; popped < perProducer * producers;){
+        if(!queue.TryPop(buffer)){
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t number = PopNumber(buffer);
+        size_t p = std::min<size_t>(number / perProducer, producers - 1);
+        inOrder &= number == next[p]++;
+        sum += number;
+        popped++;
+    }
+    for(std::thread& thread : threads)thread.join();
+    uint64_t total = perProducer * producers;
+    TEST_CHECK(inOrder);
+    TEST_CHECK(sum == total * (total - 1) / 2);
+    TEST_CHECK(!queue.TryPop(buffer));
+}
+#pragma endregion
+
+#pragma region Splitter
+/// @brief collects every part param splitter hands out through Next
+static std::vector<std::string> Parts(HBufferSplitter splitter){
+    std::vector<std::string> parts;
+    HBuffer part;
+    while(splitter.Next(part))parts.emplace_back(part.GetData(), part.GetSize());
+    return parts;
+}
+
+static void TestSplitterParts(){
+    using Strings = std::vector<std::string>;
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a,b,,c"), ',')) == Strings({"a", "b", "", "c"}));
+    //A delimiter at the very end does not produce an empty last part, but one at the start does produce an empty first part
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer(",a,b,"), ',')) == Strings({"", "a", "b"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer(","), ',')) == Strings({""}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer(""), ',')).empty());
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("abc"), ',')) == Strings({"abc"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer(",,a,,b,,"), ',', -1, true)) == Strings({"a", "b"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a,b,c,d"), ',', 2)) == Strings({"a", "b", "c,d"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a,b"), ',', 0)) == Strings({"a,b"}));
+    //Skipped empty parts do not use up max
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer(",,a,,b,c"), ',', 1, true)) == Strings({"a", ",b,c"}));
+}
+
+static void TestSplitterMultiByte(){
+    using Strings = std::vector<std::string>;
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("one\r\ntwo\r\n\r\nthree\r\n"), "\r\n")) == Strings({"one", "two", "", "three"}));
+    //Half a delimiter is part of the text
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a\rb\nc\r\nd\r"), "\r\n")) == Strings({"a\rb\nc", "d\r"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("--|x--|--|y"), "--|", 3, -1, true)) == Strings({"x", "y"}));
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a--b--c"), "--", 2, 1)) == Strings({"a", "b--c"}));
+    //A one byte delimiter through the string constructor behaves like the char one
+    TEST_CHECK(Parts(HBufferSplitter(HBuffer("a,b,"), ",")) == Strings({"a", "b"}));
+}
+
+static void TestSplitterDoesNotAllocate(){
+    std::string text;
+    for(int i = 0; i < 100; i++)text += "field" + std::to_string(i) + "\r\n";
+    HBuffer buffer(text);
+    size_t count = 0;
+    size_t bytes = 0;
+    bool inside = true;
+    size_t allocations = CountAllocations([&]{
+        for(HBuffer& line : HBufferSplitter(buffer, "\r\n")){
+            count++;
+            bytes += line.GetSize();
+            inside &= line.GetData() >= buffer.GetData() && line.GetData() + line.GetSize() <= buffer.GetData() + buffer.GetSize();
+        }
+    });
+    TEST_CHECK(allocations == 0);
+    TEST_CHECK(count == 100);
+    TEST_CHECK(bytes == text.size() - 200);
+    TEST_CHECK(inside);
+}
+
+static void TestSplitterNext(){
+    HBuffer buffer("key=value=more");
+    HBufferSplitter splitter(buffer, '=', 1);
+    HBuffer part;
+    TEST_CHECK(splitter.Next(part) && Holds(part, "key"));
+    TEST_CHECK(splitter.GetPosition() == 4);
+    TEST_CHECK(splitter.Next(part) && Holds(part, "value=more"));
+    TEST_CHECK(splitter.GetPosition() == buffer.GetSize());
+    //Once done the part is left alone and the splitter stays done
+    TEST_CHECK(!splitter.Next(part) && Holds(part, "value=more"));
+    TEST_CHECK(!splitter.Next(part));
+    //The range for loop gives the same parts as Next
+    std::vector<std::string> iterated;
+    for(HBuffer& line : HBufferSplitter(HBuffer("x y  z"), ' '))iterated.emplace_back(line.GetData(), line.GetSize());
+    TEST_CHECK(iterated == Parts(HBufferSplitter(HBuffer("x y  z"), ' ')));
+}
+#pragma endregion
+
+#pragma region Tokenizer
+/// @brief appends param text to param tokenizer as an owned chunk
+static void AppendChunk(HBufferTokenizer& tokenizer, const std::string& text){
+    HBuffer chunk;
+    chunk.Append(text.data(), text.size());
+    tokenizer.Append(std::move(chunk));
+}
+
+/// @brief returns if param token points into param chunk instead of at a copy
+static bool PointsInto(const HBuffer& token, const HBuffer& chunk){
+    return token.GetData() >= chunk.GetData() && token.GetData() + token.GetSize() <= chunk.GetData() + chunk.GetSize();
+}
+
+static void TestTokenizerViews(){
+    HBuffer chunk = HBuffer::CreateShared("GET /a\nHost: x\n\nbody", 20);
+    HBufferTokenizer tokenizer('\n');
+    tokenizer.Append(chunk);
+    HBuffer token;
+    TEST_CHECK(tokenizer.Next(token) && Holds(token, "GET /a") && PointsInto(token, chunk));
+    TEST_CHECK(tokenizer.Next(token) && Holds(token, "Host: x") && PointsInto(token, chunk));
+    TEST_CHECK(tokenizer.Next(token) && token.GetSize() == 0);
+    TEST_CHECK(!tokenizer.Next(token));
+    TEST_CHECK(tokenizer.GetBufferedSize() == 4);
+    TEST_CHECK(tokenizer.TakeRest(token) && Holds(token, "body") && PointsInto(token, chunk));
+    TEST_CHECK(!tokenizer.TakeRest(token));
+    TEST_CHECK(tokenizer.GetCopiedBytes() == 0);
+    //Tokens are read only views, writing to one copies it
+    TEST_CHECK(!token.CanModify());
+}
+
+static void TestTokenizerStraddling(){
+    //A delimiter split across chunks still ends the token and copies nothing
+    HBuffer first("line1\r", 6, false, false);
+    HBuffer second("\nline2\r\nli", 10, false, false);
+    HBuffer third("ne3\r\n", 5, false, false);
+    HBufferTokenizer tokenizer("\r\n");
+    HBuffer token;
+    tokenizer.Append(first);
+    TEST_CHECK(!tokenizer.Next(token));
+    tokenizer.Append(second);
+    TEST_CHECK(tokenizer.Next(token) && Holds(token, "line1") && PointsInto(token, first));
+    TEST_CHECK(tokenizer.Next(token) && Holds(token, "line2") && PointsInto(token, second));
+    TEST_CHECK(!tokenizer.Next(token));
+    TEST_CHECK(tokenizer.GetCopiedBytes() == 0);
+    //Only the token that straddles two chunks is copied
+    tokenizer.Append(third);
+    TEST_CHECK(tokenizer.Next(token) && Holds(token, "line3"));
+    TEST_CHECK(!PointsInto(token, second) && !PointsInto(token, third));
+    TEST_CHECK(tokenizer.GetCopiedBytes() == 5);
+    TEST_CHECK(!tokenizer.Next(token) && tokenizer.GetBufferedSize() == 0);
+}
+
+static void TestTokenizerNextBytes(){
+    //A length prefixed record arriving one byte at a time
+    HBufferTokenizer tokenizer('\n');
+    HBuffer token;
+    std::string stream = "5:hello3:abc";
+    size_t fed = 0;
+    std::vector<std::string> records;
+    while(records.size() < 2){
+        TEST_CHECK(fed < stream.size());
+        if(fed >= stream.size())break;
+        AppendChunk(tokenizer, stream.substr(fed++, 1));
+        if(tokenizer.GetBufferedSize() < 2)continue;
+        HBuffer header;
+        TEST_CHECK(tokenizer.NextBytes(0, header) && header.GetSize() == 0);
+        size_t len = static_cast<size_t>(tokenizer.GetJoin().Get(tokenizer.GetJoin().GetSize() - tokenizer.GetBufferedSize()) - '0');
+        if(!tokenizer.NextBytes(len + 2, token))continue;
+        records.emplace_back(token.GetData() + 2, token.GetSize() - 2);
+    }
+    TEST_CHECK(records.size() == 2 && records[0] == "hello" && records[1] == "abc");
+    TEST_CHECK(tokenizer.GetBufferedSize() == 0);
+    TEST_CHECK(!tokenizer.NextBytes(1, token));
+}
+
+static void TestTokenizerScansOnce(){
+    //Bytes searched once are never searched again. A delimiter written into them afterwards is not seen
+    HBuffer first;
+    first.Append("no delimiter here", 17);
+    HBufferTokenizer tokenizer('\n');
+    HBuffer token;
+    tokenizer.Append(first);
+    TEST_CHECK(!tokenizer.Next(token));
+    first.GetData()[2] = '\n';
+    tokenizer.Append(HBuffer(" but now\n", 9, false, false));
+    TEST_CHECK(tokenizer.Next(token) && token.GetSize() == 25);
+    //Same for the part of a multi byte delimiter search that can not be the start of one
+    HBuffer multi;
+    multi.Append("abc\r", 4);
+    HBufferTokenizer lines("\r\n");
+    lines.Append(multi);
+    TEST_CHECK(!lines.Next(token));
+    multi.GetData()[0] = '\r';
+    multi.GetData()[1] = '\n';
+    lines.Append(HBuffer("\n", 1, false, false));
+    TEST_CHECK(lines.Next(token) && token.GetSize() == 3);
+}
+
+static void TestTokenizerMatchesSplit(){
+    //Random text cut into random chunks gives the same tokens as splitting it in one piece
+    uint32_t seed = 12345;
+    auto random = [&seed](uint32_t range){
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % range;
+    };
+    for(const char* delim : {"\n", "\r\n", "--|"}){
+        size_t delimLen = strlen(delim);
+        for(int round = 0; round < 50; round++){
+            std::string text;
+            while(text.size() < 2000){
+                if(random(6) == 0)text += delim;
+                else text += static_cast<char>("ab\r\n-|"[random(7)]);
+            }
+            std::vector<std::string> expected;
+            size_t at = 0;
+            for(size_t found; (found = text.find(delim, at)) != std::string::npos; at = found + delimLen)expected.push_back(text.substr(at, found - at));
+            std::string rest = text.substr(at);
+
+            std::vector<std::string> tokens;
+            HBufferTokenizer tokenizer(delim);
+            HBuffer token;
+            for(size_t fed = 0; fed < text.size();){
+                size_t len = std::min<size_t>(1 + random(64), text.size() - fed);
+                AppendChunk(tokenizer, text.substr(fed, len));
+                fed += len;
+                while(tokenizer.Next(token))tokens.emplace_back(token.GetData(), token.GetSize());
+            }
+            TEST_CHECK(tokens == expected);
+            if(tokenizer.TakeRest(token))TEST_CHECK(std::string(token.GetData(), token.GetSize()) == rest);
+            else TEST_CHECK(rest.empty());
+            //Straddling tokens and merges copy, but never more than a few times what came in
+            TEST_CHECK(tokenizer.GetCopiedBytes() <= text.size() * 2);
+        }
+    }
+}
+#pragma endregion
+
+int main(int argc, char** argv){
+    if(argc > 1)s_Filter = argv[1];
+    printf("small buffer size %d, allocation stats %s, tracing %s\n", HBUFF_SMALL_BUFFER_SIZE, HBufferStats::s_Enabled ? "on" : "off", HBufferTrace::s_Enabled ? "on" : "off");
+    //Set up the main thread's counters and trace ring now so the first counted allocation does not set them up
+    HBufferStats::RegisterThread();
+    HBufferTrace::RegisterThread();
+#if HBUFF_SMALL_BUFFER_SIZE > 0
+    Run("sbo_no_heap", TestSmallStringsStayInline);
+#endif
+    Run("cow_shared_reads", TestSharedReadsDoNotCopy);
+    Run("cow_indexing", TestIndexingDoesNotCopy);
+    Run("cow_detach_one_alias", TestMutationDetachesOneAlias);
+    Run("cow_last_reference", TestLastReferenceWritesInPlace);
+    Run("hash_case_folding", TestHashCaseFolding);
+    Run("hash_split_sources", TestHashFromSplitSources);
+    Run("hash_sequential_keys", TestHashSequentialKeysDoNotCollide);
+    Run("search_kernels", TestSearchKernels);
+    Run("search_joins", TestJoinSearch);
+    Run("stats_counters", TestAllocationStats);
+    Run("trace_round_trip", TestTraceRoundTrip);
+    Run("trace_full_ring", TestTraceDropsWhenFull);
+    Run("case_c_string", TestCaseConversionKeepsCString);
+    Run("numbers_integers", TestIntegerConversion);
+    Run("numbers_bad_bytes", TestIntegerParsingRejectsEveryBadByte);
+    Run("numbers_floats", TestFloatConversion);
+    Run("binary_byte_order", TestBinaryByteOrder);
+    Run("binary_varints", TestBinaryVarInts);
+    Run("binary_writer_reader", TestBinaryWriterReader);
+    Run("binary_append_extract", TestBinaryAppendExtract);
+    Run("map_read_only_copies", TestReadOnlyMappingCopiesOnWrite);
+    Run("allocator_shared_blocks", TestSharedBlocksNeedThreadSafeAllocators);
+    Run("allocator_recycling_hit_rate", TestRecyclingHitRate);
+    Run("allocator_recycling_trim", TestRecyclingTrim);
+    Run("allocator_recycling_threads", TestRecyclingAcrossThreads);
+    Run("allocator_recycling_exiting_thread", TestRecyclingExitingThread);
+    Run("vectorjoin_lookups", TestVectorJoinLookups);
+    Run("joins_const_threads", TestConstJoinsReadFromThreads);
+    Run("rope_build", TestRopeBuild);
+    Run("rope_split_copy", TestRopeSplitAndCopy);
+    Run("rope_search", TestRopeSearch);
+    Run("rope_compare_hash", TestRopeCompareAndHash);
+    Run("rope_stale_cursor", TestRopeStaleCursor);
+    Run("io_join", TestJoinIO);
+    Run("io_vectorjoin", TestVectorJoinIO);
+    Run("io_rope", TestRopeIO);
+    Run("io_partial_write", TestNonBlockingPartialWrite);
+    Run("ring_full_empty", TestRingFullAndEmpty);
+    Run("ring_wrap_around", TestRingWrapAround);
+    Run("ring_double_mapped", TestRingDoubleMapped);
+    Run("ring_fds", TestRingFds);
+    Run("queue_full_empty", TestQueuesFullAndEmpty);
+    Run("queue_no_allocations", TestQueuesDoNotAllocate);
+    Run("queue_spsc_threads", TestSpscQueueThreads);
+    Run("queue_mpsc_threads", TestMpscQueueThreads);
+    Run("splitter_parts", TestSplitterParts);
+    Run("splitter_multi_byte", TestSplitterMultiByte);
+    Run("splitter_no_allocations", TestSplitterDoesNotAllocate);
+    Run("splitter_next", TestSplitterNext);
+    Run("tokenizer_views", TestTokenizerViews);
+    Run("tokenizer_straddling", TestTokenizerStraddling);
+    Run("tokenizer_next_bytes", TestTokenizerNextBytes);
+    Run("tokenizer_scans_once", TestTokenizerScansOnce);
+    Run("tokenizer_matches_split", TestTokenizerMatchesSplit);
+    printf("%d checks, %d failed\n", s_Checks, s_Failures);
+    return s_Failures > 0 ? 1 : 0;
+}